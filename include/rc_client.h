@@ -748,6 +748,49 @@ RC_EXPORT void RC_CCONV rc_client_set_event_handler(rc_client_t* client, rc_clie
  */
 RC_EXPORT void RC_CCONV rc_client_set_read_memory_function(rc_client_t* client, rc_client_read_memory_func_t handler);
 
+/**
+ * Provides an optional callback for reading contiguous blocks of memory.
+ * Unlike the read_memory callback, num_bytes may be larger than 4. When provided, the
+ * memory referenced by the active achievements is grouped into spans of nearby addresses
+ * and each span is read with a single call per frame. Nearby addresses calculated from the
+ * same pointer are also read as a single span. If a span cannot be fully read, the addresses
+ * in the span are read individually using the read_memory callback.
+ */
+RC_EXPORT void RC_CCONV rc_client_set_read_memory_block_function(rc_client_t* client, rc_client_read_memory_func_t handler);
+
+enum {
+  RC_CLIENT_MEMORY_BYTE_ORDER_LINEAR = 0, /* console address N is at host_data[N - address] */
+  RC_CLIENT_MEMORY_BYTE_ORDER_SWAP32 = 1  /* console address N is at host_data[(N - address) ^ 3] (32-bit words in little-endian host order) */
+};
+
+/**
+ * Registers a block of host memory that backs num_bytes of console memory starting at address.
+ * Memory referenced by the active achievements and leaderboards that lies entirely within a
+ * registered region is read directly from host_data each frame instead of calling the
+ * read_memory callback. Nearby addresses calculated from the same pointer are also read from
+ * host_data when they lie entirely within a registered region. Other addresses are still read
+ * through the read_memory callback. host_data must remain
+ * valid until rc_client_clear_memory_regions is called or the client is destroyed.
+ * Returns RC_INSUFFICIENT_BUFFER if the maximum number of regions are already registered.
+ */
+RC_EXPORT int RC_CCONV rc_client_add_memory_region(rc_client_t* client, uint32_t address, uint8_t* host_data, uint32_t num_bytes, int byte_order);
+
+/**
+ * Unregisters all memory regions registered by rc_client_add_memory_region.
+ */
+RC_EXPORT void RC_CCONV rc_client_clear_memory_regions(rc_client_t* client);
+
+/**
+ * Provides a bitmap of the memory pages written since the previous call to rc_client_do_frame.
+ * Bit (n % 8) of dirty_pages[n / 8] is set if page n was written. page_size must be a power of two.
+ * Memory referenced by the active achievements and leaderboards that only covers pages that weren't
+ * written is not read by the next call to rc_client_do_frame, and is reported as unchanged. Pages
+ * beyond num_pages are assumed to have been written. Addresses calculated from pointer chains are
+ * always read. The bitmap is only used by the next call to rc_client_do_frame, and must remain
+ * valid until then.
+ */
+RC_EXPORT void RC_CCONV rc_client_set_dirty_pages(rc_client_t* client, const uint8_t* dirty_pages, uint32_t num_pages, uint32_t page_size);
+
 /**
  * Specifies whether rc_client is allowed to read memory outside of rc_client_do_frame/rc_client_idle.
  */
@@ -77,6 +77,7 @@ typedef struct rc_runtime_t {
   rc_runtime_richpresence_t* richpresence;
 
   struct rc_memrefs_t* memrefs;
+  struct rc_runtime_state_t* state;
 
   uint8_t owns_self;
 }
@@ -127,12 +128,78 @@ rc_runtime_event_t;
 typedef void (RC_CCONV *rc_runtime_event_handler_t)(const rc_runtime_event_t* runtime_event);
 
 RC_EXPORT void RC_CCONV rc_runtime_do_frame(rc_runtime_t* runtime, rc_runtime_event_handler_t event_handler, rc_runtime_peek_t peek, void* ud, void* unused_L);
+
+typedef struct rc_runtime_event_buffer_t {
+  rc_runtime_event_t* events;
+  uint32_t num_events;                /* number of events in events */
+  uint32_t capacity;                  /* number of events that fit in events */
+  uint32_t num_dropped;               /* number of events that didn't fit in events */
+  uint8_t owns_events;                /* non-zero if events is allocated by the runtime, and can be grown */
+}
+rc_runtime_event_buffer_t;
+
+/* initializes an event buffer. if events is NULL, space for the events is allocated as needed, and
+ * must be released with rc_runtime_destroy_event_buffer. otherwise, events has space for capacity
+ * events, and events that don't fit are counted in num_dropped. */
+RC_EXPORT void RC_CCONV rc_runtime_init_event_buffer(rc_runtime_event_buffer_t* buffer, rc_runtime_event_t* events, uint32_t capacity);
+RC_EXPORT void RC_CCONV rc_runtime_destroy_event_buffer(rc_runtime_event_buffer_t* buffer);
+
+/* processes a frame like rc_runtime_do_frame, but appends the events to buffer instead of raising
+ * them, so they can be processed after the frame, or on another thread. events already in the buffer
+ * are kept, set num_events and num_dropped to 0 once they've been processed. returns the number of
+ * events appended. */
+RC_EXPORT uint32_t RC_CCONV rc_runtime_do_frame_buffered(rc_runtime_t* runtime, rc_runtime_event_buffer_t* buffer, rc_runtime_peek_t peek, void* ud);
+
 RC_EXPORT void RC_CCONV rc_runtime_reset(rc_runtime_t* runtime);
 
 typedef int (RC_CCONV *rc_runtime_validate_address_t)(uint32_t address);
 RC_EXPORT void RC_CCONV rc_runtime_validate_addresses(rc_runtime_t* runtime, rc_runtime_event_handler_t event_handler, rc_runtime_validate_address_t validate_handler);
 RC_EXPORT void RC_CCONV rc_runtime_invalidate_address(rc_runtime_t* runtime, uint32_t address);
 
+/* allows memrefs whose bytes overlap or abut to be read with a single call to the peek callback.
+ * nearby addresses calculated from the same pointer are also read together. the callback may then
+ * be asked for a range that starts at a different address than the individual memrefs, so it should
+ * not be enabled if the callback calls rc_runtime_invalidate_address. */
+RC_EXPORT void RC_CCONV rc_runtime_set_fused_reads_enabled(rc_runtime_t* runtime, int enabled);
+
+/* provides a bitmap of the memory pages written since the previous call to rc_runtime_do_frame.
+ * bit (n % 8) of dirty_pages[n / 8] is set if page n was written. addresses are the same as those
+ * passed to the peek callback, and page_size must be a power of two. memrefs that only cover pages
+ * that weren't written are not read by the next call to rc_runtime_do_frame, and are reported as
+ * unchanged. pages beyond num_pages are assumed to have been written. the bitmap is only used by
+ * the next call to rc_runtime_do_frame, and must remain valid until then. */
+RC_EXPORT void RC_CCONV rc_runtime_set_dirty_pages(rc_runtime_t* runtime, const uint8_t* dirty_pages, uint32_t num_pages, uint32_t page_size);
+
+/* compiles achievement triggers to native code the first time they're evaluated. only integer
+ * comparisons of memrefs are compiled, anything else is still processed by the interpreter.
+ * returns non-zero if native code can be generated on the current platform (x86-64 Linux). */
+RC_EXPORT int RC_CCONV rc_runtime_set_jit_enabled(rc_runtime_t* runtime, int enabled);
+
+/**
+ * Callback used to process a single work item for rc_runtime_parallel_for_t.
+ */
+typedef void (RC_CCONV *rc_runtime_process_item_t)(uint32_t item, void* item_data);
+
+/**
+ * Callback used to evaluate achievements and leaderboards on other threads. Must call
+ * process_item(item, item_data) exactly once for each item from 0 to num_items - 1, and must not
+ * return until all of them have completed. The items are independent of each other, so they can
+ * be processed in any order, and on any number of threads.
+ */
+typedef void (RC_CCONV *rc_runtime_parallel_for_t)(uint32_t num_items, rc_runtime_process_item_t process_item, void* item_data, void* userdata);
+
+/* evaluates achievements and leaderboards by dividing them into work items that are passed to
+ * parallel_for. memory is still read, and events are still raised, on the thread calling
+ * rc_runtime_do_frame. events are deferred until everything has been evaluated, and are then raised
+ * in the same order as when evaluating serially.
+ * this is NOT equivalent to evaluating serially if the event handler changes the runtime. everything
+ * is evaluated against the state from before any of the frame's events were raised, so a reset,
+ * deserialized progress, or newly activated definition isn't evaluated until the next frame, and a
+ * reset of an entry that hasn't raised its events yet discards the hits it got in this frame. entries
+ * the handler deactivates or replaces don't raise their deferred events.
+ * pass NULL to evaluate serially. returns RC_OUT_OF_MEMORY if the mode could not be enabled. */
+RC_EXPORT int RC_CCONV rc_runtime_set_deferred_parallel_for(rc_runtime_t* runtime, rc_runtime_parallel_for_t parallel_for, void* userdata);
+
 RC_EXPORT uint32_t RC_CCONV rc_runtime_progress_size(const rc_runtime_t* runtime, void* unused_L);
 
 /* [deprecated] use rc_runtime_serialize_progress_sized instead */
@@ -1148,10 +1148,34 @@ void rc_client_destroy_all_user_progress(rc_client_all_user_progress_t* list)
 
 /* ===== Game ===== */
 
+static void rc_client_release_achievement_steady_state(rc_client_game_info_t* game, int keep_active)
+{
+  rc_client_achievement_info_t* achievement;
+  rc_client_achievement_info_t* stop;
+  rc_client_subset_info_t* subset;
+
+  for (subset = game->subsets; subset; subset = subset->next) {
+    achievement = subset->achievements;
+    stop = achievement + subset->public_.num_achievements;
+
+    for (; achievement < stop; ++achievement) {
+      if (keep_active && subset->active && achievement->public_.state == RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE)
+        continue;
+
+      rc_trigger_steady_destroy(achievement->steady);
+      achievement->steady = NULL;
+    }
+  }
+}
+
 static void rc_client_free_game(rc_client_game_info_t* game)
 {
+  rc_client_release_achievement_steady_state(game, 0);
   rc_runtime_destroy(&game->runtime);
 
+  free(game->read_plan.memrefs);
+  free(game->read_plan.buffer);
+
   rc_buffer_destroy(&game->buffer);
 
   free(game);
@@ -1345,6 +1369,11 @@ static void rc_client_validate_addresses(rc_client_game_info_t* game, rc_client_
 
 static void rc_client_update_legacy_runtime_achievements(rc_client_game_info_t* game, uint32_t active_count)
 {
+  rc_memrefs_invalidate_schedule(game->runtime.memrefs);
+  rc_runtime_invalidate_ids(&game->runtime);
+  rc_runtime_release_trigger_state(&game->runtime);
+  rc_client_release_achievement_steady_state(game, 1);
+
   if (active_count > 0) {
     rc_client_achievement_info_t* achievement;
     rc_client_achievement_info_t* stop;
@@ -1414,6 +1443,7 @@ void rc_client_update_active_achievements(rc_client_game_info_t* game)
   }
 
   rc_client_update_legacy_runtime_achievements(game, active_count);
+  game->read_plan.dirty = 1;
 }
 
 static uint32_t rc_client_subset_toggle_hardcore_achievements(rc_client_subset_info_t* subset, rc_client_t* client, uint8_t active_bit)
@@ -1494,6 +1524,9 @@ static void rc_client_activate_achievements(rc_client_game_info_t* game, rc_clie
 
 static void rc_client_update_legacy_runtime_leaderboards(rc_client_game_info_t* game, uint32_t active_count)
 {
+  rc_memrefs_invalidate_schedule(game->runtime.memrefs);
+  rc_runtime_invalidate_ids(&game->runtime);
+
   if (active_count > 0) {
     rc_client_leaderboard_info_t* leaderboard;
     rc_client_leaderboard_info_t* stop;
@@ -1567,6 +1600,7 @@ void rc_client_update_active_leaderboards(rc_client_game_info_t* game)
   }
 
   rc_client_update_legacy_runtime_leaderboards(game, active_count);
+  game->read_plan.dirty = 1;
 }
 
 static void rc_client_activate_leaderboards(rc_client_game_info_t* game, rc_client_t* client)
@@ -1641,6 +1675,7 @@ static void rc_client_deactivate_leaderboards(rc_client_game_info_t* game, rc_cl
   }
 
   game->runtime.lboard_count = 0;
+  rc_runtime_invalidate_ids(&game->runtime);
 }
 
 static void rc_client_apply_unlocks(rc_client_subset_info_t* subset, rc_api_unlock_entry_t* unlocks, uint32_t num_unlocks, uint8_t mode)
@@ -2015,6 +2050,7 @@ static void rc_client_copy_achievements(rc_client_load_state_t* load_state,
       RC_CLIENT_LOG_WARN_FORMATTED(load_state->client, "Parse error %d processing achievement %u", trigger_size, read->id);
       achievement->public_.state = RC_CLIENT_ACHIEVEMENT_STATE_DISABLED;
       achievement->public_.bucket = RC_CLIENT_ACHIEVEMENT_BUCKET_UNSUPPORTED;
+      rc_destroy_preparse_state(&preparse);
     }
     else {
       /* populate the item, using the communal memrefs pool */
@@ -2160,6 +2196,7 @@ static void rc_client_copy_leaderboards(rc_client_load_state_t* load_state,
     if (lboard_size < 0) {
       RC_CLIENT_LOG_WARN_FORMATTED(load_state->client, "Parse error %d processing leaderboard %u", lboard_size, read->id);
       leaderboard->public_.state = RC_CLIENT_LEADERBOARD_STATE_DISABLED;
+      rc_destroy_preparse_state(&preparse);
     }
     else {
       /* populate the item, using the communal memrefs pool */
@@ -4254,6 +4291,10 @@ static void rc_client_award_achievement(rc_client_t* client, rc_client_achieveme
   achievement->public_.unlocked |= (client->state.hardcore) ?
     RC_CLIENT_ACHIEVEMENT_UNLOCKED_BOTH : RC_CLIENT_ACHIEVEMENT_UNLOCKED_SOFTCORE;
 
+  /* memrefs only used by this achievement no longer need to be read */
+  if (client->game)
+    rc_memrefs_invalidate_schedule(client->game->runtime.memrefs);
+
   rc_mutex_unlock(&client->state.mutex);
 
   if (client->callbacks.can_submit_achievement_unlock &&
@@ -5266,6 +5307,61 @@ void rc_client_set_read_memory_function(rc_client_t* client, rc_client_read_memo
   client->callbacks.read_memory = handler;
 }
 
+void rc_client_set_read_memory_block_function(rc_client_t* client, rc_client_read_memory_func_t handler)
+{
+  if (!client)
+    return;
+
+  client->callbacks.read_memory_block = handler;
+}
+
+int rc_client_add_memory_region(rc_client_t* client, uint32_t address, uint8_t* host_data, uint32_t num_bytes, int byte_order)
+{
+  rc_client_memory_region_t* region;
+
+  if (!client || !host_data || !num_bytes)
+    return RC_INVALID_STATE;
+
+  if (byte_order != RC_CLIENT_MEMORY_BYTE_ORDER_LINEAR && byte_order != RC_CLIENT_MEMORY_BYTE_ORDER_SWAP32)
+    return RC_INVALID_STATE;
+
+  if (client->state.num_memory_regions == RC_CLIENT_MAX_MEMORY_REGIONS)
+    return RC_INSUFFICIENT_BUFFER;
+
+  region = &client->state.memory_regions[client->state.num_memory_regions++];
+  region->host_data = host_data;
+  region->address = address;
+  region->num_bytes = num_bytes;
+  region->byte_order = (uint8_t)byte_order;
+
+  /* memrefs are resolved to regions when the read plan is built */
+  if (client->game)
+    client->game->read_plan.dirty = 1;
+
+  return RC_OK;
+}
+
+void rc_client_clear_memory_regions(rc_client_t* client)
+{
+  if (!client)
+    return;
+
+  client->state.num_memory_regions = 0;
+
+  if (client->game)
+    client->game->read_plan.dirty = 1;
+}
+
+void rc_client_set_dirty_pages(rc_client_t* client, const uint8_t* dirty_pages, uint32_t num_pages, uint32_t page_size)
+{
+  if (!client)
+    return;
+
+  client->state.dirty_pages = dirty_pages;
+  client->state.num_dirty_pages = num_pages;
+  client->state.dirty_page_size = page_size;
+}
+
 void rc_client_set_allow_background_memory_reads(rc_client_t* client, int allowed)
 {
   if (!client)
@@ -5393,52 +5489,452 @@ int rc_client_is_processing_required(rc_client_t* client)
   return (client->game->runtime.richpresence && client->game->runtime.richpresence->richpresence);
 }
 
-static void rc_client_update_memref_values(rc_client_t* client) {
-  rc_memrefs_t* memrefs = client->game->runtime.memrefs;
+/* addresses closer than this are read as part of the same span */
+#define RC_CLIENT_READ_PLAN_MAX_GAP 16
+
+static int rc_client_compare_memref_addresses(const void* a, const void* b)
+{
+  const rc_memref_t* memref_a = *(const rc_memref_t**)a;
+  const rc_memref_t* memref_b = *(const rc_memref_t**)b;
+  if (memref_a->address == memref_b->address)
+    return 0;
+  return (memref_a->address < memref_b->address) ? -1 : 1;
+}
+
+static uint32_t rc_client_memref_num_bytes(uint8_t size)
+{
+  switch (rc_memref_shared_size(size)) {
+    case RC_MEMSIZE_8_BITS: return 1;
+    case RC_MEMSIZE_16_BITS: return 2;
+    case RC_MEMSIZE_32_BITS: return 4;
+    default: return 0;
+  }
+}
+
+static const rc_client_memory_region_t* rc_client_find_memory_region(const rc_client_t* client, uint32_t address, uint32_t num_bytes)
+{
+  const rc_client_memory_region_t* region = client->state.memory_regions;
+  const rc_client_memory_region_t* region_stop = region + client->state.num_memory_regions;
+
+  for (; region < region_stop; ++region) {
+    if (num_bytes <= region->num_bytes && address >= region->address &&
+        address - region->address <= region->num_bytes - num_bytes)
+      return region;
+  }
+
+  return NULL;
+}
+
+static void rc_client_build_read_plan(rc_client_t* client, rc_client_game_info_t* game)
+{
+  const rc_client_memory_region_t* region;
+  rc_client_read_plan_t* plan = &game->read_plan;
+  rc_client_read_plan_span_t* span = NULL;
   rc_memref_list_t* memref_list;
-  rc_modified_memref_list_t* modified_memref_list;
+  rc_memref_t** memrefs;
+  rc_memref_t** scheduled_memref;
+  uint32_t num_scheduled_memrefs;
+  uint32_t num_memrefs = 0;
+  uint32_t num_spans = 0;
+  uint32_t buffer_size = 0;
+  uint32_t span_end = 0;
+  uint32_t num_bytes;
+  uint32_t i;
+
+  free(plan->memrefs);
+  free(plan->buffer);
+  memset(plan, 0, sizeof(*plan));
+  plan->num_source_memrefs = rc_memrefs_count_memrefs(game->runtime.memrefs);
+
+  memref_list = &game->runtime.memrefs->memrefs;
+  for (; memref_list; memref_list = memref_list->next)
+    num_memrefs += memref_list->count;
+
+  if (num_memrefs == 0)
+    return;
+
+  /* allocate for the worst case (one span per memref) */
+  plan->memrefs = (rc_memref_t**)malloc(num_memrefs * (sizeof(rc_memref_t*) + sizeof(rc_client_read_plan_span_t)));
+  if (!plan->memrefs) {
+    plan->num_source_memrefs = 0;
+    return;
+  }
+
+  plan->spans = (rc_client_read_plan_span_t*)&plan->memrefs[num_memrefs];
+
+  memrefs = plan->memrefs;
+  scheduled_memref = rc_memrefs_get_scheduled_memrefs(game->runtime.memrefs, &num_scheduled_memrefs);
+  if (scheduled_memref) {
+    /* memrefs that aren't referenced by anything active are not read */
+    rc_memref_t** scheduled_memref_stop = scheduled_memref + num_scheduled_memrefs;
+    for (; scheduled_memref < scheduled_memref_stop; ++scheduled_memref) {
+      if ((*scheduled_memref)->value.type != RC_VALUE_TYPE_NONE)
+        *memrefs++ = *scheduled_memref;
+    }
+  }
+  else {
+    memref_list = &game->runtime.memrefs->memrefs;
+    for (; memref_list; memref_list = memref_list->next) {
+      rc_memref_t* memref = memref_list->items;
+      const rc_memref_t* memref_stop = memref + memref_list->count;
+
+      for (; memref < memref_stop; ++memref) {
+        if (memref->value.type != RC_VALUE_TYPE_NONE)
+          *memrefs++ = memref;
+      }
+    }
+  }
+
+  plan->num_memrefs = (uint32_t)(memrefs - plan->memrefs);
+  qsort(plan->memrefs, plan->num_memrefs, sizeof(rc_memref_t*), rc_client_compare_memref_addresses);
+
+  for (i = 0; i < plan->num_memrefs; ++i) {
+    const rc_memref_t* memref = plan->memrefs[i];
+    num_bytes = rc_client_memref_num_bytes(memref->value.size);
+
+    region = num_bytes ? rc_client_find_memory_region(client, memref->address, num_bytes) : NULL;
+    if (region) {
+      /* read directly from the host memory. the span covers the whole region */
+      if (span && span->type != RC_CLIENT_READ_PLAN_SPAN_BLOCK &&
+          span->buffer == region->host_data && span->address == region->address) {
+        span->num_memrefs++;
+        continue;
+      }
+
+      span = &plan->spans[num_spans++];
+      span->buffer = region->host_data;
+      span->address = region->address;
+      span->num_bytes = region->num_bytes;
+      span->first_memref = i;
+      span->num_memrefs = 1;
+      span->type = (region->byte_order == RC_CLIENT_MEMORY_BYTE_ORDER_SWAP32) ?
+          RC_CLIENT_READ_PLAN_SPAN_HOST_SWAP32 : RC_CLIENT_READ_PLAN_SPAN_HOST;
+      continue;
+    }
+
+    if (num_bytes == 0 || memref->address > 0xFFFFFFFF - num_bytes || !client->callbacks.read_memory_block) {
+      /* memref can't be expressed as a span. read it individually */
+      span = &plan->spans[num_spans++];
+      span->buffer = NULL;
+      span->address = memref->address;
+      span->num_bytes = 0;
+      span->first_memref = i;
+      span->num_memrefs = 1;
+      span->type = RC_CLIENT_READ_PLAN_SPAN_BLOCK;
+      span = NULL;
+      continue;
+    }
+
+    if (span && span->type == RC_CLIENT_READ_PLAN_SPAN_BLOCK &&
+        memref->address - span->address <= span->num_bytes + RC_CLIENT_READ_PLAN_MAX_GAP) {
+      /* close enough to the current span to extend it */
+      if (memref->address + num_bytes > span_end) {
+        buffer_size += memref->address + num_bytes - span_end;
+        span_end = memref->address + num_bytes;
+        span->num_bytes = span_end - span->address;
+      }
+
+      span->num_memrefs++;
+      continue;
+    }
+
+    span = &plan->spans[num_spans++];
+    span->buffer = NULL;
+    span->address = memref->address;
+    span->num_bytes = num_bytes;
+    span->first_memref = i;
+    span->num_memrefs = 1;
+    span->type = RC_CLIENT_READ_PLAN_SPAN_BLOCK;
+    span_end = memref->address + num_bytes;
+    buffer_size += num_bytes;
+  }
+
+  plan->num_spans = num_spans;
+
+  if (buffer_size) {
+    plan->buffer = (uint8_t*)malloc(buffer_size);
+    if (!plan->buffer) {
+      /* read everything individually */
+      for (i = 0; i < num_spans; ++i) {
+        if (plan->spans[i].type == RC_CLIENT_READ_PLAN_SPAN_BLOCK)
+          plan->spans[i].num_bytes = 0;
+      }
+      return;
+    }
+  }
+
+  /* assign buffer space to each span */
+  buffer_size = 0;
+  for (i = 0; i < num_spans; ++i) {
+    span = &plan->spans[i];
+    if (span->num_bytes && span->type == RC_CLIENT_READ_PLAN_SPAN_BLOCK) {
+      span->buffer = plan->buffer + buffer_size;
+      buffer_size += span->num_bytes;
+    }
+  }
+}
+
+static uint32_t rc_client_peek_read_plan_span(uint32_t address, uint32_t num_bytes, void* ud)
+{
+  const rc_client_read_plan_span_t* span = (const rc_client_read_plan_span_t*)ud;
+  const uint8_t* ptr = span->buffer + (address - span->address);
+
+  switch (num_bytes) {
+    case 1:
+      return ptr[0];
+
+    case 2:
+      return ptr[0] | (ptr[1] << 8);
+
+    case 4:
+      return ptr[0] | (ptr[1] << 8) | (ptr[2] << 16) | ((uint32_t)ptr[3] << 24);
+
+    default:
+      return 0;
+  }
+}
+
+static uint32_t rc_client_peek_read_plan_span_swap32(uint32_t address, uint32_t num_bytes, void* ud)
+{
+  const rc_client_read_plan_span_t* span = (const rc_client_read_plan_span_t*)ud;
+  const uint8_t* ptr = span->buffer;
+  const uint32_t offset = address - span->address;
+
+  switch (num_bytes) {
+    case 1:
+      return ptr[offset ^ 3];
+
+    case 2:
+      return ptr[offset ^ 3] | (ptr[(offset + 1) ^ 3] << 8);
+
+    case 4:
+      return ptr[offset ^ 3] | (ptr[(offset + 1) ^ 3] << 8) |
+          (ptr[(offset + 2) ^ 3] << 16) | ((uint32_t)ptr[(offset + 3) ^ 3] << 24);
+
+    default:
+      return 0;
+  }
+}
+
+static int rc_client_update_memref_values_from_plan(rc_client_t* client)
+{
+  rc_client_read_plan_t* plan = &client->game->read_plan;
+  const rc_memrefs_t* memrefs = client->game->runtime.memrefs;
+  const rc_client_read_plan_span_t* span;
+  const rc_client_read_plan_span_t* span_stop;
   int invalidated_memref = 0;
 
-  memref_list = &memrefs->memrefs;
-  do {
-    rc_memref_t* memref = memref_list->items;
-    const rc_memref_t* memref_stop = memref + memref_list->count;
+  if (plan->dirty || plan->num_source_memrefs != rc_memrefs_count_memrefs(client->game->runtime.memrefs))
+    rc_client_build_read_plan(client, client->game);
+
+  span = plan->spans;
+  span_stop = span + plan->num_spans;
+  for (; span < span_stop; ++span) {
+    rc_memref_t** memref = &plan->memrefs[span->first_memref];
+    rc_memref_t** memref_stop = memref + span->num_memrefs;
     uint32_t value;
 
+    if (span->type == RC_CLIENT_READ_PLAN_SPAN_BLOCK && span->num_bytes &&
+        rc_memrefs_is_range_clean(memrefs, span->address, span->num_bytes)) {
+      /* nothing in the span was written. the memrefs keep their values */
+      for (; memref < memref_stop; ++memref) {
+        if ((*memref)->value.type != RC_VALUE_TYPE_NONE)
+          (*memref)->value.changed = 0;
+      }
+
+      continue;
+    }
+
+    if (span->type != RC_CLIENT_READ_PLAN_SPAN_BLOCK || (span->num_bytes &&
+        client->callbacks.read_memory_block(span->address, span->buffer, span->num_bytes, client) == span->num_bytes)) {
+      const rc_peek_t peek = (span->type == RC_CLIENT_READ_PLAN_SPAN_HOST_SWAP32) ?
+          rc_client_peek_read_plan_span_swap32 : rc_client_peek_read_plan_span;
+
+      for (; memref < memref_stop; ++memref) {
+        if ((*memref)->value.type == RC_VALUE_TYPE_NONE)
+          continue;
+
+        if (rc_memrefs_is_memref_clean(memrefs, *memref)) {
+          (*memref)->value.changed = 0;
+          continue;
+        }
+
+        value = rc_peek_value((*memref)->address, (*memref)->value.size, peek, (void*)span);
+        rc_update_memref_value(&(*memref)->value, value);
+      }
+
+      continue;
+    }
+
+    /* span could not be read as a whole. read each memref individually so the invalid ones can be identified */
     for (; memref < memref_stop; ++memref) {
-      if (memref->value.type == RC_VALUE_TYPE_NONE)
+      if ((*memref)->value.type == RC_VALUE_TYPE_NONE)
+        continue;
+
+      if (rc_memrefs_is_memref_clean(memrefs, *memref)) {
+        (*memref)->value.changed = 0;
         continue;
+      }
 
-      /* if processing_memref is set, and the memory read fails, all dependent achievements will be disabled */
-      client->state.processing_memref = memref;
+      client->state.processing_memref = *memref;
 
-      value = rc_peek_value(memref->address, memref->value.size, client->state.legacy_peek, client);
+      value = rc_peek_value((*memref)->address, (*memref)->value.size, client->state.legacy_peek, client);
 
-      if (client->state.processing_memref) {
-        rc_update_memref_value(&memref->value, value);
-      }
-      else {
-        /* if the peek function cleared the processing_memref, the memref was invalidated */
+      if (client->state.processing_memref)
+        rc_update_memref_value(&(*memref)->value, value);
+      else
         invalidated_memref = 1;
-      }
     }
-
-    memref_list = memref_list->next;
-  } while (memref_list);
+  }
 
   client->state.processing_memref = NULL;
+  return invalidated_memref;
+}
 
-  modified_memref_list = &memrefs->modified_memrefs;
-  if (modified_memref_list->count) {
+static uint32_t rc_client_read_indirect_block(uint32_t address, uint8_t* buffer, uint32_t num_bytes, void* ud)
+{
+  rc_client_t* client = (rc_client_t*)ud;
+  const rc_client_memory_region_t* region;
+  uint32_t i;
+
+  /* pointer chains frequently point outside of the valid memory when they're not in use */
+  if (address > client->game->max_valid_address)
+    return 0;
+
+  region = rc_client_find_memory_region(client, address, num_bytes);
+  if (region) {
+    const uint32_t offset = address - region->address;
+
+    if (region->byte_order == RC_CLIENT_MEMORY_BYTE_ORDER_SWAP32) {
+      for (i = 0; i < num_bytes; ++i)
+        buffer[i] = region->host_data[(offset + i) ^ 3];
+    }
+    else {
+      memcpy(buffer, region->host_data + offset, num_bytes);
+    }
+
+    return num_bytes;
+  }
+
+  if (client->callbacks.read_memory_block)
+    return client->callbacks.read_memory_block(address, buffer, num_bytes, client);
+
+  return 0;
+}
+
+static int rc_client_update_memref_value(rc_client_t* client, rc_memref_t* memref) {
+  uint32_t value;
+
+  if (memref->value.type == RC_VALUE_TYPE_NONE)
+    return 0;
+
+  if (rc_memrefs_is_memref_clean(client->game->runtime.memrefs, memref)) {
+    /* the page containing the memref wasn't written. the value is unchanged */
+    memref->value.changed = 0;
+    return 0;
+  }
+
+  /* if processing_memref is set, and the memory read fails, all dependent achievements will be disabled */
+  client->state.processing_memref = memref;
+
+  value = rc_peek_value(memref->address, memref->value.size, client->state.legacy_peek, client);
+
+  if (!client->state.processing_memref) {
+    /* if the peek function cleared the processing_memref, the memref was invalidated */
+    return 1;
+  }
+
+  rc_update_memref_value(&memref->value, value);
+  return 0;
+}
+
+static int rc_client_schedule_memrefs(rc_client_game_info_t* game)
+{
+  rc_memrefs_t* memrefs = game->runtime.memrefs;
+  rc_client_subset_info_t* subset;
+
+  if (!memrefs || !memrefs->schedule || !memrefs->schedule->dirty)
+    return 0;
+
+  if (!rc_memrefs_begin_schedule(memrefs))
+    return 0;
+
+  /* only memrefs referenced by active achievements, leaderboards, or rich presence need to be read
+   * each frame. leaderboards are kept unless disabled as they can be enabled by changing settings. */
+  for (subset = game->subsets; subset; subset = subset->next) {
+    rc_client_achievement_info_t* achievement = subset->achievements;
+    rc_client_achievement_info_t* achievement_stop = achievement + subset->public_.num_achievements;
+    rc_client_leaderboard_info_t* leaderboard = subset->leaderboards;
+    rc_client_leaderboard_info_t* leaderboard_stop = leaderboard + subset->public_.num_leaderboards;
+
+    if (!subset->active)
+      continue;
+
+    for (; achievement < achievement_stop; ++achievement) {
+      if (achievement->trigger && achievement->public_.state == RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE)
+        rc_memrefs_mark_trigger_reachable(memrefs, achievement->trigger);
+    }
+
+    for (; leaderboard < leaderboard_stop; ++leaderboard) {
+      if (leaderboard->lboard && leaderboard->public_.state != RC_CLIENT_LEADERBOARD_STATE_DISABLED)
+        rc_memrefs_mark_lboard_reachable(memrefs, leaderboard->lboard);
+    }
+  }
+
+  if (game->runtime.richpresence && game->runtime.richpresence->richpresence)
+    rc_memrefs_mark_richpresence_reachable(memrefs, game->runtime.richpresence->richpresence);
+
+  rc_memrefs_end_schedule(memrefs);
+  return 1;
+}
+
+static void rc_client_update_memref_values(rc_client_t* client) {
+  rc_memrefs_t* memrefs = client->game->runtime.memrefs;
+  rc_memref_list_t* memref_list;
+  rc_memref_t** scheduled_memref;
+  uint32_t num_scheduled_memrefs;
+  int invalidated_memref = 0;
+
+  if (rc_client_schedule_memrefs(client->game))
+    client->game->read_plan.dirty = 1;
+
+  rc_memrefs_set_dirty_pages(memrefs, client->state.dirty_pages, client->state.num_dirty_pages, client->state.dirty_page_size);
+  rc_memrefs_begin_update(memrefs);
+  rc_memrefs_prime_stale_memrefs(memrefs, client->state.legacy_peek, client);
+
+  if (client->callbacks.read_memory_block || client->state.num_memory_regions) {
+    invalidated_memref = rc_client_update_memref_values_from_plan(client);
+  }
+  else if ((scheduled_memref = rc_memrefs_get_scheduled_memrefs(memrefs, &num_scheduled_memrefs)) != NULL) {
+    rc_memref_t** scheduled_memref_stop = scheduled_memref + num_scheduled_memrefs;
+    for (; scheduled_memref < scheduled_memref_stop; ++scheduled_memref)
+      invalidated_memref |= rc_client_update_memref_value(client, *scheduled_memref);
+
+    client->state.processing_memref = NULL;
+  }
+  else {
+    memref_list = &memrefs->memrefs;
     do {
-      rc_modified_memref_t* modified_memref = modified_memref_list->items;
-      const rc_modified_memref_t* modified_memref_stop = modified_memref + modified_memref_list->count;
+      rc_memref_t* memref = memref_list->items;
+      const rc_memref_t* memref_stop = memref + memref_list->count;
+
+      for (; memref < memref_stop; ++memref)
+        invalidated_memref |= rc_client_update_memref_value(client, memref);
 
-      for (; modified_memref < modified_memref_stop; ++modified_memref)
-        rc_update_memref_value(&modified_memref->memref.value, rc_get_modified_memref_value(modified_memref, client->state.legacy_peek, client));
+      memref_list = memref_list->next;
+    } while (memref_list);
 
-      modified_memref_list = modified_memref_list->next;
-    } while (modified_memref_list);
+    client->state.processing_memref = NULL;
+  }
+
+  rc_memrefs_end_update(memrefs);
+
+  if (client->callbacks.read_memory_block || client->state.num_memory_regions) {
+    /* indirect reads from the same pointer are fetched as a single block */
+    rc_update_modified_memref_values_with_block_reader(memrefs, client->state.legacy_peek, rc_client_read_indirect_block, client);
+  }
+  else {
+    rc_update_modified_memref_values(memrefs, client->state.legacy_peek, client);
   }
 
   if (client->game->runtime.richpresence && client->game->runtime.richpresence->richpresence)
@@ -5461,9 +5957,15 @@ static void rc_client_do_frame_process_achievements(rc_client_t* client, rc_clie
     if (!trigger || achievement->public_.state != RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE)
       continue;
 
+    /* if the memory and the hits haven't changed since the last frame, the evaluation can be skipped */
+    if (!achievement->steady || achievement->steady->trigger != trigger) {
+      rc_trigger_steady_destroy(achievement->steady);
+      achievement->steady = rc_trigger_steady_create(trigger);
+    }
+
     old_measured_value = trigger->measured_value;
     old_state = trigger->state;
-    new_state = rc_evaluate_trigger(trigger, client->state.legacy_peek, client, NULL);
+    new_state = rc_evaluate_trigger_jit(trigger, client->state.legacy_peek, client, NULL, achievement->steady, NULL, NULL);
 
     /* trigger->state doesn't actually change to RESET - RESET just serves as a notification.
      * we don't care about that particular notification, so look at the actual state. */
@@ -5886,6 +6388,13 @@ void rc_client_do_frame(rc_client_t* client)
 
     rc_client_raise_pending_events(client, client->game);
   }
+  else if (client->game) {
+    /* memory written this frame won't be described by the next bitmap */
+    rc_memrefs_invalidate_values(client->game->runtime.memrefs);
+  }
+
+  /* the bitmap only describes a single frame */
+  client->state.dirty_pages = NULL;
 
   /* we've processed a frame. if there's a pause delay in effect, process it */
   if (client->state.unpaused_frame_decay > 0) {
@@ -34,6 +34,7 @@ typedef uint32_t (RC_CCONV* rc_client_identify_hash_func_t)(uint32_t console_id,
 
 typedef struct rc_client_callbacks_t {
   rc_client_read_memory_func_t read_memory;
+  rc_client_read_memory_func_t read_memory_block;
   rc_client_event_handler_t event_handler;
   rc_client_server_call_t server_call;
   rc_client_message_callback_t log_call;
@@ -87,6 +88,7 @@ typedef struct rc_client_achievement_info_t {
   rc_client_achievement_t public_;
 
   rc_trigger_t* trigger;
+  struct rc_trigger_steady_t* steady; /* allocated the first time an active achievement is evaluated */
   uint8_t md5[16];
 
   time_t unlock_time_hardcore;
@@ -248,6 +250,31 @@ enum {
   RC_CLIENT_GAME_PENDING_EVENT_PROGRESS_TRACKER = (1 << 3)
 };
 
+enum {
+  RC_CLIENT_READ_PLAN_SPAN_BLOCK = 0,     /* read with the read_memory_block callback into buffer */
+  RC_CLIENT_READ_PLAN_SPAN_HOST = 1,      /* buffer points at a registered memory region */
+  RC_CLIENT_READ_PLAN_SPAN_HOST_SWAP32 = 2
+};
+
+typedef struct rc_client_read_plan_span_t {
+  uint8_t* buffer;
+  uint32_t address;
+  uint32_t num_bytes; /* 0 if the memrefs in the span have to be read individually */
+  uint32_t first_memref;
+  uint32_t num_memrefs;
+  uint8_t type;
+} rc_client_read_plan_span_t;
+
+typedef struct rc_client_read_plan_t {
+  rc_memref_t** memrefs; /* sorted by address */
+  rc_client_read_plan_span_t* spans;
+  uint8_t* buffer;
+  uint32_t num_memrefs;
+  uint32_t num_spans;
+  uint32_t num_source_memrefs;
+  uint8_t dirty;
+} rc_client_read_plan_t;
+
 typedef struct rc_client_game_info_t {
   rc_client_game_t public_;
   rc_client_leaderboard_tracker_info_t* leaderboard_trackers;
@@ -258,6 +285,7 @@ typedef struct rc_client_game_info_t {
   rc_client_media_hash_t* media_hash;
 
   rc_runtime_t runtime;
+  rc_client_read_plan_t read_plan;
 
   uint32_t max_valid_address;
 
@@ -301,6 +329,14 @@ enum {
 
 struct rc_client_load_state_t;
 
+#define RC_CLIENT_MAX_MEMORY_REGIONS 16
+typedef struct rc_client_memory_region_t {
+  uint8_t* host_data;
+  uint32_t address;
+  uint32_t num_bytes;
+  uint8_t byte_order;
+} rc_client_memory_region_t;
+
 typedef struct rc_client_state_t {
   rc_mutex_t mutex;
   rc_buffer_t buffer;
@@ -334,6 +370,13 @@ typedef struct rc_client_state_t {
   rc_memref_t* processing_memref;
 
   rc_peek_t legacy_peek;
+
+  rc_client_memory_region_t memory_regions[RC_CLIENT_MAX_MEMORY_REGIONS];
+  uint32_t num_memory_regions;
+
+  const uint8_t* dirty_pages;
+  uint32_t num_dirty_pages;
+  uint32_t dirty_page_size;
 } rc_client_state_t;
 
 struct rc_client_t {
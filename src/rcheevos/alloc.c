@@ -116,6 +116,9 @@ void rc_preparse_alloc_memrefs(rc_memrefs_t* memrefs, rc_preparse_state_t* prepa
   if (memrefs) {
     memset(memrefs, 0, sizeof(*memrefs));
     preparse->parse.memrefs = memrefs;
+
+    if (preparse->parse.memref_index)
+      preparse->parse.memref_index->source = NULL;
   }
 
   if (num_memrefs) {
@@ -283,6 +286,8 @@ void rc_reset_parse_state(rc_parse_state_t* parse, void* buffer)
   parse->memrefs = NULL;
   parse->existing_memrefs = NULL;
   parse->variables = NULL;
+  if (parse->memref_index)
+    parse->memref_index->source = NULL;
   parse->measured_target = 0;
   parse->lines_read = 0;
   parse->addsource_oper = RC_OPERATOR_NONE;
@@ -293,6 +298,8 @@ void rc_reset_parse_state(rc_parse_state_t* parse, void* buffer)
   parse->has_required_hits = 0;
   parse->measured_as_percent = 0;
   parse->ignore_non_parse_errors = 0;
+  parse->optimize = 1;
+  parse->track_selectivity = 0;
 
   parse->scratch.strings = NULL;
 }
@@ -302,6 +309,7 @@ void rc_init_parse_state(rc_parse_state_t* parse, void* buffer)
   /* could use memset here, but rc_parse_state_t contains a 512 byte buffer that doesn't need to be initialized */
   rc_buffer_init(&parse->scratch.buffer);
   memset(&parse->scratch.objs, 0, sizeof(parse->scratch.objs));
+  parse->memref_index = NULL;
 
   rc_reset_parse_state(parse, buffer);
 }
@@ -309,4 +317,7 @@ void rc_init_parse_state(rc_parse_state_t* parse, void* buffer)
 void rc_destroy_parse_state(rc_parse_state_t* parse)
 {
   rc_buffer_destroy(&parse->scratch.buffer);
+
+  rc_memref_index_destroy(parse->memref_index);
+  parse->memref_index = NULL;
 }
@@ -4,7 +4,7 @@
 #include <string.h>
 #include <assert.h>
 
-static int rc_test_condition_compare(uint32_t value1, uint32_t value2, uint8_t oper) {
+int rc_test_condition_compare(uint32_t value1, uint32_t value2, uint8_t oper) {
   switch (oper) {
     case RC_OPERATOR_EQ: return value1 == value2;
     case RC_OPERATOR_NE: return value1 != value2;
@@ -342,7 +342,41 @@ void rc_parse_condition_internal(rc_condition_t* self, const char** memaddr, rc_
   *memaddr = aux;
 }
 
+/* if both sides of a modification are integer constants, the result is a constant too. calculate it
+ * the same way the modified memref would, so it doesn't have to be recalculated every frame */
+static void rc_condition_fold_constants(rc_operand_t* result, const rc_operand_t* parent,
+                                        uint8_t modifier_type, const rc_operand_t* modifier) {
+  rc_modified_memref_t modified_memref;
+
+  memset(&modified_memref, 0, sizeof(modified_memref));
+  modified_memref.memref.value.type = RC_VALUE_TYPE_UNSIGNED;
+  memcpy(&modified_memref.parent, parent, sizeof(modified_memref.parent));
+  memcpy(&modified_memref.modifier, modifier, sizeof(modified_memref.modifier));
+  modified_memref.modifier_type = modifier_type;
+
+  rc_operand_set_const(result, rc_get_modified_memref_value(&modified_memref, NULL, NULL));
+}
+
+/* if an AddSource or SubSource condition only references integer constants, gets its value */
+static int rc_condition_get_constant(const rc_condition_t* condition, rc_operand_t* operand, const rc_parse_state_t* parse) {
+  if (!parse->optimize || condition->operand1.type != RC_OPERAND_CONST)
+    return 0;
+
+  if (condition->oper == RC_OPERATOR_NONE) {
+    memcpy(operand, &condition->operand1, sizeof(*operand));
+    return 1;
+  }
+
+  if (!rc_operator_is_modifying(condition->oper) || condition->operand2.type != RC_OPERAND_CONST)
+    return 0;
+
+  rc_condition_fold_constants(operand, &condition->operand1, condition->oper, &condition->operand2);
+  return 1;
+}
+
 void rc_condition_update_parse_state(rc_condition_t* condition, rc_parse_state_t* parse) {
+  rc_operand_t constant;
+
   /* type of values in the chain are determined by the parent.
    * the last element of a chain is determined by the operand
    *
@@ -362,7 +396,12 @@ void rc_condition_update_parse_state(rc_condition_t* condition, rc_parse_state_t
 
     case RC_CONDITION_ADD_SOURCE:
       if (parse->addsource_parent.type == RC_OPERAND_NONE) {
-        rc_condition_convert_to_operand(condition, &parse->addsource_parent, parse);
+        if (!rc_condition_get_constant(condition, &parse->addsource_parent, parse))
+          rc_condition_convert_to_operand(condition, &parse->addsource_parent, parse);
+      }
+      else if (parse->addsource_parent.type == RC_OPERAND_CONST && rc_condition_get_constant(condition, &constant, parse)) {
+        /* adding a constant to a constant */
+        rc_condition_fold_constants(&parse->addsource_parent, &parse->addsource_parent, parse->addsource_oper, &constant);
       }
       else {
         rc_operand_t cond_operand;
@@ -380,9 +419,15 @@ void rc_condition_update_parse_state(rc_condition_t* condition, rc_parse_state_t
 
     case RC_CONDITION_SUB_SOURCE:
       if (parse->addsource_parent.type == RC_OPERAND_NONE) {
-        rc_condition_convert_to_operand(condition, &parse->addsource_parent, parse);
+        if (!rc_condition_get_constant(condition, &parse->addsource_parent, parse))
+          rc_condition_convert_to_operand(condition, &parse->addsource_parent, parse);
         parse->addsource_oper = RC_OPERATOR_SUB_PARENT;
       }
+      else if (parse->addsource_parent.type == RC_OPERAND_CONST && parse->addsource_oper == RC_OPERATOR_ADD &&
+               rc_condition_get_constant(condition, &constant, parse)) {
+        /* subtracting a constant from a constant */
+        rc_condition_fold_constants(&parse->addsource_parent, &parse->addsource_parent, RC_OPERATOR_SUB, &constant);
+      }
       else {
         rc_operand_t cond_operand;
         /* type determined by parent */
@@ -694,7 +739,7 @@ static int rc_test_condition_compare_delta_to_memref_transformed(rc_condition_t*
   }
 }
 
-int rc_test_condition(rc_condition_t* self, rc_eval_state_t* eval_state) {
+static int rc_test_condition_internal(rc_condition_t* self, rc_eval_state_t* eval_state) {
   rc_typed_value_t value1, value2;
 
   /* use an optimized comparator whenever possible */
@@ -733,6 +778,391 @@ int rc_test_condition(rc_condition_t* self, rc_eval_state_t* eval_state) {
   return rc_typed_value_compare(&value1, &value2, self->oper);
 }
 
+static int rc_test_shared_condition(rc_shared_conditions_t* shared, uint32_t index, rc_eval_state_t* eval_state) {
+  const uint32_t offset = index >> 3;
+  const uint8_t mask = (uint8_t)(1 << (index & 7));
+
+  if (!(shared->evaluated[offset] & mask)) {
+    shared->evaluated[offset] |= mask;
+
+    if (rc_test_condition_internal(&shared->conditions[index], eval_state))
+      shared->results[offset] |= mask;
+    else
+      shared->results[offset] &= ~mask;
+  }
+
+  return (shared->results[offset] & mask) != 0;
+}
+
+int rc_test_condition(rc_condition_t* self, rc_eval_state_t* eval_state) {
+  uint16_t shared_index;
+
+  /* the comparison only depends on the memrefs, so another condition may have already evaluated it this frame */
+  if (eval_state->shared_indices) {
+    shared_index = eval_state->shared_indices[self - eval_state->conditions];
+    if (shared_index)
+      return rc_test_shared_condition(eval_state->shared_conditions, shared_index - 1, eval_state);
+  }
+
+  return rc_test_condition_internal(self, eval_state);
+}
+
+/* ===== shared conditions ===== */
+
+static int rc_shared_conditions_can_share(const rc_condition_t* condition) {
+  switch (condition->oper) {
+    case RC_OPERATOR_EQ:
+    case RC_OPERATOR_NE:
+    case RC_OPERATOR_LT:
+    case RC_OPERATOR_LE:
+    case RC_OPERATOR_GT:
+    case RC_OPERATOR_GE:
+      break;
+
+    default:
+      return 0;
+  }
+
+  switch (condition->optimized_comparator) {
+    case RC_PROCESSING_COMPARE_DEFAULT:
+    case RC_PROCESSING_COMPARE_MEMREF_TO_CONST_TRANSFORMED:
+    case RC_PROCESSING_COMPARE_MEMREF_TO_DELTA_TRANSFORMED:
+    case RC_PROCESSING_COMPARE_MEMREF_TO_MEMREF_TRANSFORMED:
+    case RC_PROCESSING_COMPARE_DELTA_TO_MEMREF_TRANSFORMED:
+    case RC_PROCESSING_COMPARE_DELTA_TO_CONST_TRANSFORMED:
+      break;
+
+    default:
+      /* the other comparators cost about as much as looking up a shared result */
+      return 0;
+  }
+
+  /* the recall accumulator is specific to the condset */
+  if (rc_operand_is_recall(&condition->operand1) || rc_operand_is_recall(&condition->operand2))
+    return 0;
+
+  return (condition->operand1.type != RC_OPERAND_FUNC && condition->operand2.type != RC_OPERAND_FUNC);
+}
+
+static int rc_shared_conditions_operands_equal(const rc_operand_t* left, const rc_operand_t* right) {
+  if (left->type != right->type)
+    return 0;
+
+  switch (left->type) {
+    case RC_OPERAND_CONST:
+      return left->value.num == right->value.num;
+
+    case RC_OPERAND_FP:
+      return left->value.dbl == right->value.dbl;
+
+    default:
+      /* memrefs are pooled by the runtime, so the same memory has the same memref */
+      return left->value.memref == right->value.memref && left->size == right->size &&
+             left->memref_access_type == right->memref_access_type && left->is_combining == right->is_combining;
+  }
+}
+
+static uint32_t rc_shared_conditions_hash_operand(uint32_t hash, const rc_operand_t* operand) {
+  const uint8_t* bytes;
+  size_t i, count;
+
+  switch (operand->type) {
+    case RC_OPERAND_CONST:
+      bytes = (const uint8_t*)&operand->value.num;
+      count = sizeof(operand->value.num);
+      break;
+
+    case RC_OPERAND_FP:
+      bytes = (const uint8_t*)&operand->value.dbl;
+      count = sizeof(operand->value.dbl);
+      break;
+
+    default:
+      bytes = (const uint8_t*)&operand->value.memref;
+      count = sizeof(operand->value.memref);
+      hash = (hash ^ operand->size) * 16777619;
+      break;
+  }
+
+  hash = (hash ^ operand->type) * 16777619;
+  for (i = 0; i < count; ++i)
+    hash = (hash ^ bytes[i]) * 16777619;
+
+  return hash;
+}
+
+static uint32_t rc_shared_conditions_hash(const rc_condition_t* condition) {
+  uint32_t hash = 2166136261U;
+
+  hash = (hash ^ condition->oper) * 16777619;
+  hash = rc_shared_conditions_hash_operand(hash, &condition->operand1);
+  hash = rc_shared_conditions_hash_operand(hash, &condition->operand2);
+
+  return hash;
+}
+
+static void rc_shared_conditions_canonicalize(rc_condition_t* canonical, const rc_condition_t* condition) {
+  memset(canonical, 0, sizeof(*canonical));
+  canonical->type = RC_CONDITION_STANDARD;
+
+  /* "5<0xH1234" is the same comparison as "0xH1234>5" */
+  if ((condition->operand1.type == RC_OPERAND_CONST || condition->operand1.type == RC_OPERAND_FP) &&
+      condition->operand2.type != RC_OPERAND_CONST && condition->operand2.type != RC_OPERAND_FP) {
+    memcpy(&canonical->operand1, &condition->operand2, sizeof(canonical->operand1));
+    memcpy(&canonical->operand2, &condition->operand1, sizeof(canonical->operand2));
+
+    switch (condition->oper) {
+      case RC_OPERATOR_LT: canonical->oper = RC_OPERATOR_GT; break;
+      case RC_OPERATOR_LE: canonical->oper = RC_OPERATOR_GE; break;
+      case RC_OPERATOR_GT: canonical->oper = RC_OPERATOR_LT; break;
+      case RC_OPERATOR_GE: canonical->oper = RC_OPERATOR_LE; break;
+      default: canonical->oper = condition->oper; break;
+    }
+
+    canonical->optimized_comparator = rc_condition_determine_comparator(canonical);
+  }
+  else {
+    memcpy(&canonical->operand1, &condition->operand1, sizeof(canonical->operand1));
+    memcpy(&canonical->operand2, &condition->operand2, sizeof(canonical->operand2));
+    canonical->oper = condition->oper;
+    canonical->optimized_comparator = condition->optimized_comparator;
+  }
+}
+
+static int rc_shared_conditions_grow(rc_shared_conditions_t* self) {
+  const uint32_t capacity = self->capacity ? self->capacity * 2 : 64;
+  const uint32_t num_slots = capacity * 2;
+  rc_condition_t* conditions;
+  uint32_t* counts;
+  uint32_t* slots;
+  uint8_t* bits;
+  uint32_t i, slot;
+
+  conditions = (rc_condition_t*)realloc(self->conditions, capacity * sizeof(rc_condition_t));
+  if (!conditions)
+    return 0;
+  self->conditions = conditions;
+
+  counts = (uint32_t*)realloc(self->references, capacity * sizeof(uint32_t));
+  if (!counts)
+    return 0;
+  self->references = counts;
+
+  counts = (uint32_t*)realloc(self->free_indices, capacity * sizeof(uint32_t));
+  if (!counts)
+    return 0;
+  self->free_indices = counts;
+
+  bits = (uint8_t*)realloc(self->evaluated, capacity / 8);
+  if (!bits)
+    return 0;
+  memset(&bits[self->capacity / 8], 0, (capacity - self->capacity) / 8);
+  self->evaluated = bits;
+
+  bits = (uint8_t*)realloc(self->results, capacity / 8);
+  if (!bits)
+    return 0;
+  memset(&bits[self->capacity / 8], 0, (capacity - self->capacity) / 8);
+  self->results = bits;
+
+  slots = (uint32_t*)calloc(num_slots, sizeof(uint32_t));
+  if (!slots)
+    return 0;
+
+  for (i = 0; i < self->count; ++i) {
+    if (self->references[i] == 0)
+      continue;
+
+    slot = rc_shared_conditions_hash(&conditions[i]) & (num_slots - 1);
+    while (slots[slot])
+      slot = (slot + 1) & (num_slots - 1);
+    slots[slot] = i + 1;
+  }
+
+  if (self->slots)
+    free(self->slots);
+
+  self->slots = slots;
+  self->num_slots = num_slots;
+  self->capacity = capacity;
+  return 1;
+}
+
+static uint16_t rc_shared_conditions_add(rc_shared_conditions_t* self, const rc_condition_t* condition) {
+  rc_condition_t canonical;
+  const rc_condition_t* existing;
+  uint32_t slot, index;
+
+  rc_shared_conditions_canonicalize(&canonical, condition);
+
+  if (self->num_slots) {
+    slot = rc_shared_conditions_hash(&canonical) & (self->num_slots - 1);
+    while (self->slots[slot]) {
+      existing = &self->conditions[self->slots[slot] - 1];
+      if (existing->oper == canonical.oper &&
+          rc_shared_conditions_operands_equal(&existing->operand1, &canonical.operand1) &&
+          rc_shared_conditions_operands_equal(&existing->operand2, &canonical.operand2)) {
+        ++self->references[self->slots[slot] - 1];
+        return (uint16_t)self->slots[slot];
+      }
+
+      slot = (slot + 1) & (self->num_slots - 1);
+    }
+  }
+
+  if (self->num_free) {
+    index = self->free_indices[--self->num_free];
+  }
+  else {
+    /* the index has to fit in the uint16_t returned by rc_shared_conditions_index_trigger */
+    if (self->count == 0xFFFF)
+      return 0;
+
+    if (self->count == self->capacity && !rc_shared_conditions_grow(self))
+      return 0;
+
+    index = self->count++;
+  }
+
+  slot = rc_shared_conditions_hash(&canonical) & (self->num_slots - 1);
+  while (self->slots[slot])
+    slot = (slot + 1) & (self->num_slots - 1);
+
+  memcpy(&self->conditions[index], &canonical, sizeof(canonical));
+  self->references[index] = 1;
+  self->slots[slot] = index + 1;
+
+  /* a reused entry may have been evaluated earlier in the frame */
+  self->evaluated[index >> 3] &= ~(uint8_t)(1 << (index & 7));
+  return (uint16_t)(index + 1);
+}
+
+static void rc_shared_conditions_remove(rc_shared_conditions_t* self, uint32_t index) {
+  const uint32_t mask = self->num_slots - 1;
+  uint32_t slot, next, home;
+
+  slot = rc_shared_conditions_hash(&self->conditions[index]) & mask;
+  while (self->slots[slot] != index + 1)
+    slot = (slot + 1) & mask;
+
+  /* move any later entries of the probe sequence that can't be found past the empty slot back into it */
+  next = slot;
+  for (;;) {
+    self->slots[slot] = 0;
+
+    do {
+      next = (next + 1) & mask;
+      if (!self->slots[next]) {
+        self->free_indices[self->num_free++] = index;
+        return;
+      }
+
+      home = rc_shared_conditions_hash(&self->conditions[self->slots[next] - 1]) & mask;
+    } while (((next - home) & mask) < ((next - slot) & mask));
+
+    self->slots[slot] = self->slots[next];
+    slot = next;
+  }
+}
+
+void rc_shared_conditions_release(rc_shared_conditions_t* self, const uint16_t* indices, uint32_t num_indices) {
+  uint32_t i, index;
+
+  if (!self || !indices)
+    return;
+
+  for (i = 0; i < num_indices; ++i) {
+    if (indices[i]) {
+      index = indices[i] - 1;
+      if (--self->references[index] == 0)
+        rc_shared_conditions_remove(self, index);
+    }
+  }
+}
+
+static int rc_shared_conditions_index_condset(rc_shared_conditions_t* self, rc_condset_t* condset, uint16_t* indices) {
+  const rc_condition_t* condition = rc_condset_get_conditions(condset);
+  const uint32_t num_conditions = rc_condset_count_conditions(condset);
+  int is_shared = 0;
+  uint32_t i;
+
+  /* the indices are in the order of the conditions array (grouped by segment), not the order of the next chain */
+  for (i = 0; i < num_conditions; ++i) {
+    indices[i] = rc_shared_conditions_can_share(&condition[i]) ? rc_shared_conditions_add(self, &condition[i]) : 0;
+    is_shared |= (indices[i] != 0);
+  }
+
+  return is_shared;
+}
+
+uint16_t* rc_shared_conditions_index_trigger(rc_shared_conditions_t* self, rc_trigger_t* trigger, uint32_t* num_indices) {
+  rc_condset_t* condset;
+  uint16_t* indices;
+  uint32_t num_conditions = 0;
+  uint32_t offset = 0;
+  int is_shared = 0;
+
+  *num_indices = 0;
+  if (!self)
+    return NULL;
+
+  if (trigger->requirement)
+    num_conditions += rc_condset_count_conditions(trigger->requirement);
+  for (condset = trigger->alternative; condset; condset = condset->next)
+    num_conditions += rc_condset_count_conditions(condset);
+
+  if (num_conditions == 0)
+    return NULL;
+
+  indices = (uint16_t*)malloc(num_conditions * sizeof(uint16_t));
+  if (!indices)
+    return NULL;
+
+  if (trigger->requirement) {
+    is_shared |= rc_shared_conditions_index_condset(self, trigger->requirement, indices);
+    offset += rc_condset_count_conditions(trigger->requirement);
+  }
+
+  for (condset = trigger->alternative; condset; condset = condset->next) {
+    is_shared |= rc_shared_conditions_index_condset(self, condset, &indices[offset]);
+    offset += rc_condset_count_conditions(condset);
+  }
+
+  /* don't make the evaluation look up indices that are all zero */
+  if (!is_shared) {
+    free(indices);
+    return NULL;
+  }
+
+  *num_indices = num_conditions;
+  return indices;
+}
+
+void rc_shared_conditions_begin_frame(rc_shared_conditions_t* self) {
+  if (self && self->count)
+    memset(self->evaluated, 0, (self->count + 7) / 8);
+}
+
+void rc_shared_conditions_destroy(rc_shared_conditions_t* self) {
+  if (!self)
+    return;
+
+  if (self->conditions)
+    free(self->conditions);
+  if (self->references)
+    free(self->references);
+  if (self->free_indices)
+    free(self->free_indices);
+  if (self->slots)
+    free(self->slots);
+  if (self->evaluated)
+    free(self->evaluated);
+  if (self->results)
+    free(self->results);
+
+  free(self);
+}
+
 void rc_evaluate_condition_value(rc_typed_value_t* value, rc_condition_t* self, rc_eval_state_t* eval_state) {
   rc_typed_value_t amount;
 
@@ -62,8 +62,10 @@ static int32_t rc_classify_conditions(rc_condset_t* self, const char* memaddr, c
   do {
     rc_parse_condition_internal(&condition, &memaddr, &parse);
 
-    if (parse.offset < 0)
+    if (parse.offset < 0) {
+      rc_destroy_parse_state(&parse);
       return parse.offset;
+    }
 
     ++index;
 
@@ -106,6 +108,7 @@ static int32_t rc_classify_conditions(rc_condset_t* self, const char* memaddr, c
    * logic in rc_find_next_classification */
   self->num_other_conditions += chain_length - 1;
 
+  rc_destroy_parse_state(&parse);
   return index;
 }
 
@@ -130,10 +133,12 @@ static int rc_find_next_classification(const char* memaddr) {
         break;
 
       default:
+        rc_destroy_parse_state(&parse);
         return classification;
     }
   } while (*memaddr++ == '_');
 
+  rc_destroy_parse_state(&parse);
   return RC_CONDITION_CLASSIFICATION_OTHER;
 }
 
@@ -196,6 +201,374 @@ static void rc_update_condition_pause_remember(rc_condset_t* self) {
   }
 }
 
+/* ===== parse-time optimizer ===== */
+
+static uint32_t rc_condset_get_size_max(uint8_t size) {
+  /* values of these sizes are always masked by rc_transform_memref_value. 8-bit, 16-bit and 32-bit values
+   * may be compared without being masked, and are only as small as the peek callback makes them */
+  switch (size) {
+    case RC_MEMSIZE_BIT_0:
+    case RC_MEMSIZE_BIT_1:
+    case RC_MEMSIZE_BIT_2:
+    case RC_MEMSIZE_BIT_3:
+    case RC_MEMSIZE_BIT_4:
+    case RC_MEMSIZE_BIT_5:
+    case RC_MEMSIZE_BIT_6:
+    case RC_MEMSIZE_BIT_7:
+      return 1;
+
+    case RC_MEMSIZE_LOW:
+    case RC_MEMSIZE_HIGH:
+      return 0x0F;
+
+    case RC_MEMSIZE_BITCOUNT:
+      return 8;
+
+    case RC_MEMSIZE_16_BITS_BE:
+      return 0xFFFF;
+
+    case RC_MEMSIZE_24_BITS:
+    case RC_MEMSIZE_24_BITS_BE:
+      return 0xFFFFFF;
+
+    default:
+      return 0xFFFFFFFF;
+  }
+}
+
+static int rc_condset_get_operand_range(const rc_operand_t* operand, uint32_t* min_val, uint32_t* max_val);
+
+static uint32_t rc_condset_get_modified_memref_max(const rc_modified_memref_t* modified_memref) {
+  uint32_t parent_min, parent_max, modifier_min, modifier_max;
+
+  if (modified_memref->memref.value.type != RC_VALUE_TYPE_UNSIGNED ||
+      modified_memref->modifier_type == RC_OPERATOR_INDIRECT_READ ||
+      !rc_condset_get_operand_range(&modified_memref->parent, &parent_min, &parent_max) ||
+      !rc_condset_get_operand_range(&modified_memref->modifier, &modifier_min, &modifier_max)) {
+    return 0xFFFFFFFF;
+  }
+
+  /* only the results that can't overflow are bounded */
+  switch (modified_memref->modifier_type) {
+    case RC_OPERATOR_AND:
+      return (parent_max < modifier_max) ? parent_max : modifier_max;
+
+    case RC_OPERATOR_MOD:
+      if (modifier_min == 0)
+        break;
+      return (parent_max < modifier_max - 1) ? parent_max : modifier_max - 1;
+
+    case RC_OPERATOR_DIV:
+      if (modifier_min == 0)
+        break;
+      return parent_max / modifier_min;
+
+    case RC_OPERATOR_ADD:
+      if (parent_max > 0xFFFFFFFF - modifier_max)
+        break;
+      return parent_max + modifier_max;
+
+    case RC_OPERATOR_MULT:
+      if (modifier_max != 0 && parent_max > 0xFFFFFFFF / modifier_max)
+        break;
+      return parent_max * modifier_max;
+
+    default:
+      break;
+  }
+
+  return 0xFFFFFFFF;
+}
+
+/* determines the values an operand can have. returns 0 if the operand isn't an unsigned integer,
+ * in which case comparisons against it aren't unsigned integer comparisons */
+static int rc_condset_get_operand_range(const rc_operand_t* operand, uint32_t* min_val, uint32_t* max_val) {
+  switch (operand->type) {
+    case RC_OPERAND_CONST:
+      *min_val = *max_val = operand->value.num;
+      return 1;
+
+    case RC_OPERAND_ADDRESS:
+    case RC_OPERAND_DELTA:
+    case RC_OPERAND_PRIOR:
+      if (rc_operand_is_float(operand))
+        return 0;
+      break;
+
+    default:
+      /* floats and recalls may not be unsigned. BCD and inverted values aren't worth bounding */
+      return 0;
+  }
+
+  /* memrefs are 0 until they're read, and modified memrefs are 0 until they're calculated */
+  *min_val = 0;
+  *max_val = rc_condset_get_size_max(operand->size);
+
+  if (operand->value.memref->value.memref_type == RC_MEMREF_TYPE_MODIFIED_MEMREF) {
+    const uint32_t modified_max = rc_condset_get_modified_memref_max((const rc_modified_memref_t*)operand->value.memref);
+    if (modified_max < *max_val)
+      *max_val = modified_max;
+  }
+
+  return 1;
+}
+
+/* returns RC_PROCESSING_COMPARE_ALWAYS_TRUE or RC_PROCESSING_COMPARE_ALWAYS_FALSE if every value
+ * in the first range compares the same way to every value in the second range */
+static uint8_t rc_condset_compare_ranges(uint8_t oper, uint32_t min1, uint32_t max1, uint32_t min2, uint32_t max2) {
+  int result;
+
+  switch (oper) {
+    case RC_OPERATOR_EQ:
+    case RC_OPERATOR_NE:
+      if (max1 < min2 || min1 > max2)
+        result = 0;
+      else if (min1 == max1 && min2 == max2) /* ranges overlap, so the values are the same */
+        result = 1;
+      else
+        return RC_PROCESSING_COMPARE_DEFAULT;
+
+      if (oper == RC_OPERATOR_NE)
+        result = !result;
+      break;
+
+    case RC_OPERATOR_LT:
+      if (max1 < min2)
+        result = 1;
+      else if (min1 >= max2)
+        result = 0;
+      else
+        return RC_PROCESSING_COMPARE_DEFAULT;
+      break;
+
+    case RC_OPERATOR_LE:
+      if (max1 <= min2)
+        result = 1;
+      else if (min1 > max2)
+        result = 0;
+      else
+        return RC_PROCESSING_COMPARE_DEFAULT;
+      break;
+
+    case RC_OPERATOR_GT:
+      if (min1 > max2)
+        result = 1;
+      else if (max1 <= min2)
+        result = 0;
+      else
+        return RC_PROCESSING_COMPARE_DEFAULT;
+      break;
+
+    case RC_OPERATOR_GE:
+      if (min1 >= max2)
+        result = 1;
+      else if (max1 < min2)
+        result = 0;
+      else
+        return RC_PROCESSING_COMPARE_DEFAULT;
+      break;
+
+    default:
+      return RC_PROCESSING_COMPARE_DEFAULT;
+  }
+
+  return result ? RC_PROCESSING_COMPARE_ALWAYS_TRUE : RC_PROCESSING_COMPARE_ALWAYS_FALSE;
+}
+
+/* every condition keeps its own hit count and truthiness, which are part of the serialized progress,
+ * so conditions can't be removed. but if the range of values the operands can have determines the
+ * result of a comparison, it can be evaluated without reading either operand */
+static void rc_condset_optimize(rc_condset_t* self) {
+  rc_condition_t* condition;
+  uint32_t min1, max1, min2, max2;
+  uint8_t comparator;
+
+  for (condition = self->conditions; condition; condition = condition->next) {
+    switch (condition->optimized_comparator) {
+      case RC_PROCESSING_COMPARE_ALWAYS_TRUE:
+      case RC_PROCESSING_COMPARE_ALWAYS_FALSE:
+        continue;
+
+      default:
+        break;
+    }
+
+    switch (condition->type) {
+      case RC_CONDITION_ADD_SOURCE:
+      case RC_CONDITION_SUB_SOURCE:
+      case RC_CONDITION_ADD_ADDRESS:
+      case RC_CONDITION_REMEMBER:
+        /* these are handled by rc_modified_memref_t */
+        continue;
+
+      default:
+        break;
+    }
+
+    if (!rc_condset_get_operand_range(&condition->operand1, &min1, &max1) ||
+        !rc_condset_get_operand_range(&condition->operand2, &min2, &max2))
+      continue;
+
+    comparator = rc_condset_compare_ranges(condition->oper, min1, max1, min2, max2);
+    if (comparator != RC_PROCESSING_COMPARE_DEFAULT)
+      condition->optimized_comparator = comparator;
+  }
+}
+
+/* ===== field compares ===== */
+
+/* bit and nibble sizes share the 8-bit memref of their address (see rc_memref_shared_size), and a
+ * field only has a few values. a comparison of a field to a constant is usually true for exactly one
+ * of them (or for all but one), so it can be done by masking the shared byte instead of extracting
+ * the field. returns RC_OPERATOR_EQ or RC_OPERATOR_NE if ((value & mask) OP expected) matches the
+ * condition for every value of the memref, or RC_OPERATOR_NONE if the condition can't be converted */
+static uint8_t rc_condset_get_field_compare(const rc_condition_t* condition, uint8_t* mask, uint8_t* expected) {
+  uint32_t field_mask, shift, value, num_true, true_value = 0, false_value = 0;
+
+  switch (condition->optimized_comparator) {
+    case RC_PROCESSING_COMPARE_MEMREF_TO_CONST_TRANSFORMED:
+    case RC_PROCESSING_COMPARE_DELTA_TO_CONST_TRANSFORMED:
+      if (condition->operand1.value.memref->value.size != RC_MEMSIZE_8_BITS)
+        return RC_OPERATOR_NONE;
+      break;
+
+    default:
+      return RC_OPERATOR_NONE;
+  }
+
+  switch (condition->operand1.size) {
+    case RC_MEMSIZE_LOW:  field_mask = 0x0F; shift = 0; break;
+    case RC_MEMSIZE_HIGH: field_mask = 0x0F; shift = 4; break;
+
+    case RC_MEMSIZE_BIT_0: case RC_MEMSIZE_BIT_1: case RC_MEMSIZE_BIT_2: case RC_MEMSIZE_BIT_3:
+    case RC_MEMSIZE_BIT_4: case RC_MEMSIZE_BIT_5: case RC_MEMSIZE_BIT_6: case RC_MEMSIZE_BIT_7:
+      field_mask = 0x01;
+      shift = condition->operand1.size - RC_MEMSIZE_BIT_0;
+      break;
+
+    default:
+      return RC_OPERATOR_NONE;
+  }
+
+  num_true = 0;
+  for (value = 0; value <= field_mask; ++value) {
+    if (rc_test_condition_compare(value, condition->operand2.value.num, condition->oper)) {
+      ++num_true;
+      true_value = value;
+    }
+    else {
+      false_value = value;
+    }
+  }
+
+  if (num_true == 0 || num_true == field_mask + 1) {
+    /* nothing has to be read. ((value & 0) == 0) is always true, ((value & 0) != 0) never is */
+    *mask = 0;
+    *expected = 0;
+    return (num_true == 0) ? RC_OPERATOR_NE : RC_OPERATOR_EQ;
+  }
+
+  *mask = (uint8_t)(field_mask << shift);
+
+  if (num_true == 1) {
+    *expected = (uint8_t)(true_value << shift);
+    return RC_OPERATOR_EQ;
+  }
+
+  if (num_true == field_mask) {
+    *expected = (uint8_t)(false_value << shift);
+    return RC_OPERATOR_NE;
+  }
+
+  return RC_OPERATOR_NONE;
+}
+
+/* ===== selectivity ===== */
+
+static uint8_t rc_condset_get_condition_cost(const rc_condition_t* condition) {
+  uint8_t mask, expected;
+
+  switch (condition->optimized_comparator) {
+    case RC_PROCESSING_COMPARE_MEMREF_TO_CONST:
+    case RC_PROCESSING_COMPARE_DELTA_TO_CONST:
+    case RC_PROCESSING_COMPARE_ALWAYS_TRUE:
+    case RC_PROCESSING_COMPARE_ALWAYS_FALSE:
+      /* compiled to a single comparison. see rc_condset_compile_condition */
+      return 1;
+
+    case RC_PROCESSING_COMPARE_DEFAULT:
+      /* operands are evaluated into typed values, which may have to be converted to float */
+      return (rc_operand_is_float(&condition->operand1) || rc_operand_is_float(&condition->operand2)) ? 4 : 3;
+
+    default:
+      /* field compares are compiled to a single comparison too */
+      return (rc_condset_get_field_compare(condition, &mask, &expected) != RC_OPERATOR_NONE) ? 1 : 2;
+  }
+}
+
+static void rc_condset_init_selectivity(rc_condset_t* self, rc_condset_selectivity_t* selectivity, rc_parse_state_t* parse) {
+  rc_condset_with_trailing_conditions_t* condset_with_conditions = (rc_condset_with_trailing_conditions_t*)self;
+  rc_condset_selectivity_entry_t* entry;
+  rc_condition_t* conditions;
+  uint32_t num_conditions;
+  uint32_t i, j;
+  int can_reorder = 0;
+
+  if (!selectivity)
+    return;
+
+  /* chains aren't identified until the conditions are stored. reserve an entry for each condition */
+  num_conditions = self->num_other_conditions;
+  selectivity->entries = RC_ALLOC_ARRAY(rc_condset_selectivity_entry_t, num_conditions, parse);
+  if (!parse->buffer || parse->offset < 0)
+    return;
+
+  conditions = &condset_with_conditions->conditions[self->num_pause_conditions + self->num_reset_conditions +
+                                                    self->num_hittarget_conditions + self->num_measured_conditions];
+
+  entry = selectivity->entries;
+  for (i = 0; i < num_conditions; i = j) {
+    /* a combining condition is evaluated with the conditions up to and including the one it modifies */
+    j = i;
+    while (j < num_conditions - 1 && rc_condition_is_combining(&conditions[j]))
+      ++j;
+    ++j;
+
+    entry->index = (uint16_t)i;
+    entry->num_conditions = (uint16_t)(j - i);
+    entry->num_evaluations = 0;
+    entry->num_false = 0;
+    entry->cost = rc_condset_get_condition_cost(&conditions[i]);
+    entry->is_independent = (j - i == 1 && conditions[i].type == RC_CONDITION_STANDARD &&
+                             conditions[i].required_hits == 0);
+
+    if (entry->is_independent && entry > selectivity->entries && entry[-1].is_independent)
+      can_reorder = 1;
+
+    ++entry;
+  }
+
+  selectivity->num_entries = (uint32_t)(entry - selectivity->entries);
+  selectivity->num_evaluations = 0;
+
+  /* without two adjacent independent conditions, there's nothing to reorder */
+  condset_with_conditions->is_selective = (uint8_t)can_reorder;
+}
+
+rc_condset_selectivity_t* rc_condset_get_selectivity(rc_condset_t* self) {
+  const uint32_t num_conditions = rc_condset_count_conditions(self) + self->num_indirect_conditions;
+  uint32_t offset;
+
+  if (!((rc_condset_with_trailing_conditions_t*)self)->is_selective)
+    return NULL;
+
+  /* the selectivity is allocated immediately after the conditions array (see rc_parse_condset). the condset
+   * is aligned at least as strictly as the selectivity, so the padding between them only depends on the offset */
+  offset = (uint32_t)((uint8_t*)(rc_condset_get_conditions(self) + num_conditions) - (uint8_t*)self);
+  offset = (offset + RC_ALIGNOF(rc_condset_selectivity_t) - 1) & ~(RC_ALIGNOF(rc_condset_selectivity_t) - 1);
+  return (rc_condset_selectivity_t*)((uint8_t*)self + offset);
+}
+
 rc_condset_t* rc_parse_condset(const char** memaddr, rc_parse_state_t* parse) {
   rc_condset_with_trailing_conditions_t* condset_with_conditions;
   rc_condset_t local_condset;
@@ -209,6 +582,7 @@ rc_condset_t* rc_parse_condset(const char** memaddr, rc_parse_state_t* parse) {
   rc_condition_t* measured_conditions = NULL;
   rc_condition_t* other_conditions = NULL;
   rc_condition_t* indirect_conditions = NULL;
+  rc_condset_selectivity_t* selectivity = NULL;
   int classification, combining_classification = RC_CONDITION_CLASSIFICATION_COMBINING;
   uint32_t measured_target = 0;
   int32_t result;
@@ -229,6 +603,12 @@ rc_condset_t* rc_parse_condset(const char** memaddr, rc_parse_state_t* parse) {
 
   condset_with_conditions = RC_ALLOC_WITH_TRAILING(rc_condset_with_trailing_conditions_t,
                                                    rc_condition_t, conditions, result, parse);
+
+  /* short circuited condsets track how often each condition stops the evaluation. the counters are
+   * allocated immediately after the conditions so the condset doesn't need a pointer to them */
+  if (parse->track_selectivity && local_condset.num_other_conditions >= 2)
+    selectivity = RC_ALLOC(rc_condset_selectivity_t, parse);
+
   if (parse->offset < 0)
     return NULL;
 
@@ -237,6 +617,9 @@ rc_condset_t* rc_parse_condset(const char** memaddr, rc_parse_state_t* parse) {
   conditions = &condset_with_conditions->conditions[0];
 
   if (parse->buffer) {
+    condset_with_conditions->has_hits = 0;
+    condset_with_conditions->is_selective = 0;
+
     pause_conditions = conditions;
     conditions += self->num_pause_conditions;
 
@@ -403,9 +786,201 @@ rc_condset_t* rc_parse_condset(const char** memaddr, rc_parse_state_t* parse) {
   if (self->has_pause && parse->buffer && parse->remember.type != RC_OPERAND_NONE)
     rc_update_condition_pause_remember(self);
 
+  if (parse->buffer && parse->optimize)
+    rc_condset_optimize(self);
+
+  rc_condset_init_selectivity(self, selectivity, parse);
+  rc_condset_compile(self, parse);
+
   return self;
 }
 
+/* ===== bytecode compiler ===== */
+
+#ifndef RC_CONDSET_NO_BYTECODE
+/* define RC_CONDSET_NO_BYTECODE to evaluate every condset with the condition walker */
+
+enum {
+  RC_CONDSET_COMPARE_NONE,             /* condition is handled elsewhere. skip it */
+  RC_CONDSET_COMPARE_MEMREF_EQ_CONST,  /* order must match RC_OPERATOR_EQ..RC_OPERATOR_NE */
+  RC_CONDSET_COMPARE_MEMREF_LT_CONST,
+  RC_CONDSET_COMPARE_MEMREF_LE_CONST,
+  RC_CONDSET_COMPARE_MEMREF_GT_CONST,
+  RC_CONDSET_COMPARE_MEMREF_GE_CONST,
+  RC_CONDSET_COMPARE_MEMREF_NE_CONST,
+  RC_CONDSET_COMPARE_DELTA_EQ_CONST,   /* order must match RC_OPERATOR_EQ..RC_OPERATOR_NE */
+  RC_CONDSET_COMPARE_DELTA_LT_CONST,
+  RC_CONDSET_COMPARE_DELTA_LE_CONST,
+  RC_CONDSET_COMPARE_DELTA_GT_CONST,
+  RC_CONDSET_COMPARE_DELTA_GE_CONST,
+  RC_CONDSET_COMPARE_DELTA_NE_CONST,
+  RC_CONDSET_COMPARE_CONDITION,        /* anything else goes through rc_test_condition */
+  RC_CONDSET_COMPARE_ALWAYS_TRUE,
+  RC_CONDSET_COMPARE_ALWAYS_FALSE,
+  RC_CONDSET_COMPARE_FIELD_EQ,         /* masks the byte loaded by the previous op. see rc_condset_get_field_compare */
+  RC_CONDSET_COMPARE_FIELD_NE,
+  RC_CONDSET_COMPARE_MEMREF_FIELD_EQ,  /* loads the byte, then does a field compare. order must match FIELD_EQ..FIELD_NE */
+  RC_CONDSET_COMPARE_MEMREF_FIELD_NE,
+  RC_CONDSET_COMPARE_DELTA_FIELD_EQ,   /* order must match FIELD_EQ..FIELD_NE */
+  RC_CONDSET_COMPARE_DELTA_FIELD_NE
+};
+
+enum {
+  RC_CONDSET_LOGIC_STANDARD,
+  RC_CONDSET_LOGIC_PAUSE_IF,
+  RC_CONDSET_LOGIC_RESET_IF,
+  RC_CONDSET_LOGIC_TRIGGER,
+  RC_CONDSET_LOGIC_MEASURED,
+  RC_CONDSET_LOGIC_MEASURED_IF,
+  RC_CONDSET_LOGIC_ADD_HITS,
+  RC_CONDSET_LOGIC_SUB_HITS,
+  RC_CONDSET_LOGIC_RESET_NEXT_IF,
+  RC_CONDSET_LOGIC_AND_NEXT,
+  RC_CONDSET_LOGIC_OR_NEXT,
+  RC_CONDSET_LOGIC_INVALID
+};
+
+static void rc_condset_compile_condition(rc_condset_op_t* op, const rc_condition_t* condition) {
+  switch (condition->type) {
+    case RC_CONDITION_STANDARD:      op->logic = RC_CONDSET_LOGIC_STANDARD; break;
+    case RC_CONDITION_PAUSE_IF:      op->logic = RC_CONDSET_LOGIC_PAUSE_IF; break;
+    case RC_CONDITION_RESET_IF:      op->logic = RC_CONDSET_LOGIC_RESET_IF; break;
+    case RC_CONDITION_TRIGGER:       op->logic = RC_CONDSET_LOGIC_TRIGGER; break;
+    case RC_CONDITION_MEASURED:      op->logic = RC_CONDSET_LOGIC_MEASURED; break;
+    case RC_CONDITION_MEASURED_IF:   op->logic = RC_CONDSET_LOGIC_MEASURED_IF; break;
+    case RC_CONDITION_ADD_HITS:      op->logic = RC_CONDSET_LOGIC_ADD_HITS; break;
+    case RC_CONDITION_SUB_HITS:      op->logic = RC_CONDSET_LOGIC_SUB_HITS; break;
+    case RC_CONDITION_RESET_NEXT_IF: op->logic = RC_CONDSET_LOGIC_RESET_NEXT_IF; break;
+    case RC_CONDITION_AND_NEXT:      op->logic = RC_CONDSET_LOGIC_AND_NEXT; break;
+    case RC_CONDITION_OR_NEXT:       op->logic = RC_CONDSET_LOGIC_OR_NEXT; break;
+
+    case RC_CONDITION_ADD_SOURCE:
+    case RC_CONDITION_SUB_SOURCE:
+    case RC_CONDITION_ADD_ADDRESS:
+    case RC_CONDITION_REMEMBER:
+      /* these are handled by rc_modified_memref_t */
+      op->compare = RC_CONDSET_COMPARE_NONE;
+      op->logic = RC_CONDSET_LOGIC_INVALID;
+      return;
+
+    default:
+      /* the walker doesn't evaluate unknown conditions, it just fails the group */
+      op->compare = RC_CONDSET_COMPARE_ALWAYS_FALSE;
+      op->logic = RC_CONDSET_LOGIC_INVALID;
+      return;
+  }
+
+#ifndef RC_CONDSET_NO_FIELD_COMPARES
+  /* define RC_CONDSET_NO_FIELD_COMPARES to compare each field separately */
+  switch (rc_condset_get_field_compare(condition, &op->mask, &op->expected)) {
+    case RC_OPERATOR_EQ:
+      op->compare = RC_CONDSET_COMPARE_FIELD_EQ;
+      return;
+
+    case RC_OPERATOR_NE:
+      op->compare = RC_CONDSET_COMPARE_FIELD_NE;
+      return;
+
+    default:
+      break;
+  }
+#endif
+
+  switch (condition->optimized_comparator) {
+    case RC_PROCESSING_COMPARE_MEMREF_TO_CONST:
+      op->compare = (uint8_t)(RC_CONDSET_COMPARE_MEMREF_EQ_CONST + (condition->oper - RC_OPERATOR_EQ));
+      break;
+
+    case RC_PROCESSING_COMPARE_DELTA_TO_CONST:
+      op->compare = (uint8_t)(RC_CONDSET_COMPARE_DELTA_EQ_CONST + (condition->oper - RC_OPERATOR_EQ));
+      break;
+
+    case RC_PROCESSING_COMPARE_ALWAYS_TRUE:
+      op->compare = RC_CONDSET_COMPARE_ALWAYS_TRUE;
+      break;
+
+    case RC_PROCESSING_COMPARE_ALWAYS_FALSE:
+      op->compare = RC_CONDSET_COMPARE_ALWAYS_FALSE;
+      break;
+
+    default:
+      op->compare = RC_CONDSET_COMPARE_CONDITION;
+      break;
+  }
+}
+
+static int rc_condset_is_field_op(const rc_condset_op_t* op) {
+  return (op->compare == RC_CONDSET_COMPARE_FIELD_EQ || op->compare == RC_CONDSET_COMPARE_FIELD_NE);
+}
+
+/* a run of field compares on the same byte only loads it once. the first op of each run is changed
+ * to load the byte, and the rest mask the loaded value. rc_condset_execute can be started at the
+ * beginning of any segment, or of any chain in a selectively evaluated "other" segment, so a run
+ * can't continue past either */
+static void rc_condset_compile_field_runs(rc_condset_t* self, rc_condset_op_t* ops, uint32_t num_conditions) {
+  const rc_condset_with_trailing_conditions_t* condset_with_conditions = (const rc_condset_with_trailing_conditions_t*)self;
+  const rc_condition_t* conditions = condset_with_conditions->conditions;
+  const uint32_t reset_index = self->num_pause_conditions;
+  const uint32_t hittarget_index = reset_index + self->num_reset_conditions;
+  const uint32_t measured_index = hittarget_index + self->num_hittarget_conditions;
+  const uint32_t other_index = measured_index + self->num_measured_conditions;
+  const rc_condition_t* run_condition = NULL;
+  uint32_t i;
+
+  for (i = 0; i < num_conditions; ++i) {
+    if (i == reset_index || i == hittarget_index || i == measured_index || i == other_index)
+      run_condition = NULL;
+    else if (condset_with_conditions->is_selective && i > other_index && !rc_condition_is_combining(&conditions[i - 1]))
+      run_condition = NULL;
+
+    if (!rc_condset_is_field_op(&ops[i])) {
+      run_condition = NULL;
+      continue;
+    }
+
+    if (run_condition && run_condition->operand1.value.memref == conditions[i].operand1.value.memref &&
+        run_condition->operand1.type == conditions[i].operand1.type)
+      continue;
+
+    run_condition = &conditions[i];
+    ops[i].compare = (uint8_t)(ops[i].compare - RC_CONDSET_COMPARE_FIELD_EQ +
+        ((conditions[i].operand1.type == RC_OPERAND_DELTA) ? RC_CONDSET_COMPARE_DELTA_FIELD_EQ : RC_CONDSET_COMPARE_MEMREF_FIELD_EQ));
+  }
+}
+
+void rc_condset_compile(rc_condset_t* self, rc_parse_state_t* parse) {
+  rc_condset_with_trailing_conditions_t* condset_with_conditions = (rc_condset_with_trailing_conditions_t*)self;
+  const uint32_t num_conditions = rc_condset_count_conditions(self);
+  rc_condset_op_t* ops;
+  uint32_t i;
+
+  if (parse->buffer)
+    condset_with_conditions->ops = NULL;
+
+  ops = RC_ALLOC_ARRAY(rc_condset_op_t, num_conditions, parse);
+  if (!parse->buffer || parse->offset < 0)
+    return;
+
+  /* the conditions array is already grouped by segment, so the ops are too */
+  for (i = 0; i < num_conditions; ++i) {
+    ops[i].mask = ops[i].expected = 0;
+    rc_condset_compile_condition(&ops[i], &condset_with_conditions->conditions[i]);
+  }
+
+  rc_condset_compile_field_runs(self, ops, num_conditions);
+
+  condset_with_conditions->ops = ops;
+}
+
+#else
+
+void rc_condset_compile(rc_condset_t* self, rc_parse_state_t* parse) {
+  (void)self;
+  (void)parse;
+}
+
+#endif /* RC_CONDSET_NO_BYTECODE */
+
 static uint8_t rc_condset_evaluate_condition_no_add_hits(rc_condition_t* condition, rc_eval_state_t* eval_state) {
   /* evaluate the current condition */
   uint8_t cond_valid = (uint8_t)rc_test_condition(condition, eval_state);
@@ -662,6 +1237,429 @@ void rc_test_condset_internal(rc_condition_t* condition, uint32_t num_conditions
   }
 }
 
+/* ===== bytecode interpreter ===== */
+
+#ifndef RC_CONDSET_NO_BYTECODE
+
+/* the chain state that the walker keeps in rc_eval_state_t. the interpreter keeps it in locals
+ * and only writes it back when it leaves the segment */
+typedef struct rc_condset_registers_t {
+  int32_t add_hits;
+  uint8_t and_next;
+  uint8_t or_next;
+  uint8_t reset_next;
+  uint32_t field;                     /* the byte loaded for a run of field compares */
+} rc_condset_registers_t;
+
+/* matches rc_condset_evaluate_condition_no_add_hits */
+static uint8_t rc_condset_op_update_hits(rc_condition_t* condition, uint8_t cond_valid,
+                                         rc_condset_registers_t* regs, rc_eval_state_t* eval_state) {
+  condition->is_true = cond_valid;
+
+  if (regs->reset_next) {
+    eval_state->was_cond_reset |= (condition->current_hits != 0);
+
+    condition->current_hits = 0;
+    cond_valid = 0;
+  }
+  else {
+    cond_valid &= regs->and_next;
+    cond_valid |= regs->or_next;
+
+    if (cond_valid) {
+      eval_state->has_hits = 1;
+
+      if (condition->required_hits == 0) {
+        ++condition->current_hits;
+      }
+      else if (condition->current_hits < condition->required_hits) {
+        ++condition->current_hits;
+        cond_valid = (condition->current_hits == condition->required_hits);
+      }
+    }
+    else if (condition->current_hits > 0) {
+      eval_state->has_hits = 1;
+      cond_valid = (condition->current_hits == condition->required_hits);
+    }
+  }
+
+  regs->and_next = 1;
+  regs->or_next = 0;
+
+  return cond_valid;
+}
+
+/* matches rc_condset_evaluate_total_hits */
+static uint32_t rc_condset_op_total_hits(const rc_condition_t* condition, rc_condset_registers_t* regs) {
+  uint32_t total_hits = condition->current_hits;
+
+  if (condition->required_hits != 0) {
+    const int32_t signed_hits = (int32_t)condition->current_hits + regs->add_hits;
+    total_hits = (signed_hits >= 0) ? (uint32_t)signed_hits : 0;
+  }
+
+  regs->add_hits = 0;
+
+  return total_hits;
+}
+
+/* matches rc_condset_evaluate_condition */
+static uint8_t rc_condset_op_evaluate(rc_condition_t* condition, uint8_t cond_valid,
+                                      rc_condset_registers_t* regs, rc_eval_state_t* eval_state) {
+  cond_valid = rc_condset_op_update_hits(condition, cond_valid, regs, eval_state);
+
+  if (regs->add_hits != 0 && condition->required_hits != 0)
+    cond_valid = (rc_condset_op_total_hits(condition, regs) >= condition->required_hits);
+
+  regs->reset_next = 0;
+
+  return cond_valid;
+}
+
+/* labels as values (computed goto) let each handler jump straight to the next handler.
+ * it's an extension, so fall back to a switch when it's not available */
+#if !defined(RC_CONDSET_NO_THREADED_DISPATCH) && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+ #define RC_CONDSET_THREADED_DISPATCH 1
+#else
+ #define RC_CONDSET_THREADED_DISPATCH 0
+#endif
+
+#if RC_CONDSET_THREADED_DISPATCH
+ #define RC_CONDSET_COMPARE_OP(name) compare_ ## name
+ #define RC_CONDSET_LOGIC_OP(name) logic_ ## name
+ #define RC_CONDSET_DISPATCH_COMPARE() goto *compare_handlers[op->compare]
+ #define RC_CONDSET_DISPATCH_LOGIC() goto *logic_handlers[op->logic]
+
+ #if defined(__clang__)
+  #pragma clang diagnostic push
+  #pragma clang diagnostic ignored "-Wpedantic"
+  #pragma clang diagnostic ignored "-Wgnu-label-as-value"
+ #else
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wpedantic"
+ #endif
+#else
+ #define RC_CONDSET_COMPARE_OP(name) case RC_CONDSET_COMPARE_ ## name
+ #define RC_CONDSET_LOGIC_OP(name) case RC_CONDSET_LOGIC_ ## name
+ #define RC_CONDSET_DISPATCH_COMPARE() goto dispatch_compare
+ #define RC_CONDSET_DISPATCH_LOGIC() goto dispatch_logic
+#endif
+
+#define RC_CONDSET_MEMREF(condition) ((condition)->operand1.value.memref->value)
+#define RC_CONDSET_DELTA(condition) (RC_CONDSET_MEMREF(condition).changed ? RC_CONDSET_MEMREF(condition).prior : RC_CONDSET_MEMREF(condition).value)
+#define RC_CONDSET_CONST(condition) ((condition)->operand2.value.num)
+#define RC_CONDSET_FIELD(op, value) ((value) & (op)->mask)
+#define RC_CONDSET_NEXT() if (++op == op_end) goto done; ++condition; RC_CONDSET_DISPATCH_COMPARE()
+
+static void rc_condset_execute(const rc_condset_op_t* op, rc_condition_t* condition, uint32_t num_conditions,
+                               rc_eval_state_t* eval_state, int can_short_circuit) {
+#if RC_CONDSET_THREADED_DISPATCH
+  /* must be in the same order as RC_CONDSET_COMPARE_* */
+  static const void* const compare_handlers[] = {
+    &&compare_NONE,
+    &&compare_MEMREF_EQ_CONST, &&compare_MEMREF_LT_CONST, &&compare_MEMREF_LE_CONST,
+    &&compare_MEMREF_GT_CONST, &&compare_MEMREF_GE_CONST, &&compare_MEMREF_NE_CONST,
+    &&compare_DELTA_EQ_CONST, &&compare_DELTA_LT_CONST, &&compare_DELTA_LE_CONST,
+    &&compare_DELTA_GT_CONST, &&compare_DELTA_GE_CONST, &&compare_DELTA_NE_CONST,
+    &&compare_CONDITION, &&compare_ALWAYS_TRUE, &&compare_ALWAYS_FALSE,
+    &&compare_FIELD_EQ, &&compare_FIELD_NE,
+    &&compare_MEMREF_FIELD_EQ, &&compare_MEMREF_FIELD_NE,
+    &&compare_DELTA_FIELD_EQ, &&compare_DELTA_FIELD_NE
+  };
+
+  /* must be in the same order as RC_CONDSET_LOGIC_* */
+  static const void* const logic_handlers[] = {
+    &&logic_STANDARD, &&logic_PAUSE_IF, &&logic_RESET_IF, &&logic_TRIGGER,
+    &&logic_MEASURED, &&logic_MEASURED_IF, &&logic_ADD_HITS, &&logic_SUB_HITS,
+    &&logic_RESET_NEXT_IF, &&logic_AND_NEXT, &&logic_OR_NEXT, &&logic_INVALID
+  };
+#endif
+
+  const rc_condset_op_t* op_end = op + num_conditions;
+  rc_condset_registers_t regs;
+  uint8_t cond_valid = 0;
+
+  if (num_conditions == 0)
+    return;
+
+  regs.add_hits = eval_state->add_hits;
+  regs.and_next = eval_state->and_next;
+  regs.or_next = eval_state->or_next;
+  regs.reset_next = eval_state->reset_next;
+  regs.field = 0;
+
+  RC_CONDSET_DISPATCH_COMPARE();
+
+  /* load and compare */
+#if !RC_CONDSET_THREADED_DISPATCH
+dispatch_compare:
+  switch (op->compare) {
+#endif
+    RC_CONDSET_COMPARE_OP(MEMREF_EQ_CONST): cond_valid = (RC_CONDSET_MEMREF(condition).value == RC_CONDSET_CONST(condition)); RC_CONDSET_DISPATCH_LOGIC();
+    RC_CONDSET_COMPARE_OP(MEMREF_LT_CONST): cond_valid = (RC_CONDSET_MEMREF(condition).value < RC_CONDSET_CONST(condition));  RC_CONDSET_DISPATCH_LOGIC();
+    RC_CONDSET_COMPARE_OP(MEMREF_LE_CONST): cond_valid = (RC_CONDSET_MEMREF(condition).value <= RC_CONDSET_CONST(condition)); RC_CONDSET_DISPATCH_LOGIC();
+    RC_CONDSET_COMPARE_OP(MEMREF_GT_CONST): cond_valid = (RC_CONDSET_MEMREF(condition).value > RC_CONDSET_CONST(condition));  RC_CONDSET_DISPATCH_LOGIC();
+    RC_CONDSET_COMPARE_OP(MEMREF_GE_CONST): cond_valid = (RC_CONDSET_MEMREF(condition).value >= RC_CONDSET_CONST(condition)); RC_CONDSET_DISPATCH_LOGIC();
+    RC_CONDSET_COMPARE_OP(MEMREF_NE_CONST): cond_valid = (RC_CONDSET_MEMREF(condition).value != RC_CONDSET_CONST(condition)); RC_CONDSET_DISPATCH_LOGIC();
+
+    RC_CONDSET_COMPARE_OP(DELTA_EQ_CONST): cond_valid = (RC_CONDSET_DELTA(condition) == RC_CONDSET_CONST(condition)); RC_CONDSET_DISPATCH_LOGIC();
+    RC_CONDSET_COMPARE_OP(DELTA_LT_CONST): cond_valid = (RC_CONDSET_DELTA(condition) < RC_CONDSET_CONST(condition));  RC_CONDSET_DISPATCH_LOGIC();
+    RC_CONDSET_COMPARE_OP(DELTA_LE_CONST): cond_valid = (RC_CONDSET_DELTA(condition) <= RC_CONDSET_CONST(condition)); RC_CONDSET_DISPATCH_LOGIC();
+    RC_CONDSET_COMPARE_OP(DELTA_GT_CONST): cond_valid = (RC_CONDSET_DELTA(condition) > RC_CONDSET_CONST(condition));  RC_CONDSET_DISPATCH_LOGIC();
+    RC_CONDSET_COMPARE_OP(DELTA_GE_CONST): cond_valid = (RC_CONDSET_DELTA(condition) >= RC_CONDSET_CONST(condition)); RC_CONDSET_DISPATCH_LOGIC();
+    RC_CONDSET_COMPARE_OP(DELTA_NE_CONST): cond_valid = (RC_CONDSET_DELTA(condition) != RC_CONDSET_CONST(condition)); RC_CONDSET_DISPATCH_LOGIC();
+
+    RC_CONDSET_COMPARE_OP(CONDITION):
+      cond_valid = (uint8_t)rc_test_condition(condition, eval_state);
+      RC_CONDSET_DISPATCH_LOGIC();
+
+    RC_CONDSET_COMPARE_OP(ALWAYS_TRUE):  cond_valid = 1; RC_CONDSET_DISPATCH_LOGIC();
+    RC_CONDSET_COMPARE_OP(ALWAYS_FALSE): cond_valid = 0; RC_CONDSET_DISPATCH_LOGIC();
+
+    RC_CONDSET_COMPARE_OP(MEMREF_FIELD_EQ): regs.field = RC_CONDSET_MEMREF(condition).value; cond_valid = (RC_CONDSET_FIELD(op, regs.field) == op->expected); RC_CONDSET_DISPATCH_LOGIC();
+    RC_CONDSET_COMPARE_OP(MEMREF_FIELD_NE): regs.field = RC_CONDSET_MEMREF(condition).value; cond_valid = (RC_CONDSET_FIELD(op, regs.field) != op->expected); RC_CONDSET_DISPATCH_LOGIC();
+    RC_CONDSET_COMPARE_OP(DELTA_FIELD_EQ):  regs.field = RC_CONDSET_DELTA(condition);        cond_valid = (RC_CONDSET_FIELD(op, regs.field) == op->expected); RC_CONDSET_DISPATCH_LOGIC();
+    RC_CONDSET_COMPARE_OP(DELTA_FIELD_NE):  regs.field = RC_CONDSET_DELTA(condition);        cond_valid = (RC_CONDSET_FIELD(op, regs.field) != op->expected); RC_CONDSET_DISPATCH_LOGIC();
+    RC_CONDSET_COMPARE_OP(FIELD_EQ):        cond_valid = (RC_CONDSET_FIELD(op, regs.field) == op->expected); RC_CONDSET_DISPATCH_LOGIC();
+    RC_CONDSET_COMPARE_OP(FIELD_NE):        cond_valid = (RC_CONDSET_FIELD(op, regs.field) != op->expected); RC_CONDSET_DISPATCH_LOGIC();
+
+    RC_CONDSET_COMPARE_OP(NONE):
+      RC_CONDSET_NEXT();
+#if !RC_CONDSET_THREADED_DISPATCH
+  }
+#endif
+
+  /* update hit counts and apply the condition to the group */
+#if !RC_CONDSET_THREADED_DISPATCH
+dispatch_logic:
+  switch (op->logic) {
+#endif
+    RC_CONDSET_LOGIC_OP(STANDARD):
+      cond_valid = rc_condset_op_evaluate(condition, cond_valid, &regs, eval_state);
+      eval_state->is_true &= cond_valid;
+      eval_state->is_primed &= cond_valid;
+
+      if (!cond_valid && eval_state->can_short_curcuit) {
+        eval_state->stop_processing = 1;
+        if (can_short_circuit)
+          goto done;
+      }
+      RC_CONDSET_NEXT();
+
+    RC_CONDSET_LOGIC_OP(PAUSE_IF):
+      if (rc_condset_op_evaluate(condition, cond_valid, &regs, eval_state)) {
+        eval_state->is_paused = 1;
+        eval_state->is_true = eval_state->is_primed = 0;
+        eval_state->stop_processing = 1;
+        if (can_short_circuit)
+          goto done;
+      }
+      else if (condition->required_hits == 0) {
+        condition->current_hits = 0;
+      }
+      RC_CONDSET_NEXT();
+
+    RC_CONDSET_LOGIC_OP(RESET_IF):
+      if (rc_condset_op_evaluate(condition, cond_valid, &regs, eval_state)) {
+        condition->is_true |= 0x02;
+        eval_state->is_true = eval_state->is_primed = 0;
+        eval_state->was_reset = 1;
+        eval_state->stop_processing = 1;
+        if (can_short_circuit)
+          goto done;
+      }
+      RC_CONDSET_NEXT();
+
+    RC_CONDSET_LOGIC_OP(TRIGGER):
+      eval_state->is_true &= rc_condset_op_evaluate(condition, cond_valid, &regs, eval_state);
+      RC_CONDSET_NEXT();
+
+    RC_CONDSET_LOGIC_OP(MEASURED):
+      if (condition->required_hits == 0) {
+        cond_valid = rc_condset_op_evaluate(condition, cond_valid, &regs, eval_state);
+        eval_state->is_true &= cond_valid;
+        eval_state->is_primed &= cond_valid;
+        if (!cond_valid && eval_state->can_short_curcuit)
+          eval_state->stop_processing = 1;
+
+        rc_evaluate_operand(&eval_state->measured_value, &condition->operand1, eval_state);
+        eval_state->measured_from_hits = 0;
+      }
+      else {
+        uint32_t total_hits;
+        rc_condset_op_update_hits(condition, cond_valid, &regs, eval_state);
+        total_hits = rc_condset_op_total_hits(condition, &regs);
+
+        cond_valid = (total_hits >= condition->required_hits);
+        eval_state->is_true &= cond_valid;
+        eval_state->is_primed &= cond_valid;
+
+        eval_state->measured_value.value.u32 = total_hits;
+        eval_state->measured_value.type = RC_VALUE_TYPE_UNSIGNED;
+        eval_state->measured_from_hits = 1;
+
+        regs.reset_next = 0;
+      }
+
+      if (eval_state->stop_processing && can_short_circuit)
+        goto done;
+      RC_CONDSET_NEXT();
+
+    RC_CONDSET_LOGIC_OP(MEASURED_IF):
+      cond_valid = rc_condset_op_evaluate(condition, cond_valid, &regs, eval_state);
+      eval_state->is_true &= cond_valid;
+      eval_state->is_primed &= cond_valid;
+      eval_state->can_measure &= cond_valid;
+      RC_CONDSET_NEXT();
+
+    RC_CONDSET_LOGIC_OP(ADD_HITS):
+      rc_condset_op_update_hits(condition, cond_valid, &regs, eval_state);
+      regs.add_hits += (int32_t)condition->current_hits;
+      regs.reset_next = 0;
+      RC_CONDSET_NEXT();
+
+    RC_CONDSET_LOGIC_OP(SUB_HITS):
+      rc_condset_op_update_hits(condition, cond_valid, &regs, eval_state);
+      regs.add_hits -= (int32_t)condition->current_hits;
+      regs.reset_next = 0;
+      RC_CONDSET_NEXT();
+
+    /* chain links only set the register that the next op consumes */
+    RC_CONDSET_LOGIC_OP(RESET_NEXT_IF):
+      regs.reset_next = rc_condset_op_update_hits(condition, cond_valid, &regs, eval_state);
+      RC_CONDSET_NEXT();
+
+    RC_CONDSET_LOGIC_OP(AND_NEXT):
+      regs.and_next = rc_condset_op_update_hits(condition, cond_valid, &regs, eval_state);
+      RC_CONDSET_NEXT();
+
+    RC_CONDSET_LOGIC_OP(OR_NEXT):
+      regs.or_next = rc_condset_op_update_hits(condition, cond_valid, &regs, eval_state);
+      RC_CONDSET_NEXT();
+
+    RC_CONDSET_LOGIC_OP(INVALID):
+      eval_state->stop_processing = 1;
+      eval_state->is_true = eval_state->is_primed = 0;
+      if (can_short_circuit)
+        goto done;
+      RC_CONDSET_NEXT();
+#if !RC_CONDSET_THREADED_DISPATCH
+  }
+#endif
+
+done:
+  eval_state->add_hits = regs.add_hits;
+  eval_state->and_next = regs.and_next;
+  eval_state->or_next = regs.or_next;
+  eval_state->reset_next = regs.reset_next;
+}
+
+#if RC_CONDSET_THREADED_DISPATCH
+ #if defined(__clang__)
+  #pragma clang diagnostic pop
+ #else
+  #pragma GCC diagnostic pop
+ #endif
+#endif
+
+#endif /* RC_CONDSET_NO_BYTECODE */
+
+static void rc_test_condset_segment(rc_condset_t* self, rc_condition_t* conditions, uint32_t num_conditions,
+                                    rc_eval_state_t* eval_state, int can_short_circuit, rc_condset_native_func_t native) {
+#ifndef RC_CONDSET_NO_BYTECODE
+  const rc_condset_with_trailing_conditions_t* condset_with_conditions = (const rc_condset_with_trailing_conditions_t*)self;
+#else
+  (void)self;
+#endif
+
+  /* native code is generated for the only short circuit that can happen when can_short_curcuit
+   * isn't set - a true PauseIf stopping the pause segment. it also assumes no chain is carried
+   * into the segment, which is always the case for condsets produced by the parser */
+  if (native && !eval_state->can_short_curcuit && eval_state->and_next && !eval_state->or_next &&
+      !eval_state->reset_next && !eval_state->add_hits) {
+    native(eval_state, conditions);
+    return;
+  }
+
+#ifndef RC_CONDSET_NO_BYTECODE
+  /* the walker evaluates one condition before it notices a pending stop. that can't happen for
+   * any condset the parser produces, but defer to the walker in case it does */
+  if (condset_with_conditions->ops && !(eval_state->stop_processing && can_short_circuit)) {
+    const uint32_t index = (uint32_t)(conditions - &condset_with_conditions->conditions[0]);
+    rc_condset_execute(&condset_with_conditions->ops[index], conditions, num_conditions, eval_state, can_short_circuit);
+    return;
+  }
+#endif
+
+  rc_test_condset_internal(conditions, num_conditions, eval_state, can_short_circuit);
+}
+
+/* how many times the "other" segment is short circuited before its independent conditions are reordered */
+#define RC_CONDSET_REORDER_INTERVAL 32
+
+static int rc_condset_selectivity_precedes(const rc_condset_selectivity_entry_t* first,
+                                           const rc_condset_selectivity_entry_t* second) {
+  /* compare (false / evaluations / cost) without dividing. an entry that hasn't been evaluated
+   * is assumed to be false half of the time */
+  const uint32_t first_score = (uint32_t)(first->num_false + 1) * (second->num_evaluations + 2) * second->cost;
+  const uint32_t second_score = (uint32_t)(second->num_false + 1) * (first->num_evaluations + 2) * first->cost;
+
+  return first_score > second_score;
+}
+
+static void rc_condset_reorder(rc_condset_selectivity_t* selectivity) {
+  rc_condset_selectivity_entry_t* entries = selectivity->entries;
+  rc_condset_selectivity_entry_t entry;
+  uint32_t i, j;
+
+  /* insertion sort within each run of independent entries. the runs are short, and the sort is
+   * stable, so entries that are equally selective keep their current order */
+  for (i = 1; i < selectivity->num_entries; ++i) {
+    if (!entries[i].is_independent)
+      continue;
+
+    memcpy(&entry, &entries[i], sizeof(entry));
+    for (j = i; j > 0 && entries[j - 1].is_independent && rc_condset_selectivity_precedes(&entry, &entries[j - 1]); --j)
+      memcpy(&entries[j], &entries[j - 1], sizeof(entry));
+
+    if (j != i)
+      memcpy(&entries[j], &entry, sizeof(entry));
+  }
+
+  /* decay the counters so the order adapts when the game moves on */
+  for (i = 0; i < selectivity->num_entries; ++i) {
+    entries[i].num_evaluations >>= 1;
+    entries[i].num_false >>= 1;
+  }
+
+  selectivity->num_evaluations = 0;
+}
+
+static void rc_condset_test_selective(rc_condset_t* self, rc_condition_t* conditions, rc_eval_state_t* eval_state) {
+  rc_condset_selectivity_t* selectivity = rc_condset_get_selectivity(self);
+  rc_condset_selectivity_entry_t* entry = selectivity->entries;
+  rc_condset_selectivity_entry_t* stop = entry + selectivity->num_entries;
+
+  /* every entry is a complete chain, so the chain state never has to be carried between them */
+  for (; entry < stop; ++entry) {
+    rc_test_condset_segment(self, &conditions[entry->index], entry->num_conditions, eval_state, 1, NULL);
+    ++entry->num_evaluations;
+
+    if (eval_state->stop_processing) {
+      ++entry->num_false;
+      break;
+    }
+  }
+
+  if (++selectivity->num_evaluations == RC_CONDSET_REORDER_INTERVAL)
+    rc_condset_reorder(selectivity);
+}
+
+uint32_t rc_condset_count_conditions(const rc_condset_t* self) {
+  return self->num_pause_conditions + self->num_reset_conditions + self->num_hittarget_conditions +
+      self->num_measured_conditions + self->num_other_conditions;
+}
+
 rc_condition_t* rc_condset_get_conditions(rc_condset_t* self) {
   if (self->conditions)
     return RC_GET_TRAILING(self, rc_condset_with_trailing_conditions_t, rc_condition_t, conditions);
@@ -670,6 +1668,11 @@ rc_condition_t* rc_condset_get_conditions(rc_condset_t* self) {
 }
 
 int rc_test_condset(rc_condset_t* self, rc_eval_state_t* eval_state) {
+  return rc_test_condset_native(self, eval_state, NULL);
+}
+
+static int rc_test_condset_groups(rc_condset_t* self, rc_eval_state_t* eval_state, const rc_condset_native_t* native,
+                                  uint8_t* has_reset_hits) {
   rc_condition_t* conditions;
 
   /* reset the processing state before processing each condset. do not reset the result state. */
@@ -687,11 +1690,13 @@ int rc_test_condset(rc_condset_t* self, rc_eval_state_t* eval_state) {
 
   /* the conditions array is allocated immediately after the rc_condset_t, without a separate pointer */
   conditions = rc_condset_get_conditions(self);
+  eval_state->conditions = conditions;
 
   if (self->num_pause_conditions) {
     /* one or more Pause conditions exist. if any of them are true (eval_state->is_paused),
      * stop processing this group */
-    rc_test_condset_internal(conditions, self->num_pause_conditions, eval_state, 1);
+    rc_test_condset_segment(self, conditions, self->num_pause_conditions, eval_state, 1,
+                            native ? native->pause : NULL);
 
     self->is_paused = eval_state->is_paused;
     if (self->is_paused) {
@@ -703,17 +1708,27 @@ int rc_test_condset(rc_condset_t* self, rc_eval_state_t* eval_state) {
   }
 
   if (self->num_reset_conditions) {
+    const uint8_t has_hits = eval_state->has_hits;
+
     /* one or more Reset conditions exists. if any of them are true (eval_state->was_reset),
      * we'll skip some of the later steps */
-    rc_test_condset_internal(conditions, self->num_reset_conditions, eval_state, eval_state->can_short_curcuit);
+    eval_state->has_hits = 0;
+    rc_test_condset_segment(self, conditions, self->num_reset_conditions, eval_state, eval_state->can_short_curcuit,
+                            native ? native->reset : NULL);
     conditions += self->num_reset_conditions;
+
+    /* a true ResetIf tallies a hit on itself. those are always cleared by rc_reset_condset_evaluated,
+     * so they're tracked separately to keep them from forcing a walk over the whole condset */
+    *has_reset_hits = eval_state->has_hits;
+    eval_state->has_hits = has_hits;
   }
 
   if (self->num_hittarget_conditions) {
     /* one or more hit target conditions exists. these must be processed every frame,
      * unless their hit count is going to be reset */
     if (!eval_state->was_reset)
-      rc_test_condset_internal(conditions, self->num_hittarget_conditions, eval_state, 0);
+      rc_test_condset_segment(self, conditions, self->num_hittarget_conditions, eval_state, 0,
+                              native ? native->hittarget : NULL);
 
     conditions += self->num_hittarget_conditions;
   }
@@ -731,7 +1746,8 @@ int rc_test_condset(rc_condset_t* self, rc_eval_state_t* eval_state) {
     }
 
     /* the measured value must be calculated every frame, even if hit counts will be reset */
-    rc_test_condset_internal(conditions, self->num_measured_conditions, eval_state, 0);
+    rc_test_condset_segment(self, conditions, self->num_measured_conditions, eval_state, 0,
+                            native ? native->measured : NULL);
     conditions += self->num_measured_conditions;
 
     if (eval_state->measured_value.type != RC_VALUE_TYPE_NONE) {
@@ -747,20 +1763,68 @@ int rc_test_condset(rc_condset_t* self, rc_eval_state_t* eval_state) {
 
   if (self->num_other_conditions) {
     /* the remaining conditions only need to be evaluated if the rest of the condset is true */
-    if (eval_state->is_true)
-      rc_test_condset_internal(conditions, self->num_other_conditions, eval_state, eval_state->can_short_curcuit);
+    if (eval_state->is_true) {
+      if (eval_state->can_short_curcuit && ((rc_condset_with_trailing_conditions_t*)self)->is_selective)
+        rc_condset_test_selective(self, conditions, eval_state);
+      else
+        rc_test_condset_segment(self, conditions, self->num_other_conditions, eval_state, eval_state->can_short_curcuit,
+                                native ? native->other : NULL);
+    }
     /* something else is false. if we can't short circuit, and there wasn't a reset, we still need to evaluate these */
     else if (!eval_state->can_short_curcuit && !eval_state->was_reset)
-      rc_test_condset_internal(conditions, self->num_other_conditions, eval_state, eval_state->can_short_curcuit);
+      rc_test_condset_segment(self, conditions, self->num_other_conditions, eval_state, eval_state->can_short_curcuit,
+                              native ? native->other : NULL);
   }
 
   return eval_state->is_true;
 }
 
+int rc_test_condset_native(rc_condset_t* self, rc_eval_state_t* eval_state, const rc_condset_native_t* native) {
+  const uint8_t had_hits = eval_state->has_hits;
+  uint8_t has_reset_hits = 0;
+  int result;
+
+  /* every condition with a hit count sets has_hits when it's evaluated. conditions that aren't
+   * evaluated keep their counts, so the flag is only cleared when the condset is reset */
+  eval_state->has_hits = 0;
+  result = rc_test_condset_groups(self, eval_state, native, &has_reset_hits);
+  if (self->conditions) /* an empty condset doesn't have the trailing data */
+    ((rc_condset_with_trailing_conditions_t*)self)->has_hits |= eval_state->has_hits;
+  eval_state->has_hits |= had_hits | has_reset_hits;
+
+  return result;
+}
+
 void rc_reset_condset(rc_condset_t* self) {
   rc_condition_t* condition;
 
   for (condition = self->conditions; condition != 0; condition = condition->next) {
     condition->current_hits = 0;
   }
+
+  if (self->conditions)
+    ((rc_condset_with_trailing_conditions_t*)self)->has_hits = 0;
+}
+
+void rc_reset_condset_evaluated(rc_condset_t* self) {
+  rc_condition_t* condition;
+  rc_condition_t* stop;
+
+  if (!self->conditions)
+    return;
+
+  if (((rc_condset_with_trailing_conditions_t*)self)->has_hits) {
+    rc_reset_condset(self);
+    return;
+  }
+
+  /* nothing outside of the ResetIfs has a hit count. a ResetIf that stays true would
+   * otherwise clear every condition every frame */
+  condition = rc_condset_get_conditions(self);
+  if (!condition)
+    return;
+
+  condition += self->num_pause_conditions;
+  for (stop = condition + self->num_reset_conditions; condition < stop; ++condition)
+    condition->current_hits = 0;
 }
@@ -5,42 +5,342 @@
 #include <math.h>   /* INFINITY/NAN */
 
 #define MEMREF_PLACEHOLDER_ADDRESS 0xFFFFFFFF
+#define RC_MEMREF_INDEX_THRESHOLD 16
 
-rc_memref_t* rc_alloc_memref(rc_parse_state_t* parse, uint32_t address, uint8_t size) {
-  rc_memref_list_t* memref_list = NULL;
-  rc_memref_t* memref = NULL;
-  int i;
+static uint32_t rc_memref_hash(uint32_t address, uint8_t size) {
+  uint32_t hash = (address ^ ((uint32_t)size << 24)) * 0x9E3779B1;
+  return hash ^ (hash >> 15);
+}
 
-  for (i = 0; i < 2; i++) {
-    if (i == 0) {
-      if (!parse->existing_memrefs)
-        continue;
+static uint32_t rc_modified_memref_hash(uint8_t modifier_type, const rc_operand_t* parent, const rc_operand_t* modifier);
+static uint32_t rc_memref_read_size(uint8_t size);
+struct rc_memrefs_schedule_t;
+static void rc_memrefs_free_indirect_groups(struct rc_memrefs_schedule_t* schedule);
+
+/* must generate the same hash for any two operands where rc_operands_are_equal is true */
+static uint32_t rc_operand_hash(const rc_operand_t* operand) {
+  uint32_t hash = operand->type;
+  const rc_memref_t* memref;
+
+  switch (operand->type) {
+    case RC_OPERAND_CONST:
+      return (hash ^ operand->value.num) * 0x9E3779B1;
+    case RC_OPERAND_FP:
+    case RC_OPERAND_RECALL:
+      return hash;
+    default:
+      break;
+  }
+
+  memref = operand->value.memref;
+  hash = hash * 31 + operand->size;
+  hash = hash * 31 + memref->value.memref_type;
+
+  if (memref->value.memref_type == RC_MEMREF_TYPE_MODIFIED_MEMREF) {
+    const rc_modified_memref_t* modified_memref = (const rc_modified_memref_t*)memref;
+    return hash * 31 + rc_modified_memref_hash(modified_memref->modifier_type, &modified_memref->parent, &modified_memref->modifier);
+  }
+
+  return hash * 31 + rc_memref_hash(memref->address, memref->value.size);
+}
+
+static uint32_t rc_modified_memref_hash(uint8_t modifier_type, const rc_operand_t* parent, const rc_operand_t* modifier) {
+  uint32_t hash = modifier_type;
+  hash = hash * 31 + rc_operand_hash(parent);
+  hash = hash * 31 + rc_operand_hash(modifier);
+  return hash ^ (hash >> 15);
+}
 
-      memref_list = &parse->existing_memrefs->memrefs;
+static int rc_memref_index_add_memref(rc_memref_index_t* index, rc_memref_t* memref, uint32_t hash) {
+  uint32_t slot;
+
+  if ((index->memrefs_count + 1) * 4 > index->memrefs_capacity * 3) {
+    const uint32_t old_capacity = index->memrefs_capacity;
+    rc_memref_t** old_memrefs = index->memrefs;
+    uint32_t i;
+
+    index->memrefs_capacity = old_capacity ? old_capacity * 2 : 32;
+    index->memrefs = (rc_memref_t**)calloc(index->memrefs_capacity, sizeof(rc_memref_t*));
+    if (!index->memrefs) {
+      index->memrefs = old_memrefs;
+      index->memrefs_capacity = old_capacity;
+      return 0;
     }
-    else {
-      memref_list = &parse->memrefs->memrefs;
+
+    for (i = 0; i < old_capacity; ++i) {
+      if (old_memrefs[i]) {
+        slot = rc_memref_hash(old_memrefs[i]->address, old_memrefs[i]->value.size) & (index->memrefs_capacity - 1);
+        while (index->memrefs[slot])
+          slot = (slot + 1) & (index->memrefs_capacity - 1);
+        index->memrefs[slot] = old_memrefs[i];
+      }
     }
 
-    do
-    {
-      const rc_memref_t* memref_stop;
+    free(old_memrefs);
+  }
 
-      memref = memref_list->items;
-      memref_stop = memref + memref_list->count;
+  slot = hash & (index->memrefs_capacity - 1);
+  while (index->memrefs[slot])
+    slot = (slot + 1) & (index->memrefs_capacity - 1);
 
-      for (; memref < memref_stop; ++memref) {
-        if (memref->address == address && memref->value.size == size)
-          return memref;
+  index->memrefs[slot] = memref;
+  index->memrefs_count++;
+  return 1;
+}
+
+static int rc_memref_index_add_modified_memref(rc_memref_index_t* index, rc_modified_memref_t* modified_memref, uint32_t hash) {
+  uint32_t slot;
+
+  if ((index->modified_memrefs_count + 1) * 4 > index->modified_memrefs_capacity * 3) {
+    const uint32_t old_capacity = index->modified_memrefs_capacity;
+    rc_modified_memref_t** old_modified_memrefs = index->modified_memrefs;
+    uint32_t i;
+
+    index->modified_memrefs_capacity = old_capacity ? old_capacity * 2 : 16;
+    index->modified_memrefs = (rc_modified_memref_t**)calloc(index->modified_memrefs_capacity, sizeof(rc_modified_memref_t*));
+    if (!index->modified_memrefs) {
+      index->modified_memrefs = old_modified_memrefs;
+      index->modified_memrefs_capacity = old_capacity;
+      return 0;
+    }
+
+    for (i = 0; i < old_capacity; ++i) {
+      const rc_modified_memref_t* old_modified_memref = old_modified_memrefs[i];
+      if (old_modified_memref) {
+        slot = rc_modified_memref_hash(old_modified_memref->modifier_type, &old_modified_memref->parent, &old_modified_memref->modifier);
+        slot = (slot ^ old_modified_memref->memref.value.size) & (index->modified_memrefs_capacity - 1);
+        while (index->modified_memrefs[slot])
+          slot = (slot + 1) & (index->modified_memrefs_capacity - 1);
+        index->modified_memrefs[slot] = old_modified_memrefs[i];
       }
+    }
 
-      if (!memref_list->next)
-        break;
+    free(old_modified_memrefs);
+  }
 
-      memref_list = memref_list->next;
-    } while (1);
+  slot = hash & (index->modified_memrefs_capacity - 1);
+  while (index->modified_memrefs[slot])
+    slot = (slot + 1) & (index->modified_memrefs_capacity - 1);
+
+  index->modified_memrefs[slot] = modified_memref;
+  index->modified_memrefs_count++;
+  return 1;
+}
+
+static rc_memref_t* rc_memref_index_find_memref(const rc_memref_index_t* index, uint32_t hash, uint32_t address, uint8_t size) {
+  uint32_t slot;
+
+  if (!index->memrefs_capacity)
+    return NULL;
+
+  slot = hash & (index->memrefs_capacity - 1);
+  while (index->memrefs[slot]) {
+    rc_memref_t* memref = index->memrefs[slot];
+    if (memref->address == address && memref->value.size == size)
+      return memref;
+
+    slot = (slot + 1) & (index->memrefs_capacity - 1);
+  }
+
+  return NULL;
+}
+
+static rc_modified_memref_t* rc_memref_index_find_modified_memref(const rc_memref_index_t* index, uint32_t hash, uint8_t size,
+    const rc_operand_t* parent, uint8_t modifier_type, const rc_operand_t* modifier) {
+  uint32_t slot;
+
+  if (!index->modified_memrefs_capacity)
+    return NULL;
+
+  slot = hash & (index->modified_memrefs_capacity - 1);
+  while (index->modified_memrefs[slot]) {
+    rc_modified_memref_t* modified_memref = index->modified_memrefs[slot];
+    if (modified_memref->memref.value.size == size &&
+        modified_memref->modifier_type == modifier_type &&
+        rc_operands_are_equal(&modified_memref->parent, parent) &&
+        rc_operands_are_equal(&modified_memref->modifier, modifier)) {
+      return modified_memref;
+    }
+
+    slot = (slot + 1) & (index->modified_memrefs_capacity - 1);
+  }
+
+  return NULL;
+}
+
+static void rc_memref_index_reset(rc_memref_index_t* index) {
+  if (index->memrefs)
+    memset(index->memrefs, 0, index->memrefs_capacity * sizeof(rc_memref_t*));
+  if (index->modified_memrefs)
+    memset(index->modified_memrefs, 0, index->modified_memrefs_capacity * sizeof(rc_modified_memref_t*));
+
+  index->memrefs_count = 0;
+  index->modified_memrefs_count = 0;
+  index->source = NULL;
+}
+
+static int rc_memref_index_sync(rc_memref_index_t* index, const rc_memrefs_t* memrefs) {
+  const rc_memref_list_t* memref_list;
+  const rc_modified_memref_list_t* modified_memref_list;
+  uint32_t i;
+
+  if (index->source != memrefs ||
+      index->memrefs_tail->count < index->memrefs_tail_count ||
+      index->modified_memrefs_tail->count < index->modified_memrefs_tail_count) {
+    rc_memref_index_reset(index);
+    index->source = memrefs;
+    index->memrefs_tail = &memrefs->memrefs;
+    index->memrefs_tail_count = 0;
+    index->modified_memrefs_tail = &memrefs->modified_memrefs;
+    index->modified_memrefs_tail_count = 0;
+  }
+
+  /* index anything that was added since the last sync */
+  memref_list = index->memrefs_tail;
+  i = index->memrefs_tail_count;
+  do {
+    for (; i < memref_list->count; ++i) {
+      rc_memref_t* memref = &memref_list->items[i];
+      if (!rc_memref_index_add_memref(index, memref, rc_memref_hash(memref->address, memref->value.size))) {
+        rc_memref_index_reset(index);
+        return 0;
+      }
+    }
+
+    /* new items are always placed in the first chunk that isn't full */
+    if (memref_list->count < memref_list->capacity || !memref_list->next)
+      break;
+
+    memref_list = memref_list->next;
+    i = 0;
+  } while (1);
+
+  index->memrefs_tail = memref_list;
+  index->memrefs_tail_count = memref_list->count;
+
+  modified_memref_list = index->modified_memrefs_tail;
+  i = index->modified_memrefs_tail_count;
+  do {
+    for (; i < modified_memref_list->count; ++i) {
+      rc_modified_memref_t* modified_memref = &modified_memref_list->items[i];
+      const uint32_t hash = rc_modified_memref_hash(modified_memref->modifier_type, &modified_memref->parent, &modified_memref->modifier);
+      if (!rc_memref_index_add_modified_memref(index, modified_memref, hash ^ modified_memref->memref.value.size)) {
+        rc_memref_index_reset(index);
+        return 0;
+      }
+    }
+
+    if (modified_memref_list->count < modified_memref_list->capacity || !modified_memref_list->next)
+      break;
+
+    modified_memref_list = modified_memref_list->next;
+    i = 0;
+  } while (1);
+
+  index->modified_memrefs_tail = modified_memref_list;
+  index->modified_memrefs_tail_count = modified_memref_list->count;
+
+  return 1;
+}
+
+void rc_memref_index_destroy(rc_memref_index_t* index) {
+  if (index) {
+    free(index->memrefs);
+    free(index->modified_memrefs);
+    free(index);
+  }
+}
+
+/* returns an up-to-date index for memrefs, or NULL if one is not available. pools have a
+ * persistent index. the list being populated by the parse (parse->memrefs) uses a temporary
+ * index owned by the parse state. anything else has to be scanned. */
+static rc_memref_index_t* rc_parse_memref_index(rc_parse_state_t* parse, const rc_memrefs_t* memrefs) {
+  rc_memref_index_t* index = memrefs->index;
+
+  if (!index) {
+    if (memrefs != parse->memrefs)
+      return NULL;
+
+    if (!parse->memref_index) {
+      /* small lists are faster to scan than to index */
+      if (memrefs->memrefs.count < RC_MEMREF_INDEX_THRESHOLD && !memrefs->memrefs.next &&
+          memrefs->modified_memrefs.count < RC_MEMREF_INDEX_THRESHOLD && !memrefs->modified_memrefs.next)
+        return NULL;
+
+      parse->memref_index = (rc_memref_index_t*)calloc(1, sizeof(rc_memref_index_t));
+      if (!parse->memref_index)
+        return NULL;
+    }
+
+    index = parse->memref_index;
+  }
+
+  return rc_memref_index_sync(index, memrefs) ? index : NULL;
+}
+
+static rc_memref_t* rc_find_memref(rc_memref_list_t* memref_list, uint32_t address, uint8_t size) {
+  do {
+    rc_memref_t* memref = memref_list->items;
+    const rc_memref_t* memref_stop = memref + memref_list->count;
+
+    for (; memref < memref_stop; ++memref) {
+      if (memref->address == address && memref->value.size == size)
+        return memref;
+    }
+
+    memref_list = memref_list->next;
+  } while (memref_list);
+
+  return NULL;
+}
+
+static rc_modified_memref_t* rc_find_modified_memref(rc_modified_memref_list_t* modified_memref_list, uint8_t size,
+    const rc_operand_t* parent, uint8_t modifier_type, const rc_operand_t* modifier) {
+  do {
+    rc_modified_memref_t* modified_memref = modified_memref_list->items;
+    const rc_modified_memref_t* memref_stop = modified_memref + modified_memref_list->count;
+
+    for (; modified_memref < memref_stop; ++modified_memref) {
+      if (modified_memref->memref.value.size == size &&
+          modified_memref->modifier_type == modifier_type &&
+          rc_operands_are_equal(&modified_memref->parent, parent) &&
+          rc_operands_are_equal(&modified_memref->modifier, modifier)) {
+        return modified_memref;
+      }
+    }
+
+    modified_memref_list = modified_memref_list->next;
+  } while (modified_memref_list);
+
+  return NULL;
+}
+
+rc_memref_t* rc_alloc_memref(rc_parse_state_t* parse, uint32_t address, uint8_t size) {
+  const uint32_t hash = rc_memref_hash(address, size);
+  rc_memref_list_t* memref_list = NULL;
+  rc_memref_t* memref = NULL;
+  rc_memref_index_t* index;
+
+  if (parse->existing_memrefs) {
+    index = rc_parse_memref_index(parse, parse->existing_memrefs);
+    if (index)
+      memref = rc_memref_index_find_memref(index, hash, address, size);
+    else
+      memref = rc_find_memref(&parse->existing_memrefs->memrefs, address, size);
+
+    if (memref)
+      return memref;
   }
 
+  index = rc_parse_memref_index(parse, parse->memrefs);
+  if (index)
+    memref = rc_memref_index_find_memref(index, hash, address, size);
+  else
+    memref = rc_find_memref(&parse->memrefs->memrefs, address, size);
+
+  if (memref)
+    return memref;
+
   /* no match found, find a place to put the new entry */
   memref_list = &parse->memrefs->memrefs;
   while (memref_list->count == memref_list->capacity && memref_list->next)
@@ -81,42 +381,30 @@ rc_memref_t* rc_alloc_memref(rc_parse_state_t* parse, uint32_t address, uint8_t
 
 rc_modified_memref_t* rc_alloc_modified_memref(rc_parse_state_t* parse, uint8_t size, const rc_operand_t* parent,
                                                uint8_t modifier_type, const rc_operand_t* modifier) {
+  const uint32_t hash = rc_modified_memref_hash(modifier_type, parent, modifier) ^ size;
   rc_modified_memref_list_t* modified_memref_list = NULL;
   rc_modified_memref_t* modified_memref = NULL;
-  int i = 0;
+  rc_memref_index_t* index;
 
-  for (i = 0; i < 2; i++) {
-    if (i == 0) {
-      if (!parse->existing_memrefs)
-        continue;
+  if (parse->existing_memrefs) {
+    index = rc_parse_memref_index(parse, parse->existing_memrefs);
+    if (index)
+      modified_memref = rc_memref_index_find_modified_memref(index, hash, size, parent, modifier_type, modifier);
+    else
+      modified_memref = rc_find_modified_memref(&parse->existing_memrefs->modified_memrefs, size, parent, modifier_type, modifier);
 
-      modified_memref_list = &parse->existing_memrefs->modified_memrefs;
-    }
-    else {
-      modified_memref_list = &parse->memrefs->modified_memrefs;
-    }
-
-    do {
-      const rc_modified_memref_t* memref_stop;
-
-      modified_memref = modified_memref_list->items;
-      memref_stop = modified_memref + modified_memref_list->count;
+    if (modified_memref)
+      return modified_memref;
+  }
 
-      for (; modified_memref < memref_stop; ++modified_memref) {
-        if (modified_memref->memref.value.size == size &&
-            modified_memref->modifier_type == modifier_type &&
-            rc_operands_are_equal(&modified_memref->parent, parent) &&
-            rc_operands_are_equal(&modified_memref->modifier, modifier)) {
-          return modified_memref;
-        }
-      }
+  index = rc_parse_memref_index(parse, parse->memrefs);
+  if (index)
+    modified_memref = rc_memref_index_find_modified_memref(index, hash, size, parent, modifier_type, modifier);
+  else
+    modified_memref = rc_find_modified_memref(&parse->memrefs->modified_memrefs, size, parent, modifier_type, modifier);
 
-      if (!modified_memref_list->next)
-        break;
-
-      modified_memref_list = modified_memref_list->next;
-    } while (1);
-  }
+  if (modified_memref)
+    return modified_memref;
 
   /* no match found, find a place to put the new entry */
   modified_memref_list = &parse->memrefs->modified_memrefs;
@@ -155,6 +443,8 @@ rc_modified_memref_t* rc_alloc_modified_memref(rc_parse_state_t* parse, uint8_t
   memcpy(&modified_memref->modifier, modifier, sizeof(modified_memref->modifier));
   modified_memref->modifier_type = modifier_type;
   modified_memref->memref.address = rc_operand_is_memref(modifier) ? modifier->value.memref->address : modifier->value.num;
+  modified_memref->is_integer = (modified_memref->memref.value.type == RC_VALUE_TYPE_UNSIGNED &&
+      rc_operand_is_integer(parent) && rc_operand_is_integer(modifier));
 
   return modified_memref;
 }
@@ -172,6 +462,13 @@ void rc_memrefs_init(rc_memrefs_t* memrefs)
   memrefs->modified_memrefs.items =
     (rc_modified_memref_t*)malloc(memrefs->modified_memrefs.capacity * sizeof(rc_modified_memref_t));
   memrefs->modified_memrefs.allocated = 1;
+
+  memrefs->index = (rc_memref_index_t*)calloc(1, sizeof(rc_memref_index_t));
+  memrefs->reads = (rc_memref_reads_t*)calloc(1, sizeof(rc_memref_reads_t));
+
+  memrefs->schedule = (rc_memrefs_schedule_t*)calloc(1, sizeof(rc_memrefs_schedule_t));
+  if (memrefs->schedule)
+    memrefs->schedule->dirty = 1;
 }
 
 void rc_memrefs_destroy(rc_memrefs_t* memrefs)
@@ -205,9 +502,509 @@ void rc_memrefs_destroy(rc_memrefs_t* memrefs)
     }
   } while (modified_memref_list);
 
+  rc_memref_index_destroy(memrefs->index);
+
+  if (memrefs->reads) {
+    if (memrefs->reads->memrefs)
+      free(memrefs->reads->memrefs);
+
+    free(memrefs->reads);
+  }
+
+  if (memrefs->schedule) {
+    if (memrefs->schedule->modified_memrefs)
+      free(memrefs->schedule->modified_memrefs);
+    if (memrefs->schedule->memrefs)
+      free(memrefs->schedule->memrefs);
+    if (memrefs->schedule->chunks)
+      free(memrefs->schedule->chunks);
+
+    rc_memrefs_free_indirect_groups(memrefs->schedule);
+    free(memrefs->schedule);
+  }
+
   free(memrefs);
 }
 
+void rc_memrefs_mark_dirty(rc_memrefs_t* memrefs)
+{
+  /* memref records were modified outside of rc_update_memref_values. rebuild the read plan, and
+   * don't keep the values of memrefs on pages that weren't written */
+  if (memrefs && memrefs->reads) {
+    memrefs->reads->dirty = 1;
+    memrefs->reads->values_current = 0;
+  }
+}
+
+void rc_memrefs_invalidate_values(rc_memrefs_t* memrefs)
+{
+  /* memory may have been written without a dirty page bitmap describing it. the next update has to read everything */
+  if (memrefs && memrefs->reads)
+    memrefs->reads->values_current = 0;
+}
+
+void rc_memrefs_set_fuse_reads(rc_memrefs_t* memrefs, int enabled)
+{
+  if (memrefs && memrefs->reads) {
+    memrefs->reads->fuse_reads = enabled ? 1 : 0;
+    memrefs->reads->dirty = 1;
+  }
+}
+
+void rc_memrefs_invalidate_schedule(rc_memrefs_t* memrefs)
+{
+  /* the set of active triggers, leaderboards, or rich presence changed */
+  if (memrefs && memrefs->schedule) {
+    memrefs->schedule->dirty = 1;
+    rc_memrefs_mark_dirty(memrefs);
+  }
+}
+
+static int rc_memrefs_schedule_compare_chunks(const void* a, const void* b)
+{
+  const rc_memrefs_schedule_chunk_t* chunk_a = (const rc_memrefs_schedule_chunk_t*)a;
+  const rc_memrefs_schedule_chunk_t* chunk_b = (const rc_memrefs_schedule_chunk_t*)b;
+
+  if (chunk_a->items == chunk_b->items)
+    return 0;
+
+  return (chunk_a->items < chunk_b->items) ? -1 : 1;
+}
+
+int rc_memrefs_begin_schedule(rc_memrefs_t* memrefs)
+{
+  rc_memrefs_schedule_t* schedule = memrefs->schedule;
+  const uint32_t num_memrefs = rc_memrefs_count_memrefs(memrefs);
+  const rc_memref_list_t* memref_list;
+  uint32_t num_chunks = 0;
+  uint32_t first_index = 0;
+  uint32_t i;
+
+  for (memref_list = &memrefs->memrefs; memref_list; memref_list = memref_list->next)
+    ++num_chunks;
+
+  if (num_chunks > schedule->chunks_capacity) {
+    rc_memrefs_schedule_chunk_t* chunks = (rc_memrefs_schedule_chunk_t*)
+      realloc(schedule->chunks, num_chunks * sizeof(rc_memrefs_schedule_chunk_t));
+    if (!chunks)
+      return 0;
+
+    schedule->chunks = chunks;
+    schedule->chunks_capacity = num_chunks;
+  }
+
+  if (num_memrefs > schedule->memrefs_capacity) {
+    /* memrefs, stale_memrefs, and memref_states share a single allocation */
+    const uint32_t capacity = num_memrefs + 32;
+    rc_memref_t** block = (rc_memref_t**)malloc(capacity * (2 * sizeof(rc_memref_t*) + sizeof(uint8_t)));
+    uint8_t* memref_states;
+    if (!block)
+      return 0;
+
+    memref_states = (uint8_t*)&block[capacity * 2];
+    memset(memref_states, 0, capacity);
+    if (schedule->memrefs) {
+      memcpy(memref_states, schedule->memref_states, schedule->memrefs_capacity);
+      free(schedule->memrefs);
+    }
+
+    schedule->memrefs = block;
+    schedule->stale_memrefs = &block[capacity];
+    schedule->memref_states = memref_states;
+    schedule->memrefs_capacity = capacity;
+  }
+
+  schedule->num_chunks = num_chunks;
+  for (i = 0, memref_list = &memrefs->memrefs; memref_list; memref_list = memref_list->next, ++i) {
+    schedule->chunks[i].items = memref_list->items;
+    schedule->chunks[i].count = memref_list->count;
+    schedule->chunks[i].first_index = first_index;
+    first_index += memref_list->count;
+  }
+
+  qsort(schedule->chunks, num_chunks, sizeof(rc_memrefs_schedule_chunk_t), rc_memrefs_schedule_compare_chunks);
+
+  for (i = 0; i < num_memrefs; ++i)
+    schedule->memref_states[i] &= ~RC_MEMREF_SCHEDULE_MARKED;
+
+  return 1;
+}
+
+static void rc_memrefs_mark_memref_reachable(rc_memrefs_schedule_t* schedule, const rc_memref_t* memref)
+{
+  uint32_t low = 0, high = schedule->num_chunks;
+
+  while (low < high) {
+    const uint32_t mid = (low + high) / 2;
+    const rc_memrefs_schedule_chunk_t* chunk = &schedule->chunks[mid];
+
+    if (memref < chunk->items) {
+      high = mid;
+    }
+    else if (memref >= chunk->items + chunk->count) {
+      low = mid + 1;
+    }
+    else {
+      schedule->memref_states[chunk->first_index + (memref - chunk->items)] |= RC_MEMREF_SCHEDULE_MARKED;
+      return;
+    }
+  }
+}
+
+void rc_memrefs_mark_operand_reachable(rc_memrefs_t* memrefs, const rc_operand_t* operand)
+{
+  rc_modified_memref_t* modified_memref;
+
+  if (!rc_operand_is_memref(operand)) {
+    if (operand->type != RC_OPERAND_RECALL || !rc_operand_type_is_memref(operand->memref_access_type))
+      return;
+  }
+
+  if (!operand->value.memref)
+    return;
+
+  if (operand->value.memref->value.memref_type != RC_MEMREF_TYPE_MODIFIED_MEMREF) {
+    rc_memrefs_mark_memref_reachable(memrefs->schedule, operand->value.memref);
+    return;
+  }
+
+  modified_memref = (rc_modified_memref_t*)operand->value.memref;
+  if (modified_memref->schedule_flags & RC_MODIFIED_MEMREF_SCHEDULE_MARKED)
+    return;
+
+  modified_memref->schedule_flags |= RC_MODIFIED_MEMREF_SCHEDULE_MARKED;
+  rc_memrefs_mark_operand_reachable(memrefs, &modified_memref->parent);
+  rc_memrefs_mark_operand_reachable(memrefs, &modified_memref->modifier);
+}
+
+static void rc_memrefs_mark_condset_reachable(rc_memrefs_t* memrefs, const rc_condset_t* condset)
+{
+  const rc_condition_t* condition;
+
+  for (; condset; condset = condset->next) {
+    for (condition = condset->conditions; condition; condition = condition->next) {
+      rc_memrefs_mark_operand_reachable(memrefs, &condition->operand1);
+      rc_memrefs_mark_operand_reachable(memrefs, &condition->operand2);
+    }
+  }
+}
+
+void rc_memrefs_mark_trigger_reachable(rc_memrefs_t* memrefs, const rc_trigger_t* trigger)
+{
+  rc_memrefs_mark_condset_reachable(memrefs, trigger->requirement);
+  rc_memrefs_mark_condset_reachable(memrefs, trigger->alternative);
+}
+
+void rc_memrefs_mark_lboard_reachable(rc_memrefs_t* memrefs, const rc_lboard_t* lboard)
+{
+  rc_memrefs_mark_trigger_reachable(memrefs, &lboard->start);
+  rc_memrefs_mark_trigger_reachable(memrefs, &lboard->submit);
+  rc_memrefs_mark_trigger_reachable(memrefs, &lboard->cancel);
+  rc_memrefs_mark_condset_reachable(memrefs, lboard->value.conditions);
+
+  if (lboard->progress)
+    rc_memrefs_mark_condset_reachable(memrefs, lboard->progress->conditions);
+}
+
+void rc_memrefs_mark_richpresence_reachable(rc_memrefs_t* memrefs, const rc_richpresence_t* richpresence)
+{
+  const rc_richpresence_display_t* display;
+  const rc_richpresence_display_part_t* part;
+  const rc_value_t* variable;
+
+  for (display = richpresence->first_display; display; display = display->next) {
+    rc_memrefs_mark_trigger_reachable(memrefs, &display->trigger);
+
+    for (part = display->display; part; part = part->next)
+      rc_memrefs_mark_operand_reachable(memrefs, &part->value);
+  }
+
+  for (variable = richpresence->values; variable; variable = variable->next)
+    rc_memrefs_mark_condset_reachable(memrefs, variable->conditions);
+}
+
+/* the largest span of offsets from a single pointer that will be fetched with one read */
+#define RC_MEMREFS_INDIRECT_GROUP_MAX_SPAN 256
+
+typedef struct rc_memrefs_indirect_candidate_t {
+  const rc_modified_memref_t* modified_memref;
+  uint32_t index;
+} rc_memrefs_indirect_candidate_t;
+
+static int rc_memrefs_is_indirect_candidate(const rc_modified_memref_t* modified_memref)
+{
+  return (modified_memref->modifier_type == RC_OPERATOR_INDIRECT_READ &&
+          modified_memref->modifier.type == RC_OPERAND_CONST &&
+          rc_operand_is_memref(&modified_memref->parent));
+}
+
+static int rc_memrefs_same_indirect_parent(const rc_operand_t* left, const rc_operand_t* right)
+{
+  return (left->value.memref == right->value.memref && left->type == right->type &&
+          left->size == right->size && left->memref_access_type == right->memref_access_type);
+}
+
+static int rc_memrefs_compare_indirect_candidates(const void* a, const void* b)
+{
+  const rc_memrefs_indirect_candidate_t* candidate_a = (const rc_memrefs_indirect_candidate_t*)a;
+  const rc_memrefs_indirect_candidate_t* candidate_b = (const rc_memrefs_indirect_candidate_t*)b;
+  const rc_operand_t* parent_a = &candidate_a->modified_memref->parent;
+  const rc_operand_t* parent_b = &candidate_b->modified_memref->parent;
+  const uint32_t offset_a = candidate_a->modified_memref->modifier.value.num;
+  const uint32_t offset_b = candidate_b->modified_memref->modifier.value.num;
+
+  /* group by pointer, then order by offset */
+  if (parent_a->value.memref != parent_b->value.memref)
+    return ((size_t)parent_a->value.memref < (size_t)parent_b->value.memref) ? -1 : 1;
+  if (parent_a->type != parent_b->type)
+    return (int)parent_a->type - (int)parent_b->type;
+  if (parent_a->size != parent_b->size)
+    return (int)parent_a->size - (int)parent_b->size;
+  if (parent_a->memref_access_type != parent_b->memref_access_type)
+    return (int)parent_a->memref_access_type - (int)parent_b->memref_access_type;
+  if (offset_a != offset_b)
+    return (offset_a < offset_b) ? -1 : 1;
+
+  return (candidate_a->index < candidate_b->index) ? -1 : 1;
+}
+
+static void rc_memrefs_free_indirect_groups(struct rc_memrefs_schedule_t* schedule)
+{
+  if (schedule->indirect_groups)
+    free(schedule->indirect_groups);
+  if (schedule->indirect_group_index)
+    free(schedule->indirect_group_index);
+  if (schedule->indirect_members)
+    free((void*)schedule->indirect_members);
+  if (schedule->indirect_buffer)
+    free(schedule->indirect_buffer);
+
+  schedule->indirect_groups = NULL;
+  schedule->indirect_group_index = NULL;
+  schedule->indirect_members = NULL;
+  schedule->indirect_buffer = NULL;
+  schedule->num_indirect_groups = 0;
+}
+
+static void rc_memrefs_schedule_indirect_groups(rc_memrefs_schedule_t* schedule)
+{
+  rc_memrefs_indirect_candidate_t* candidates;
+  rc_memrefs_indirect_group_t* group;
+  uint32_t num_candidates = 0, num_groups = 0, num_members = 0, buffer_size = 0;
+  uint32_t first, i, j;
+
+  rc_memrefs_free_indirect_groups(schedule);
+
+  for (i = 0; i < schedule->num_modified_memrefs; ++i) {
+    if (rc_memrefs_is_indirect_candidate(schedule->modified_memrefs[i]))
+      ++num_candidates;
+  }
+
+  if (num_candidates < 2)
+    return;
+
+  candidates = (rc_memrefs_indirect_candidate_t*)malloc(num_candidates * sizeof(rc_memrefs_indirect_candidate_t));
+  schedule->indirect_group_index = (uint32_t*)calloc(schedule->num_modified_memrefs, sizeof(uint32_t));
+  schedule->indirect_members = (const rc_modified_memref_t**)malloc(num_candidates * sizeof(rc_modified_memref_t*));
+  /* each group has at least two members */
+  schedule->indirect_groups = (rc_memrefs_indirect_group_t*)malloc((num_candidates / 2) * sizeof(rc_memrefs_indirect_group_t));
+  if (!candidates || !schedule->indirect_group_index || !schedule->indirect_members || !schedule->indirect_groups) {
+    if (candidates)
+      free(candidates);
+
+    rc_memrefs_free_indirect_groups(schedule);
+    return;
+  }
+
+  num_candidates = 0;
+  for (i = 0; i < schedule->num_modified_memrefs; ++i) {
+    if (rc_memrefs_is_indirect_candidate(schedule->modified_memrefs[i])) {
+      candidates[num_candidates].modified_memref = schedule->modified_memrefs[i];
+      candidates[num_candidates].index = i;
+      ++num_candidates;
+    }
+  }
+
+  qsort(candidates, num_candidates, sizeof(rc_memrefs_indirect_candidate_t), rc_memrefs_compare_indirect_candidates);
+
+  /* split the reads from each pointer into spans of nearby offsets */
+  for (first = 0; first < num_candidates; first = i) {
+    const rc_modified_memref_t* first_memref = candidates[first].modified_memref;
+    const uint32_t first_offset = first_memref->modifier.value.num;
+    uint32_t num_bytes = rc_memref_read_size(first_memref->memref.value.size);
+
+    for (i = first + 1; i < num_candidates; ++i) {
+      const rc_modified_memref_t* modified_memref = candidates[i].modified_memref;
+      const uint32_t relative_offset = modified_memref->modifier.value.num - first_offset;
+      const uint32_t read_size = rc_memref_read_size(modified_memref->memref.value.size);
+
+      if (!rc_memrefs_same_indirect_parent(&modified_memref->parent, &first_memref->parent) ||
+          relative_offset > RC_MEMREFS_INDIRECT_GROUP_MAX_SPAN - read_size)
+        break;
+
+      if (relative_offset + read_size > num_bytes)
+        num_bytes = relative_offset + read_size;
+    }
+
+    if (i - first < 2)
+      continue;
+
+    group = &schedule->indirect_groups[num_groups++];
+    group->parent = &first_memref->parent;
+    group->first_offset = first_offset;
+    group->num_bytes = num_bytes;
+    group->address = buffer_size; /* offset into the buffer until the buffer is allocated */
+    group->first_member = num_members;
+    group->num_members = i - first;
+    group->state = RC_MEMREFS_INDIRECT_GROUP_PENDING;
+    buffer_size += num_bytes;
+
+    for (j = first; j < i; ++j) {
+      schedule->indirect_members[num_members++] = candidates[j].modified_memref;
+      schedule->indirect_group_index[candidates[j].index] = num_groups;
+    }
+  }
+
+  free(candidates);
+
+  if (num_groups == 0 || (schedule->indirect_buffer = (uint8_t*)malloc(buffer_size)) == NULL) {
+    rc_memrefs_free_indirect_groups(schedule);
+    return;
+  }
+
+  for (i = 0; i < num_groups; ++i) {
+    group = &schedule->indirect_groups[i];
+    group->buffer = schedule->indirect_buffer + group->address;
+    group->address = 0;
+  }
+
+  schedule->num_indirect_groups = num_groups;
+}
+
+static int rc_memrefs_schedule_modified_memrefs(rc_memrefs_t* memrefs)
+{
+  rc_memrefs_schedule_t* schedule = memrefs->schedule;
+  const uint32_t count = rc_memrefs_count_modified_memrefs(memrefs);
+  rc_modified_memref_list_t* modified_memref_list;
+  int result = 1;
+
+  if (count > schedule->modified_memrefs_capacity) {
+    rc_modified_memref_t** items = (rc_modified_memref_t**)realloc(schedule->modified_memrefs, count * sizeof(rc_modified_memref_t*));
+    if (items) {
+      schedule->modified_memrefs = items;
+      schedule->modified_memrefs_capacity = count;
+    }
+    else {
+      /* update everything until the schedule can be built */
+      result = 0;
+    }
+  }
+
+  schedule->num_modified_memrefs = 0;
+  modified_memref_list = &memrefs->modified_memrefs;
+  for (; modified_memref_list; modified_memref_list = modified_memref_list->next) {
+    rc_modified_memref_t* modified_memref = modified_memref_list->items;
+    const rc_modified_memref_t* modified_memref_stop = modified_memref + modified_memref_list->count;
+
+    for (; modified_memref < modified_memref_stop; ++modified_memref) {
+      uint8_t flags = modified_memref->schedule_flags;
+
+      if (!result) {
+        flags &= ~RC_MODIFIED_MEMREF_SCHEDULE_MARKED;
+      }
+      else if (flags & RC_MODIFIED_MEMREF_SCHEDULE_MARKED) {
+        schedule->modified_memrefs[schedule->num_modified_memrefs++] = modified_memref;
+        flags = (flags & RC_MODIFIED_MEMREF_SCHEDULE_STALE) | RC_MODIFIED_MEMREF_SCHEDULE_REACHABLE;
+      }
+      else if (flags & RC_MODIFIED_MEMREF_SCHEDULE_REACHABLE) {
+        /* no longer reachable. its value will be out of date if it becomes reachable again */
+        flags = RC_MODIFIED_MEMREF_SCHEDULE_STALE;
+      }
+
+      modified_memref->schedule_flags = flags;
+    }
+  }
+
+  if (result)
+    rc_memrefs_schedule_indirect_groups(schedule);
+  else
+    rc_memrefs_free_indirect_groups(schedule);
+
+  return result;
+}
+
+void rc_memrefs_end_schedule(rc_memrefs_t* memrefs)
+{
+  rc_memrefs_schedule_t* schedule = memrefs->schedule;
+  rc_memref_list_t* memref_list;
+  uint8_t* memref_state = schedule->memref_states;
+
+  if (!rc_memrefs_schedule_modified_memrefs(memrefs))
+    return;
+
+  schedule->num_memrefs = 0;
+  schedule->num_stale_memrefs = 0;
+
+  for (memref_list = &memrefs->memrefs; memref_list; memref_list = memref_list->next) {
+    rc_memref_t* memref = memref_list->items;
+    const rc_memref_t* memref_stop = memref + memref_list->count;
+
+    for (; memref < memref_stop; ++memref, ++memref_state) {
+      if (!(*memref_state & RC_MEMREF_SCHEDULE_MARKED)) {
+        /* not referenced by anything active. stop reading it */
+        *memref_state = RC_MEMREF_SCHEDULE_PARKED;
+        continue;
+      }
+
+      if (*memref_state & RC_MEMREF_SCHEDULE_PARKED)
+        schedule->stale_memrefs[schedule->num_stale_memrefs++] = memref;
+
+      *memref_state = RC_MEMREF_SCHEDULE_LIVE;
+      schedule->memrefs[schedule->num_memrefs++] = memref;
+    }
+  }
+
+  schedule->dirty = 0;
+  rc_memrefs_mark_dirty(memrefs);
+}
+
+rc_memref_t** rc_memrefs_get_scheduled_memrefs(const rc_memrefs_t* memrefs, uint32_t* count)
+{
+  if (!memrefs->schedule || memrefs->schedule->dirty)
+    return NULL;
+
+  *count = memrefs->schedule->num_memrefs;
+  return memrefs->schedule->memrefs;
+}
+
+void rc_memrefs_prime_stale_memrefs(rc_memrefs_t* memrefs, rc_peek_t peek, void* ud)
+{
+  rc_memrefs_schedule_t* schedule = memrefs->schedule;
+  rc_memref_t** memref;
+  rc_memref_t** memref_stop;
+
+  if (!schedule || schedule->dirty || !schedule->num_stale_memrefs)
+    return;
+
+  /* the value from the previous frame is unknown. capture the current value without reporting a change */
+  memref = schedule->stale_memrefs;
+  memref_stop = memref + schedule->num_stale_memrefs;
+  for (; memref < memref_stop; ++memref) {
+    const uint32_t value = ((*memref)->value.type == RC_VALUE_TYPE_NONE) ? (*memref)->value.value :
+      rc_peek_value((*memref)->address, (*memref)->value.size, peek, ud);
+
+    if ((*memref)->value.value != value) {
+      (*memref)->value.prior = (*memref)->value.value;
+      (*memref)->value.value = value;
+    }
+
+    (*memref)->value.changed = 0;
+  }
+
+  schedule->num_stale_memrefs = 0;
+  rc_memrefs_mark_dirty(memrefs);
+}
+
 uint32_t rc_memrefs_count_memrefs(const rc_memrefs_t* memrefs)
 {
   uint32_t count = 0;
@@ -687,6 +1484,9 @@ void rc_init_parse_state_memrefs(rc_parse_state_t* parse, rc_memrefs_t* memrefs)
     memset(memrefs, 0, sizeof(*memrefs));
 
   parse->memrefs = memrefs;
+
+  if (parse->memref_index)
+    parse->memref_index->source = NULL;
 }
 
 static uint32_t rc_get_memref_value_value(const rc_memref_value_t* memref, int operand_type) {
@@ -714,9 +1514,51 @@ void rc_get_memref_value(rc_typed_value_t* value, rc_memref_t* memref, int opera
   value->value.u32 = rc_get_memref_value_value(&memref->value, operand_type);
 }
 
+/* same results as the typed calculation below when both sides are unsigned, without the conversions.
+ * dividing by zero produces RC_VALUE_TYPE_NONE, which converts to 0 */
+static uint32_t rc_get_modified_memref_integer_value(const rc_modified_memref_t* memref, rc_peek_t peek, void* ud) {
+  const uint32_t value = rc_evaluate_integer_operand(&memref->parent);
+  const uint32_t modifier = rc_evaluate_integer_operand(&memref->modifier);
+
+  switch (memref->modifier_type) {
+    case RC_OPERATOR_INDIRECT_READ:
+      return rc_peek_value(value + modifier, memref->memref.value.size, peek, ud);
+
+    case RC_OPERATOR_SUB_PARENT:
+      return modifier - value;
+
+    case RC_OPERATOR_ADD:
+      return value + modifier;
+
+    case RC_OPERATOR_SUB:
+      return value - modifier;
+
+    case RC_OPERATOR_MULT:
+      return value * modifier;
+
+    case RC_OPERATOR_DIV:
+      return modifier ? value / modifier : 0;
+
+    case RC_OPERATOR_MOD:
+      return modifier ? value % modifier : 0;
+
+    case RC_OPERATOR_AND:
+      return value & modifier;
+
+    case RC_OPERATOR_XOR:
+      return value ^ modifier;
+
+    default:
+      return value;
+  }
+}
+
 uint32_t rc_get_modified_memref_value(const rc_modified_memref_t* memref, rc_peek_t peek, void* ud) {
   rc_typed_value_t value, modifier;
 
+  if (memref->is_integer)
+    return rc_get_modified_memref_integer_value(memref, peek, ud);
+
   rc_evaluate_operand(&value, &memref->parent, NULL);
   rc_evaluate_operand(&modifier, &memref->modifier, NULL);
 
@@ -743,23 +1585,471 @@ uint32_t rc_get_modified_memref_value(const rc_modified_memref_t* memref, rc_pee
   return value.value.u32;
 }
 
+static int rc_memref_reads_reserve(rc_memref_reads_t* reads, uint32_t needed) {
+  uint32_t capacity = reads->capacity ? reads->capacity : 64;
+  uint8_t* block;
+
+  while (capacity < needed)
+    capacity <<= 1;
+
+  /* one block: pointers first so every array is naturally aligned. there can't be more reads than memrefs */
+  block = (uint8_t*)malloc(capacity * (sizeof(rc_memref_t*) + sizeof(uint32_t) * 4 + sizeof(uint8_t) * 2));
+  if (!block)
+    return 0;
+
+  if (reads->memrefs)
+    free(reads->memrefs);
+
+  reads->memrefs = (rc_memref_t**)block;
+  block += capacity * sizeof(rc_memref_t*);
+  reads->masks = (uint32_t*)block;
+  block += capacity * sizeof(uint32_t);
+  reads->read_index = (uint32_t*)block;
+  block += capacity * sizeof(uint32_t);
+  reads->read_addresses = (uint32_t*)block;
+  block += capacity * sizeof(uint32_t);
+  reads->read_values = (uint32_t*)block;
+  block += capacity * sizeof(uint32_t);
+  reads->shifts = block;
+  block += capacity;
+  reads->read_sizes = block;
+
+  reads->capacity = capacity;
+  return 1;
+}
+
+static uint32_t rc_memref_read_size(uint8_t size) {
+  switch (rc_memref_shared_size(size)) {
+    case RC_MEMSIZE_8_BITS: return 1;
+    case RC_MEMSIZE_16_BITS: return 2;
+    default: return 4;
+  }
+}
+
+void rc_memrefs_set_dirty_pages(rc_memrefs_t* memrefs, const uint8_t* dirty_pages, uint32_t num_pages, uint32_t page_size)
+{
+  rc_memref_reads_t* reads = memrefs ? memrefs->reads : NULL;
+  uint8_t page_shift = 0;
+
+  if (!reads)
+    return;
+
+  /* only power of two page sizes are supported */
+  if (page_size == 0 || (page_size & (page_size - 1)) != 0)
+    dirty_pages = NULL;
+  else {
+    while ((1U << page_shift) < page_size)
+      ++page_shift;
+  }
+
+  reads->dirty_pages = dirty_pages;
+  reads->num_dirty_pages = dirty_pages ? num_pages : 0;
+  reads->dirty_page_shift = page_shift;
+}
+
+void rc_memrefs_begin_update(rc_memrefs_t* memrefs)
+{
+  rc_memref_reads_t* reads = memrefs->reads;
+
+  /* a page that wasn't written still has to be read if the value from the previous update
+   * isn't known to match it. new memrefs haven't been read yet */
+  if (reads && reads->dirty_pages) {
+    if (!reads->values_current || reads->values_count != rc_memrefs_count_memrefs(memrefs))
+      reads->dirty_pages = NULL;
+  }
+}
+
+static int rc_memref_reads_is_range_clean(const rc_memref_reads_t* reads, uint32_t address, uint32_t num_bytes)
+{
+  uint32_t page, last_page;
+
+  if (!reads->dirty_pages || num_bytes == 0 || address > 0xFFFFFFFF - (num_bytes - 1))
+    return 0;
+
+  page = address >> reads->dirty_page_shift;
+  last_page = (address + num_bytes - 1) >> reads->dirty_page_shift;
+  if (last_page >= reads->num_dirty_pages)
+    return 0;
+
+  for (; page <= last_page; ++page) {
+    if (reads->dirty_pages[page >> 3] & (1 << (page & 7)))
+      return 0;
+  }
+
+  return 1;
+}
+
+int rc_memrefs_is_range_clean(const rc_memrefs_t* memrefs, uint32_t address, uint32_t num_bytes)
+{
+  return memrefs->reads && rc_memref_reads_is_range_clean(memrefs->reads, address, num_bytes);
+}
+
+int rc_memrefs_is_memref_clean(const rc_memrefs_t* memrefs, const rc_memref_t* memref)
+{
+  return memrefs->reads && rc_memref_reads_is_range_clean(memrefs->reads, memref->address, rc_memref_read_size(memref->value.size));
+}
+
+void rc_memrefs_end_update(rc_memrefs_t* memrefs)
+{
+  rc_memref_reads_t* reads = memrefs->reads;
+
+  /* the bitmap only describes a single frame */
+  if (reads) {
+    reads->dirty_pages = NULL;
+    reads->num_dirty_pages = 0;
+    reads->values_count = rc_memrefs_count_memrefs(memrefs);
+    reads->values_current = 1;
+  }
+}
+
+static int rc_memref_reads_compare_memrefs(const void* a, const void* b) {
+  const rc_memref_t* memref_a = *(const rc_memref_t**)a;
+  const rc_memref_t* memref_b = *(const rc_memref_t**)b;
+
+  if (memref_a->address != memref_b->address)
+    return (memref_a->address < memref_b->address) ? -1 : 1;
+
+  /* wider reads first */
+  return (int)rc_memref_read_size(memref_b->value.size) - (int)rc_memref_read_size(memref_a->value.size);
+}
+
+static void rc_memref_reads_add_read(rc_memref_reads_t* reads, uint32_t first, uint32_t last, uint32_t address, uint32_t end) {
+  const uint32_t read_index = reads->num_reads++;
+  uint32_t i;
+
+  reads->read_addresses[read_index] = address;
+  reads->read_sizes[read_index] = (uint8_t)(end - address);
+  reads->read_values[read_index] = 0;
+
+  for (i = first; i < last; ++i) {
+    const rc_memref_t* memref = reads->memrefs[i];
+    if (memref->address >= address && memref->address + rc_memref_read_size(memref->value.size) <= end) {
+      reads->read_index[i] = read_index;
+      reads->shifts[i] = (uint8_t)((memref->address - address) * 8);
+    }
+  }
+}
+
+static void rc_memref_reads_plan_reads(rc_memref_reads_t* reads, uint32_t first, uint32_t last, uint32_t address, uint32_t end) {
+  uint32_t i, split_end, tail_address;
+
+  if (end - address != 3) {
+    rc_memref_reads_add_read(reads, first, last, address, end);
+    return;
+  }
+
+  /* a 3 byte read can't be requested. read the memrefs that fit in the first two bytes separately
+   * from the ones that extend into the third byte. neither read covers a byte that wasn't being
+   * read before */
+  split_end = address + 1;
+  tail_address = end;
+  for (i = first; i < last; ++i) {
+    const rc_memref_t* memref = reads->memrefs[i];
+    const uint32_t memref_end = memref->address + rc_memref_read_size(memref->value.size);
+
+    if (memref_end <= address + 2) {
+      if (memref_end > split_end)
+        split_end = memref_end;
+    }
+    else if (memref->address < tail_address) {
+      tail_address = memref->address;
+    }
+  }
+
+  rc_memref_reads_add_read(reads, first, last, address, split_end);
+  rc_memref_reads_add_read(reads, first, last, tail_address, end);
+}
+
+static void rc_memref_reads_add(rc_memref_reads_t* reads, rc_memref_t* memref, uint32_t* count) {
+  if (memref->value.type != RC_VALUE_TYPE_NONE)
+    reads->memrefs[(*count)++] = memref;
+}
+
+static int rc_memref_reads_sync(rc_memref_reads_t* reads, const rc_memrefs_t* memrefs) {
+  const uint32_t source_count = rc_memrefs_count_memrefs(memrefs);
+  const rc_memref_list_t* memref_list;
+  rc_memref_t** scheduled_memref;
+  uint32_t num_scheduled_memrefs;
+  uint32_t count = 0;
+  uint32_t group_first = 0, group_address = 0, group_end = 0;
+  uint32_t i;
+
+  if (!reads->dirty && source_count == reads->source_count)
+    return 1;
+
+  /* the reads from the previous update are discarded, so every read has to be performed */
+  reads->dirty_pages = NULL;
+
+  if (source_count > reads->capacity && !rc_memref_reads_reserve(reads, source_count)) {
+    reads->dirty = 1;
+    return 0;
+  }
+
+  scheduled_memref = rc_memrefs_get_scheduled_memrefs(memrefs, &num_scheduled_memrefs);
+  if (scheduled_memref) {
+    /* only copy the memrefs that are referenced by active content */
+    rc_memref_t** scheduled_memref_stop = scheduled_memref + num_scheduled_memrefs;
+    for (; scheduled_memref < scheduled_memref_stop; ++scheduled_memref)
+      rc_memref_reads_add(reads, *scheduled_memref, &count);
+  }
+  else {
+    for (memref_list = &memrefs->memrefs; memref_list; memref_list = memref_list->next) {
+      rc_memref_t* memref = memref_list->items;
+      const rc_memref_t* memref_stop = memref + memref_list->count;
+
+      for (; memref < memref_stop; ++memref)
+        rc_memref_reads_add(reads, memref, &count);
+    }
+  }
+
+  if (count > 1)
+    qsort(reads->memrefs, count, sizeof(rc_memref_t*), rc_memref_reads_compare_memrefs);
+
+  /* group memrefs whose bytes overlap or abut into reads of no more than 4 bytes */
+  reads->num_reads = 0;
+  for (i = 0; i < count; ++i) {
+    const rc_memref_t* memref = reads->memrefs[i];
+    const uint32_t read_size = rc_memref_read_size(memref->value.size);
+    const uint32_t memref_end = memref->address + read_size;
+
+    reads->masks[i] = rc_memref_mask(memref->value.size);
+
+    if (i > 0 && memref->address <= group_end && memref_end > memref->address) {
+      const uint32_t new_end = (memref_end > group_end) ? memref_end : group_end;
+      if (new_end - group_address <= 4) {
+        group_end = new_end;
+        continue;
+      }
+    }
+
+    if (i > 0)
+      rc_memref_reads_plan_reads(reads, group_first, i, group_address, group_end);
+
+    group_first = i;
+    group_address = memref->address;
+    group_end = memref_end;
+  }
+
+  if (count > 0)
+    rc_memref_reads_plan_reads(reads, group_first, count, group_address, group_end);
+
+  reads->count = count;
+  reads->source_count = source_count;
+  reads->dirty = 0;
+  return 1;
+}
+
+static void rc_memref_reads_update(rc_memref_reads_t* reads, rc_peek_t peek, void* ud) {
+  uint32_t i;
+
+  if (reads->dirty_pages) {
+    /* reads that only cover pages that weren't written keep the value from the previous update */
+    for (i = 0; i < reads->num_reads; ++i) {
+      if (!rc_memref_reads_is_range_clean(reads, reads->read_addresses[i], reads->read_sizes[i]))
+        reads->read_values[i] = peek(reads->read_addresses[i], reads->read_sizes[i], ud);
+    }
+  }
+  else {
+    for (i = 0; i < reads->num_reads; ++i)
+      reads->read_values[i] = peek(reads->read_addresses[i], reads->read_sizes[i], ud);
+  }
+
+  /* extract each memref's value from the read that covers it */
+  for (i = 0; i < reads->count; ++i) {
+    const uint32_t value = (reads->read_values[reads->read_index[i]] >> reads->shifts[i]) & reads->masks[i];
+    rc_update_memref_value(&reads->memrefs[i]->value, value);
+  }
+}
+
+static void rc_update_memref(rc_memref_reads_t* reads, rc_memref_t* memref, rc_peek_t peek, void* ud) {
+  if (memref->value.type == RC_VALUE_TYPE_NONE)
+    return;
+
+  /* a memref that only covers pages that weren't written keeps the value from the previous update */
+  if (reads && reads->dirty_pages &&
+      rc_memref_reads_is_range_clean(reads, memref->address, rc_memref_read_size(memref->value.size)))
+    memref->value.changed = 0;
+  else
+    rc_update_memref_value(&memref->value, rc_peek_value(memref->address, memref->value.size, peek, ud));
+}
+
 void rc_update_memref_values(rc_memrefs_t* memrefs, rc_peek_t peek, void* ud) {
   rc_memref_list_t* memref_list;
+  rc_memref_t** scheduled_memref;
+  uint32_t num_scheduled_memrefs;
+
+  rc_memrefs_begin_update(memrefs);
+  rc_memrefs_prime_stale_memrefs(memrefs, peek, ud);
+
+  if (memrefs->reads && memrefs->reads->fuse_reads && peek && rc_memref_reads_sync(memrefs->reads, memrefs)) {
+    rc_memref_reads_update(memrefs->reads, peek, ud);
+  }
+  else if ((scheduled_memref = rc_memrefs_get_scheduled_memrefs(memrefs, &num_scheduled_memrefs)) != NULL) {
+    rc_memref_t** scheduled_memref_stop = scheduled_memref + num_scheduled_memrefs;
+    for (; scheduled_memref < scheduled_memref_stop; ++scheduled_memref)
+      rc_update_memref(memrefs->reads, *scheduled_memref, peek, ud);
+  }
+  else {
+    memref_list = &memrefs->memrefs;
+    do
+    {
+      rc_memref_t* memref = memref_list->items;
+      const rc_memref_t* memref_stop = memref + memref_list->count;
+
+      for (; memref < memref_stop; ++memref)
+        rc_update_memref(memrefs->reads, memref, peek, ud);
+
+      memref_list = memref_list->next;
+    } while (memref_list);
+  }
+
+  rc_memrefs_end_update(memrefs);
+  rc_update_modified_memref_values(memrefs, peek, ud);
+}
+
+static uint32_t rc_memrefs_peek_indirect_group(uint32_t address, uint32_t num_bytes, void* ud) {
+  const rc_memrefs_indirect_group_t* group = (const rc_memrefs_indirect_group_t*)ud;
+  const uint8_t* ptr = group->buffer + (address - group->address);
+
+  switch (num_bytes) {
+    case 1:
+      return ptr[0];
+
+    case 2:
+      return ptr[0] | (ptr[1] << 8);
+
+    case 4:
+      return ptr[0] | (ptr[1] << 8) | (ptr[2] << 16) | ((uint32_t)ptr[3] << 24);
+
+    default:
+      return 0;
+  }
+}
+
+static void rc_memrefs_read_indirect_group(rc_memrefs_indirect_group_t* group, const rc_modified_memref_t** members,
+                                           rc_peek_t peek, rc_read_block_t read_block, void* ud) {
+  const rc_modified_memref_t** member = &members[group->first_member];
+  const rc_modified_memref_t** member_stop = member + group->num_members;
+  const rc_modified_memref_t** next_member;
+  rc_typed_value_t pointer;
+  uint32_t offset, end, next_offset, num_bytes, value;
+
+  group->state = RC_MEMREFS_INDIRECT_GROUP_FAILED;
+
+  /* anything other than an unsigned pointer is handled by the individual reads */
+  rc_evaluate_operand(&pointer, group->parent, NULL);
+  if (pointer.type != RC_VALUE_TYPE_UNSIGNED)
+    return;
+
+  group->address = pointer.value.u32 + group->first_offset;
+  if (group->address > 0xFFFFFFFF - (group->num_bytes - 1))
+    return;
+
+  if (read_block) {
+    /* if the span can't be read as a whole, the members are read individually so each gets
+     * the same result it would have without grouping */
+    if (read_block(group->address, group->buffer, group->num_bytes, ud) != group->num_bytes)
+      return;
+  }
+  else {
+    /* no block reader. find the runs of bytes that members overlap or abut, and read each run up to
+     * 32 bits at a time. bytes that no member needs are never requested, so a read that extends past
+     * the end of memory can't cause a member that's fully inside memory to read as 0 */
+    for (; member < member_stop; member = next_member) {
+      offset = (*member)->modifier.value.num - group->first_offset;
+      end = offset + rc_memref_read_size((*member)->memref.value.size);
+
+      for (next_member = member + 1; next_member < member_stop; ++next_member) {
+        next_offset = (*next_member)->modifier.value.num - group->first_offset;
+        if (next_offset > end)
+          break;
+
+        next_offset += rc_memref_read_size((*next_member)->memref.value.size);
+        if (next_offset > end)
+          end = next_offset;
+      }
+
+      while (offset < end) {
+        num_bytes = end - offset;
+        if (num_bytes >= 4)
+          num_bytes = 4;
+        else if (num_bytes == 3)
+          num_bytes = 2;
+
+        value = peek(group->address + offset, num_bytes, ud);
+        num_bytes += offset;
+        do {
+          group->buffer[offset++] = (uint8_t)value;
+          value >>= 8;
+        } while (offset < num_bytes);
+      }
+    }
+  }
+
+  group->state = RC_MEMREFS_INDIRECT_GROUP_READ;
+}
+
+static uint32_t rc_memrefs_get_indirect_group_value(rc_memrefs_schedule_t* schedule, rc_memrefs_indirect_group_t* group,
+                                                    const rc_modified_memref_t* modified_memref, rc_peek_t peek, rc_read_block_t read_block, void* ud) {
+  uint32_t address;
+
+  /* the pointer was updated before the first member, so the whole span can be read now */
+  if (group->state == RC_MEMREFS_INDIRECT_GROUP_PENDING)
+    rc_memrefs_read_indirect_group(group, schedule->indirect_members, peek, read_block, ud);
+
+  if (group->state != RC_MEMREFS_INDIRECT_GROUP_READ)
+    return rc_get_modified_memref_value(modified_memref, peek, ud);
+
+  address = group->address + (modified_memref->modifier.value.num - group->first_offset);
+  return rc_peek_value(address, modified_memref->memref.value.size, rc_memrefs_peek_indirect_group, group);
+}
+
+void rc_update_modified_memref_values(rc_memrefs_t* memrefs, rc_peek_t peek, void* ud) {
+  rc_update_modified_memref_values_with_block_reader(memrefs, peek, NULL, ud);
+}
+
+void rc_update_modified_memref_values_with_block_reader(rc_memrefs_t* memrefs, rc_peek_t peek, rc_read_block_t read_block, void* ud) {
   rc_modified_memref_list_t* modified_memref_list;
 
-  memref_list = &memrefs->memrefs;
-  do
-  {
-    rc_memref_t* memref = memref_list->items;
-    const rc_memref_t* memref_stop = memref + memref_list->count;
+  if (memrefs->schedule && !memrefs->schedule->dirty) {
+    rc_memrefs_schedule_t* schedule = memrefs->schedule;
+    rc_modified_memref_t** modified_memref = schedule->modified_memrefs;
+    rc_modified_memref_t** modified_memref_stop = modified_memref + schedule->num_modified_memrefs;
+    const uint32_t* indirect_group_index = NULL;
+    uint32_t i;
+
+    /* without a block reader, grouped reads may request ranges that don't match an individual
+     * memref, so they're only used when the caller allows fused reads */
+    if (schedule->num_indirect_groups && peek && (read_block || (memrefs->reads && memrefs->reads->fuse_reads))) {
+      indirect_group_index = schedule->indirect_group_index;
+      for (i = 0; i < schedule->num_indirect_groups; ++i)
+        schedule->indirect_groups[i].state = RC_MEMREFS_INDIRECT_GROUP_PENDING;
+    }
 
-    for (; memref < memref_stop; ++memref) {
-      if (memref->value.type != RC_VALUE_TYPE_NONE)
-        rc_update_memref_value(&memref->value, rc_peek_value(memref->address, memref->value.size, peek, ud));
+    for (; modified_memref < modified_memref_stop; ++modified_memref) {
+      const uint32_t group_index = indirect_group_index ? *indirect_group_index++ : 0;
+      const uint32_t value = group_index ?
+          rc_memrefs_get_indirect_group_value(schedule, &schedule->indirect_groups[group_index - 1], *modified_memref, peek, read_block, ud) :
+          rc_get_modified_memref_value(*modified_memref, peek, ud);
+      rc_memref_value_t* memref_value = &(*modified_memref)->memref.value;
+
+      if ((*modified_memref)->schedule_flags & RC_MODIFIED_MEMREF_SCHEDULE_STALE) {
+        /* the value from the previous frame is unknown. treat the current value as unchanged */
+        if (memref_value->value != value) {
+          memref_value->prior = memref_value->value;
+          memref_value->value = value;
+        }
+
+        memref_value->changed = 0;
+        (*modified_memref)->schedule_flags &= ~RC_MODIFIED_MEMREF_SCHEDULE_STALE;
+      }
+      else {
+        rc_update_memref_value(memref_value, value);
+      }
     }
 
-    memref_list = memref_list->next;
-  } while (memref_list);
+    return;
+  }
 
   modified_memref_list = &memrefs->modified_memrefs;
   if (modified_memref_list->count) {
@@ -767,8 +2057,10 @@ void rc_update_memref_values(rc_memrefs_t* memrefs, rc_peek_t peek, void* ud) {
       rc_modified_memref_t* modified_memref = modified_memref_list->items;
       const rc_modified_memref_t* modified_memref_stop = modified_memref + modified_memref_list->count;
 
-      for (; modified_memref < modified_memref_stop; ++modified_memref)
+      for (; modified_memref < modified_memref_stop; ++modified_memref) {
         rc_update_memref_value(&modified_memref->memref.value, rc_get_modified_memref_value(modified_memref, peek, ud));
+        modified_memref->schedule_flags &= ~RC_MODIFIED_MEMREF_SCHEDULE_STALE;
+      }
 
       modified_memref_list = modified_memref_list->next;
     } while (modified_memref_list);
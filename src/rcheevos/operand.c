@@ -437,6 +437,23 @@ int rc_operand_is_float(const rc_operand_t* self) {
   return rc_operand_is_float_memref(self);
 }
 
+int rc_operand_is_integer(const rc_operand_t* self) {
+  switch (self->type) {
+    case RC_OPERAND_CONST:
+    case RC_OPERAND_FUNC:
+      return 1;
+
+    case RC_OPERAND_FP:
+    case RC_OPERAND_RECALL:
+      /* the remembered value isn't known until the condset is evaluated */
+      return 0;
+
+    default:
+      /* a modified memref with a float size produces a float even if the operand size isn't one */
+      return !rc_memsize_is_float(self->size) && self->value.memref->value.type == RC_VALUE_TYPE_UNSIGNED;
+  }
+}
+
 static uint32_t rc_transform_operand_value(uint32_t value, const rc_operand_t* self) {
   switch (self->type)
   {
@@ -602,3 +619,23 @@ void rc_evaluate_operand(rc_typed_value_t* result, const rc_operand_t* self, rc_
   if (result->type == RC_VALUE_TYPE_UNSIGNED)
     result->value.u32 = rc_transform_operand_value(result->value.u32, self);
 }
+
+uint32_t rc_evaluate_integer_operand(const rc_operand_t* self) {
+  /* ASSERT: rc_operand_is_integer(self) */
+  rc_typed_value_t value;
+
+  switch (self->type) {
+    case RC_OPERAND_CONST:
+      return self->value.num;
+
+    case RC_OPERAND_FUNC:
+      return 0;
+
+    default:
+      break;
+  }
+
+  rc_get_memref_value(&value, self->value.memref, self->type);
+  rc_transform_memref_value(&value, self->size);
+  return rc_transform_operand_value(value.value.u32, self);
+}
@@ -18,9 +18,17 @@ typedef struct rc_modified_memref_t {
   rc_operand_t parent;             /* The parent memref this memref is derived from (type will always be a memref type) */
   rc_operand_t modifier;           /* The modifier to apply to the parent. */
   uint8_t modifier_type;           /* How to apply the modifier to the parent. (RC_OPERATOR_*) */
+  uint8_t schedule_flags;          /* RC_MODIFIED_MEMREF_SCHEDULE_* */
+  uint8_t is_integer;              /* neither the parent nor the modifier can produce a float */
 }
 rc_modified_memref_t;
 
+enum {
+  RC_MODIFIED_MEMREF_SCHEDULE_REACHABLE = (1 << 0), /* in the current schedule */
+  RC_MODIFIED_MEMREF_SCHEDULE_MARKED = (1 << 1),    /* found while building the schedule */
+  RC_MODIFIED_MEMREF_SCHEDULE_STALE = (1 << 2)      /* not updated since it was dropped from a schedule */
+};
+
 typedef struct rc_memref_list_t {
   rc_memref_t* items;
   struct rc_memref_list_t* next;
@@ -37,9 +45,125 @@ typedef struct rc_modified_memref_list_t {
   uint8_t allocated;
 } rc_modified_memref_list_t;
 
+/* open-addressed hash tables for locating existing memrefs without scanning the lists.
+ * items appended to the source lists after the last tail are indexed on the next lookup. */
+typedef struct rc_memref_index_t {
+  rc_memref_t** memrefs;
+  rc_modified_memref_t** modified_memrefs;
+  const struct rc_memrefs_t* source;
+  const rc_memref_list_t* memrefs_tail;
+  const rc_modified_memref_list_t* modified_memrefs_tail;
+  uint32_t memrefs_capacity;
+  uint32_t memrefs_count;
+  uint32_t modified_memrefs_capacity;
+  uint32_t modified_memrefs_count;
+  uint16_t memrefs_tail_count;
+  uint16_t modified_memrefs_tail_count;
+} rc_memref_index_t;
+
+/* per-pool state for reading memrefs. when fuse_reads is set, the non-invalidated memrefs are sorted
+ * by address, and memrefs whose bytes overlap or abut are served from a single read of up to 32 bits.
+ * the plan is rebuilt whenever memrefs are added or the pool is marked dirty (see rc_memrefs_mark_dirty). */
+typedef struct rc_memref_reads_t {
+  rc_memref_t** memrefs;
+  uint32_t* masks;                 /* mask applied to the shifted read to extract memrefs[n] */
+  uint32_t* read_index;            /* the read memrefs[n] is extracted from */
+  uint32_t* read_addresses;
+  uint32_t* read_values;
+  uint8_t* shifts;                 /* number of bits to shift the read right to extract memrefs[n] */
+  uint8_t* read_sizes;             /* number of bytes to read: 1, 2, or 4 */
+  uint32_t count;
+  uint32_t num_reads;
+  uint32_t capacity;
+  uint32_t source_count;           /* number of memrefs in the pool when last rebuilt */
+  const uint8_t* dirty_pages;      /* bitmap of the pages written since the previous update. see rc_memrefs_set_dirty_pages */
+  uint32_t num_dirty_pages;
+  uint32_t values_count;           /* number of memrefs in the pool when values_current was set */
+  uint8_t dirty_page_shift;
+  uint8_t values_current;          /* the records hold the values read by the previous update */
+  uint8_t dirty;
+  uint8_t fuse_reads;
+} rc_memref_reads_t;
+
+enum {
+  RC_MEMREF_SCHEDULE_MARKED = (1 << 0),  /* found while building the schedule */
+  RC_MEMREF_SCHEDULE_LIVE = (1 << 1),    /* in the current schedule */
+  RC_MEMREF_SCHEDULE_PARKED = (1 << 2)   /* dropped from a schedule. not read until referenced again */
+};
+
+typedef struct rc_memrefs_schedule_chunk_t {
+  const rc_memref_t* items;
+  uint32_t count;
+  uint32_t first_index;
+} rc_memrefs_schedule_chunk_t;
+
+enum {
+  RC_MEMREFS_INDIRECT_GROUP_PENDING,    /* not read yet in the current update */
+  RC_MEMREFS_INDIRECT_GROUP_READ,       /* buffer holds the memory at address */
+  RC_MEMREFS_INDIRECT_GROUP_FAILED      /* could not be read as a whole. members are read individually */
+};
+
+/* indirect reads from the same pointer whose offsets fall within a small span. the span is fetched
+ * with a single read when the first member is updated, and every member is decoded from the buffer */
+typedef struct rc_memrefs_indirect_group_t {
+  const rc_operand_t* parent;
+  uint8_t* buffer;
+  uint32_t first_offset;
+  uint32_t num_bytes;
+  uint32_t address;
+  uint32_t first_member;           /* index into the schedule's indirect_members, sorted by offset */
+  uint32_t num_members;
+  uint8_t state;
+} rc_memrefs_indirect_group_t;
+
+/* the memrefs in a pool that are reachable from the active triggers, leaderboards, and rich presence.
+ * memrefs that aren't reachable are parked and not read until something references them again, at
+ * which point they're re-primed from memory so the first read isn't reported as a change. modified
+ * memrefs are kept in allocation order, which is also dependency order as a modified memref can only
+ * be allocated after its parent and modifier. */
+typedef struct rc_memrefs_schedule_t {
+  rc_modified_memref_t** modified_memrefs;
+  rc_memref_t** memrefs;                /* live memrefs in pool order */
+  rc_memref_t** stale_memrefs;          /* parked memrefs that are live again. primed by the next update */
+  uint8_t* memref_states;               /* RC_MEMREF_SCHEDULE_* for each memref in pool order */
+  rc_memrefs_schedule_chunk_t* chunks;  /* memref lists sorted by address, for finding a memref's index */
+  rc_memrefs_indirect_group_t* indirect_groups;
+  uint32_t* indirect_group_index;       /* for each scheduled modified memref, its indirect group + 1. 0 if not grouped */
+  const rc_modified_memref_t** indirect_members;
+  uint8_t* indirect_buffer;
+  uint32_t num_indirect_groups;
+  uint32_t num_modified_memrefs;
+  uint32_t modified_memrefs_capacity;
+  uint32_t num_memrefs;
+  uint32_t num_stale_memrefs;
+  uint32_t memrefs_capacity;
+  uint32_t num_chunks;
+  uint32_t chunks_capacity;
+  uint8_t dirty;
+} rc_memrefs_schedule_t;
+
+/* comparisons that appear in more than one condition of a runtime's triggers. each one is evaluated
+ * at most once per frame, and every condition that shares it uses the result. see rc_test_condition */
+typedef struct rc_shared_conditions_t {
+  rc_condition_t* conditions;           /* canonical copy of each comparison */
+  uint32_t* references;                 /* number of trigger conditions using each comparison. 0 if the entry is free */
+  uint32_t* free_indices;               /* entries released by deactivated triggers, reused before the table grows */
+  uint32_t* slots;                      /* open addressed hash of the conditions in use. each slot is index + 1 */
+  uint8_t* evaluated;                   /* bitset of the conditions that have been evaluated this frame */
+  uint8_t* results;                     /* bitset of the results of the evaluated conditions */
+  uint32_t count;                       /* number of entries, including the free ones */
+  uint32_t num_free;
+  uint32_t capacity;
+  uint32_t num_slots;
+} rc_shared_conditions_t;
+
 typedef struct rc_memrefs_t {
   rc_memref_list_t memrefs;
   rc_modified_memref_list_t modified_memrefs;
+  /* only allocated for pools created by rc_memrefs_init */
+  rc_memref_index_t* index;
+  rc_memref_reads_t* reads;
+  rc_memrefs_schedule_t* schedule;
 } rc_memrefs_t;
 
 typedef struct rc_trigger_with_memrefs_t {
@@ -62,6 +186,78 @@ typedef struct rc_value_with_memrefs_t {
   rc_memrefs_t memrefs;
 } rc_value_with_memrefs_t;
 
+/* a single instruction of a compiled condset. ops are parallel to the condset's conditions. see rc_condset_compile */
+typedef struct rc_condset_op_t {
+  uint8_t compare;                    /* how to evaluate the condition (RC_CONDSET_COMPARE_*) */
+  uint8_t logic;                      /* how to apply the result (RC_CONDSET_LOGIC_*) */
+  uint8_t mask;                       /* for field compares: the bits of the 8-bit memref to compare */
+  uint8_t expected;                   /* for field compares: the value of the masked bits */
+}
+rc_condset_op_t;
+
+/* a condition (or combining chain) in the "other" segment of a short circuited condset */
+typedef struct rc_condset_selectivity_entry_t {
+  uint16_t index;                     /* offset of the first condition from the start of the segment */
+  uint16_t num_conditions;            /* number of conditions in the chain */
+  uint16_t num_evaluations;           /* times the entry was evaluated since the last decay */
+  uint16_t num_false;                 /* times the entry stopped processing since the last decay */
+  uint8_t cost;                       /* relative cost of evaluating the entry */
+  uint8_t is_independent;             /* non-zero if the entry can be moved within its run */
+}
+rc_condset_selectivity_entry_t;
+
+/* the order in which the "other" segment is evaluated when it can short circuit. consecutive
+ * independent entries are periodically sorted so the ones most likely to be false for the least
+ * cost are evaluated first. see rc_condset_test_selective */
+typedef struct rc_condset_selectivity_t {
+  rc_condset_selectivity_entry_t* entries;
+  uint32_t num_entries;
+  uint32_t num_evaluations;           /* evaluations of the segment since the last reorder */
+}
+rc_condset_selectivity_t;
+
+/* a memref read by a trigger's conditions, and its value when the trigger was last evaluated */
+typedef struct rc_trigger_input_t {
+  const rc_memref_value_t* memref;
+  rc_memref_value_t value;
+}
+rc_trigger_input_t;
+
+/* the state of a condition after the trigger was last evaluated */
+typedef struct rc_trigger_steady_condition_t {
+  rc_condition_t* condition;
+  uint32_t current_hits;
+  uint8_t is_true;
+  uint8_t tally;                      /* non-zero if evaluating increments the hit count */
+}
+rc_trigger_steady_condition_t;
+
+/* the state of a condset after the trigger was last evaluated */
+typedef struct rc_trigger_steady_condset_t {
+  rc_condset_t* condset;
+  uint8_t is_paused;
+}
+rc_trigger_steady_condset_t;
+
+/* tracks the inputs of a trigger whose evaluation doesn't depend on hit counts (no hit targets or
+ * AddHits). if the inputs and the state haven't changed since an evaluation that only tallied hits,
+ * evaluating again will do the same thing, so the tallies can be applied without evaluating.
+ * allocated by the runtime for the triggers it evaluates. see rc_evaluate_trigger_jit */
+typedef struct rc_trigger_steady_t {
+  const rc_trigger_t* trigger;        /* the trigger the state was captured for */
+  rc_trigger_input_t* inputs;
+  rc_trigger_steady_condition_t* conditions;
+  rc_trigger_steady_condset_t* condsets;
+  uint32_t num_inputs;
+  uint32_t num_conditions;
+  uint32_t num_condsets;
+  uint32_t measured_value;
+  uint8_t state;
+  uint8_t has_hits;
+  uint8_t is_steady;                  /* non-zero if the last evaluation only tallied hits */
+}
+rc_trigger_steady_t;
+
 /* enum helpers for natvis expansion. Have to use a struct to define the mapping,
  * and a single field to allow the conditional logic to switch on the value */
 typedef struct __rc_bool_enum_t { uint8_t value; } __rc_bool_enum_t;
@@ -88,6 +284,9 @@ typedef struct __rc_format_enum_t { uint8_t value; } __rc_format_enum_t;
 
 RC_ALLOW_ALIGN(rc_condition_t)
 RC_ALLOW_ALIGN(rc_condset_t)
+RC_ALLOW_ALIGN(rc_condset_op_t)
+RC_ALLOW_ALIGN(rc_condset_selectivity_t)
+RC_ALLOW_ALIGN(rc_condset_selectivity_entry_t)
 RC_ALLOW_ALIGN(rc_modified_memref_t)
 RC_ALLOW_ALIGN(rc_lboard_t)
 RC_ALLOW_ALIGN(rc_lboard_with_memrefs_t)
@@ -133,6 +332,9 @@ typedef struct {
   struct objs {
     rc_condition_t* __rc_condition_t;
     rc_condset_t* __rc_condset_t;
+    rc_condset_op_t* __rc_condset_op_t;
+    rc_condset_selectivity_t* __rc_condset_selectivity_t;
+    rc_condset_selectivity_entry_t* __rc_condset_selectivity_entry_t;
     rc_modified_memref_t* __rc_modified_memref_t;
     rc_lboard_t* __rc_lboard_t;
     rc_lboard_with_memrefs_t* __rc_lboard_with_memrefs_t;
@@ -232,6 +434,10 @@ typedef struct {
 
   /* control settings */
   uint8_t can_short_curcuit;           /* allows logic processing to stop as soon as a false condition is encountered */
+  rc_shared_conditions_t* shared_conditions; /* results of comparisons shared by the runtime's triggers. may be NULL */
+  const uint16_t* shared_indices;      /* one more than the index in shared_conditions of each of the condset's
+                                          conditions, or 0 if not shared. NULL if none are shared */
+  const rc_condition_t* conditions;    /* the conditions array of the condset being evaluated */
 }
 rc_eval_state_t;
 
@@ -243,6 +449,7 @@ typedef struct {
 
   rc_memrefs_t* memrefs;
   rc_memrefs_t* existing_memrefs;
+  rc_memref_index_t* memref_index;
   rc_value_t** variables;
 
   uint32_t measured_target;
@@ -257,6 +464,8 @@ typedef struct {
   uint8_t has_required_hits;
   uint8_t measured_as_percent;
   uint8_t ignore_non_parse_errors;
+  uint8_t optimize;
+  uint8_t track_selectivity;           /* allocate selectivity counters for condsets that will be short circuited */
 }
 rc_parse_state_t;
 
@@ -284,6 +493,9 @@ rc_modified_memref_t* rc_alloc_modified_memref(rc_parse_state_t* parse, uint8_t
                                                uint8_t modifier_type, const rc_operand_t* modifier);
 int rc_parse_memref(const char** memaddr, uint8_t* size, uint32_t* address);
 void rc_update_memref_values(rc_memrefs_t* memrefs, rc_peek_t peek, void* ud);
+void rc_update_modified_memref_values(rc_memrefs_t* memrefs, rc_peek_t peek, void* ud);
+typedef uint32_t(RC_CCONV* rc_read_block_t)(uint32_t address, uint8_t* buffer, uint32_t num_bytes, void* ud);
+void rc_update_modified_memref_values_with_block_reader(rc_memrefs_t* memrefs, rc_peek_t peek, rc_read_block_t read_block, void* ud);
 void rc_update_memref_value(rc_memref_value_t* memref, uint32_t value);
 void rc_get_memref_value(rc_typed_value_t* value, rc_memref_t* memref, int operand_type);
 uint32_t rc_get_modified_memref_value(const rc_modified_memref_t* memref, rc_peek_t peek, void* ud);
@@ -294,15 +506,51 @@ uint32_t rc_peek_value(uint32_t address, uint8_t size, rc_peek_t peek, void* ud)
 
 void rc_memrefs_init(rc_memrefs_t* memrefs);
 void rc_memrefs_destroy(rc_memrefs_t* memrefs);
+void rc_memref_index_destroy(rc_memref_index_t* index);
+void rc_memrefs_mark_dirty(rc_memrefs_t* memrefs);
+void rc_memrefs_set_fuse_reads(rc_memrefs_t* memrefs, int enabled);
+void rc_memrefs_invalidate_values(rc_memrefs_t* memrefs);
+void rc_memrefs_set_dirty_pages(rc_memrefs_t* memrefs, const uint8_t* dirty_pages, uint32_t num_pages, uint32_t page_size);
+void rc_memrefs_begin_update(rc_memrefs_t* memrefs);
+int rc_memrefs_is_memref_clean(const rc_memrefs_t* memrefs, const rc_memref_t* memref);
+int rc_memrefs_is_range_clean(const rc_memrefs_t* memrefs, uint32_t address, uint32_t num_bytes);
+void rc_memrefs_end_update(rc_memrefs_t* memrefs);
+void rc_memrefs_invalidate_schedule(rc_memrefs_t* memrefs);
+int rc_memrefs_begin_schedule(rc_memrefs_t* memrefs);
+void rc_memrefs_mark_operand_reachable(rc_memrefs_t* memrefs, const rc_operand_t* operand);
+void rc_memrefs_mark_trigger_reachable(rc_memrefs_t* memrefs, const rc_trigger_t* trigger);
+void rc_memrefs_mark_lboard_reachable(rc_memrefs_t* memrefs, const rc_lboard_t* lboard);
+void rc_memrefs_mark_richpresence_reachable(rc_memrefs_t* memrefs, const rc_richpresence_t* richpresence);
+void rc_memrefs_end_schedule(rc_memrefs_t* memrefs);
+rc_memref_t** rc_memrefs_get_scheduled_memrefs(const rc_memrefs_t* memrefs, uint32_t* count);
+void rc_memrefs_prime_stale_memrefs(rc_memrefs_t* memrefs, rc_peek_t peek, void* ud);
 uint32_t rc_memrefs_count_memrefs(const rc_memrefs_t* memrefs);
 uint32_t rc_memrefs_count_modified_memrefs(const rc_memrefs_t* memrefs);
 
+struct rc_runtime_t;
+int rc_runtime_schedule_memrefs(struct rc_runtime_t* self);
+/* must be called after the triggers or lboards arrays are modified without going through the runtime */
+void rc_runtime_invalidate_ids(struct rc_runtime_t* self);
+/* releases the state the runtime keeps for each trigger (see rc_runtime_trigger_state_t). must be called
+ * before the triggers array is modified without going through the runtime */
+void rc_runtime_release_trigger_state(struct rc_runtime_t* self);
+
 void rc_parse_trigger_internal(rc_trigger_t* self, const char** memaddr, rc_parse_state_t* parse);
+/* returns NULL if the memory couldn't be allocated */
+rc_trigger_steady_t* rc_trigger_steady_create(const rc_trigger_t* trigger);
+void rc_trigger_steady_destroy(rc_trigger_steady_t* steady);
 int rc_trigger_state_active(int state);
+/* evaluates a trigger whose hit counts don't matter, stopping as soon as the outcome is known */
+int rc_test_trigger_short_circuit(rc_trigger_t* self, rc_peek_t peek, void* ud);
 rc_memrefs_t* rc_trigger_get_memrefs(rc_trigger_t* self);
 
 typedef struct rc_condset_with_trailing_conditions_t {
   rc_condset_t condset;
+#ifndef RC_CONDSET_NO_BYTECODE
+  rc_condset_op_t* ops; /* compiled conditions, one per condition. NULL if not compiled */
+#endif
+  uint8_t has_hits; /* true if any condition may have a non-zero hit count since the set was last reset */
+  uint8_t is_selective; /* true if the evaluation order is tracked when short circuiting. see rc_condset_get_selectivity */
   rc_condition_t conditions[2];
 } rc_condset_with_trailing_conditions_t;
 RC_ALLOW_ALIGN(rc_condset_with_trailing_conditions_t)
@@ -310,8 +558,89 @@ RC_ALLOW_ALIGN(rc_condset_with_trailing_conditions_t)
 rc_condset_t* rc_parse_condset(const char** memaddr, rc_parse_state_t* parse);
 int rc_test_condset(rc_condset_t* self, rc_eval_state_t* eval_state);
 void rc_reset_condset(rc_condset_t* self);
+/* same as rc_reset_condset, but skips condsets that haven't had any hits since they were last reset.
+ * only hit counts tallied by rc_test_condset are tracked, explicit resets should use rc_reset_condset */
+void rc_reset_condset_evaluated(rc_condset_t* self);
 rc_condition_t* rc_condset_get_conditions(rc_condset_t* self);
+/* the number of conditions in the conditions array, excluding the indirect ones */
+uint32_t rc_condset_count_conditions(const rc_condset_t* self);
+/* the evaluation order of a short circuited condset, or NULL if it isn't tracked */
+rc_condset_selectivity_t* rc_condset_get_selectivity(rc_condset_t* self);
 void rc_test_condset_internal(rc_condition_t* condition, uint32_t num_conditions, rc_eval_state_t* eval_state, int can_short_circuit);
+void rc_condset_compile(rc_condset_t* self, rc_parse_state_t* parse);
+
+/* native code for a single segment of a condset. see rc_trigger_jit_compile */
+typedef void (*rc_condset_native_func_t)(rc_eval_state_t* eval_state, rc_condition_t* conditions);
+
+/* NULL for any segment that could not be compiled, which will be processed by the interpreter */
+typedef struct rc_condset_native_t {
+  rc_condset_native_func_t pause;
+  rc_condset_native_func_t reset;
+  rc_condset_native_func_t hittarget;
+  rc_condset_native_func_t measured;
+  rc_condset_native_func_t other;
+}
+rc_condset_native_t;
+
+int rc_test_condset_native(rc_condset_t* self, rc_eval_state_t* eval_state, const rc_condset_native_t* native);
+
+#if !defined(RC_DISABLE_JIT) && defined(__x86_64__) && defined(__linux__)
+ #define RC_TRIGGER_JIT_SUPPORTED 1
+#else
+ #define RC_TRIGGER_JIT_SUPPORTED 0
+#endif
+
+/* executable memory shared by the jits of a runtime */
+typedef struct rc_trigger_jit_pool_t rc_trigger_jit_pool_t;
+
+typedef struct rc_trigger_jit_t {
+  const rc_trigger_t* trigger;      /* the trigger the code was generated for */
+  rc_condset_native_t* condsets;    /* the core group (even if there isn't one), followed by each alt group.
+                                       NULL if nothing could be compiled */
+  uint32_t num_condsets;
+}
+rc_trigger_jit_t;
+
+rc_trigger_jit_pool_t* rc_trigger_jit_pool_create(void);
+/* non-zero if the pool couldn't change the protection of its code. none of the code compiled into
+ * the pool can be evaluated safely, so the pool and its jits have to be destroyed */
+int rc_trigger_jit_pool_failed(const rc_trigger_jit_pool_t* pool);
+/* the code for any jits compiled into the pool is released. they must not be evaluated afterwards */
+void rc_trigger_jit_pool_destroy(rc_trigger_jit_pool_t* pool);
+rc_trigger_jit_t* rc_trigger_jit_compile(const rc_trigger_t* trigger, rc_trigger_jit_pool_t* pool);
+void rc_trigger_jit_destroy(rc_trigger_jit_t* jit);
+int rc_evaluate_trigger_jit(rc_trigger_t* self, rc_peek_t peek, void* ud, const rc_trigger_jit_t* jit,
+                            rc_trigger_steady_t* steady, rc_shared_conditions_t* shared_conditions,
+                            const uint16_t* shared_indices);
+
+/* the state the runtime keeps for the trigger at the same index in rc_runtime_t.triggers */
+typedef struct rc_runtime_trigger_state_t {
+  rc_trigger_jit_t* jit;
+  rc_trigger_steady_t* steady;
+  uint16_t* shared_indices;
+  uint32_t num_shared_indices;
+}
+rc_runtime_trigger_state_t;
+
+/* the parts of a runtime that aren't exposed by rc_runtime_t */
+typedef struct rc_runtime_state_t {
+  rc_runtime_trigger_state_t* triggers;  /* parallel to rc_runtime_t.triggers. unused entries are zeroed */
+  uint32_t trigger_capacity;
+
+  rc_shared_conditions_t* shared_conditions;
+
+  rc_trigger_jit_pool_t* jit_pool;
+
+  struct rc_runtime_id_map_t* trigger_ids;
+  struct rc_runtime_id_map_t* lboard_ids;
+
+  struct rc_runtime_parallel_t* parallel;
+
+  struct rc_runtime_arena_t* arena;
+
+  uint8_t jit_enabled;
+}
+rc_runtime_state_t;
 
 enum {
   RC_PROCESSING_COMPARE_DEFAULT = 0,
@@ -333,6 +662,14 @@ rc_condition_t* rc_parse_condition(const char** memaddr, rc_parse_state_t* parse
 void rc_parse_condition_internal(rc_condition_t* self, const char** memaddr, rc_parse_state_t* parse);
 void rc_condition_update_parse_state(rc_condition_t* condition, rc_parse_state_t* parse);
 int rc_test_condition(rc_condition_t* self, rc_eval_state_t* eval_state);
+int rc_test_condition_compare(uint32_t value1, uint32_t value2, uint8_t oper);
+/* adds the trigger's comparisons to the table. returns the shared indices of its conditions: the core group
+ * first, then each alt group (see rc_eval_state_t.shared_indices). NULL if none of them are shared */
+uint16_t* rc_shared_conditions_index_trigger(rc_shared_conditions_t* self, rc_trigger_t* trigger, uint32_t* num_indices);
+/* removes the references added by rc_shared_conditions_index_trigger. doesn't free the indices */
+void rc_shared_conditions_release(rc_shared_conditions_t* self, const uint16_t* indices, uint32_t num_indices);
+void rc_shared_conditions_begin_frame(rc_shared_conditions_t* self);
+void rc_shared_conditions_destroy(rc_shared_conditions_t* self);
 void rc_evaluate_condition_value(rc_typed_value_t* value, rc_condition_t* self, rc_eval_state_t* eval_state);
 int rc_condition_is_combining(const rc_condition_t* self);
 void rc_condition_convert_to_operand(const rc_condition_t* condition, rc_operand_t* operand, rc_parse_state_t* parse);
@@ -344,6 +681,8 @@ int rc_operator_is_modifying(int oper);
 int rc_memsize_is_float(uint8_t size);
 int rc_operand_is_float_memref(const rc_operand_t* self);
 int rc_operand_is_float(const rc_operand_t* self);
+int rc_operand_is_integer(const rc_operand_t* self);
+uint32_t rc_evaluate_integer_operand(const rc_operand_t* self);
 int rc_operand_is_recall(const rc_operand_t* self);
 int rc_operand_type_is_memref(uint8_t type);
 int rc_operand_type_is_transform(uint8_t type);
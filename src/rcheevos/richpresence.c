@@ -608,8 +608,11 @@ void rc_parse_richpresence_internal(rc_richpresence_t* self, const char* script,
           if (parse->offset < 0)
             return;
 
+          /* displays without hit targets are short circuited. see rc_get_richpresence_display_string */
           trigger = &((*nextdisplay)->trigger);
+          parse->track_selectivity = 1;
           rc_parse_trigger_internal(trigger, &line, parse);
+          parse->track_selectivity = 0;
           if (parse->offset < 0)
             return;
 
@@ -885,15 +888,17 @@ static int rc_evaluate_richpresence_display(rc_richpresence_display_part_t* part
 
 int rc_get_richpresence_display_string(rc_richpresence_t* richpresence, char* buffer, size_t buffersize, rc_peek_t peek, void* peek_ud, void* unused_L) {
   rc_richpresence_display_t* display;
+  (void)unused_L;
 
   for (display = richpresence->first_display; display; display = display->next) {
     /* if we've reached the end of the condition list, process it */
     if (!display->next)
       return rc_evaluate_richpresence_display(display->display, buffer, buffersize);
 
-    /* triggers with required hits will be updated in rc_update_richpresence */
+    /* triggers with required hits will be updated in rc_update_richpresence. the others only
+     * need to know if they're true, so they can stop at the first false condition */
     if (!display->has_required_hits)
-      rc_test_trigger(&display->trigger, peek, peek_ud, unused_L);
+      rc_test_trigger_short_circuit(&display->trigger, peek, peek_ud);
 
     /* if we've found a valid condition, process it */
     if (display->trigger.state == RC_TRIGGER_STATE_TRIGGERED)
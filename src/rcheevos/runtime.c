@@ -51,17 +51,502 @@ void rc_runtime_init(rc_runtime_t* self) {
 
   self->memrefs = (rc_memrefs_t*)malloc(sizeof(*self->memrefs));
   rc_memrefs_init(self->memrefs);
+
+  self->state = (rc_runtime_state_t*)calloc(1, sizeof(*self->state));
+  self->state->shared_conditions = (rc_shared_conditions_t*)calloc(1, sizeof(rc_shared_conditions_t));
 }
 
-void rc_runtime_destroy(rc_runtime_t* self) {
+/* ===== buffers ===== */
+
+/* the buffers for the triggers and lboards are carved out of large chunks so activating a set doesn't
+ * allocate each item separately, and the items are laid out in the order they were activated. buffers
+ * released by deactivation are merged with any free neighbors and kept in a free list, and reused by
+ * later activations that fit in them. a chunk is released as soon as none of it is in use */
+typedef struct rc_runtime_block_info_t {
+  uint32_t size;                      /* size of the block, not including the header */
+  uint32_t prev_size;                 /* size of the previous block in the chunk, 0 for the first block */
+  uint8_t is_free;
+} rc_runtime_block_info_t;
+
+typedef union rc_runtime_block_header_t {
+  rc_runtime_block_info_t info;
+  /* keeps the block aligned for anything the parser allocates in it, and the header size a power of two */
+  double align_double[2];
+  void* align_pointer;
+} rc_runtime_block_header_t;
+
+typedef struct rc_runtime_free_block_t {
+  struct rc_runtime_free_block_t* next;
+  struct rc_runtime_free_block_t* prev;
+} rc_runtime_free_block_t;
+
+/* a chunk holds a sequence of blocks that covers the whole chunk, followed by an empty block that is
+ * never free, so the blocks on either side of any block can be found without knowing its chunk */
+typedef struct rc_runtime_chunk_t {
+  struct rc_runtime_chunk_t* next;
+  struct rc_runtime_chunk_t* prev;
+} rc_runtime_chunk_t;
+
+typedef struct rc_runtime_arena_t {
+  rc_runtime_chunk_t* chunks;
+  rc_runtime_free_block_t* free_blocks;
+} rc_runtime_arena_t;
+
+#define RC_RUNTIME_ARENA_CHUNK_SIZE 65536
+#define RC_RUNTIME_ARENA_MIN_SPLIT 128
+#define RC_RUNTIME_ARENA_ALIGN(size) (((size) + sizeof(rc_runtime_block_header_t) - 1) & ~(sizeof(rc_runtime_block_header_t) - 1))
+#define RC_RUNTIME_ARENA_CHUNK_HEADER_SIZE RC_RUNTIME_ARENA_ALIGN(sizeof(rc_runtime_chunk_t))
+
+static void rc_runtime_arena_destroy(rc_runtime_arena_t* arena) {
+  if (arena) {
+    rc_runtime_chunk_t* chunk = arena->chunks;
+    while (chunk) {
+      rc_runtime_chunk_t* next = chunk->next;
+      free(chunk);
+      chunk = next;
+    }
+
+    free(arena);
+  }
+}
+
+static rc_runtime_block_header_t* rc_runtime_arena_next_block(rc_runtime_block_header_t* header) {
+  return (rc_runtime_block_header_t*)((uint8_t*)(header + 1) + header->info.size);
+}
+
+static rc_runtime_block_header_t* rc_runtime_arena_prev_block(rc_runtime_block_header_t* header) {
+  if (header->info.prev_size == 0)
+    return NULL;
+
+  return (rc_runtime_block_header_t*)((uint8_t*)header - header->info.prev_size) - 1;
+}
+
+static void rc_runtime_arena_add_free_block(rc_runtime_arena_t* arena, rc_runtime_block_header_t* header) {
+  rc_runtime_free_block_t* free_block = (rc_runtime_free_block_t*)(header + 1);
+
+  header->info.is_free = 1;
+  free_block->prev = NULL;
+  free_block->next = arena->free_blocks;
+  if (free_block->next)
+    free_block->next->prev = free_block;
+  arena->free_blocks = free_block;
+}
+
+static void rc_runtime_arena_remove_free_block(rc_runtime_arena_t* arena, rc_runtime_block_header_t* header) {
+  rc_runtime_free_block_t* free_block = (rc_runtime_free_block_t*)(header + 1);
+
+  header->info.is_free = 0;
+  if (free_block->prev)
+    free_block->prev->next = free_block->next;
+  else
+    arena->free_blocks = free_block->next;
+  if (free_block->next)
+    free_block->next->prev = free_block->prev;
+}
+
+static rc_runtime_block_header_t* rc_runtime_arena_add_chunk(rc_runtime_arena_t* arena, uint32_t size) {
+  rc_runtime_block_header_t* header;
+  rc_runtime_block_header_t* end;
+  rc_runtime_chunk_t* chunk;
+
+  chunk = (rc_runtime_chunk_t*)malloc(RC_RUNTIME_ARENA_CHUNK_HEADER_SIZE + size + 2 * sizeof(rc_runtime_block_header_t));
+  if (!chunk)
+    return NULL;
+
+  chunk->prev = NULL;
+  chunk->next = arena->chunks;
+  if (chunk->next)
+    chunk->next->prev = chunk;
+  arena->chunks = chunk;
+
+  header = (rc_runtime_block_header_t*)((uint8_t*)chunk + RC_RUNTIME_ARENA_CHUNK_HEADER_SIZE);
+  header->info.size = size;
+  header->info.prev_size = 0;
+  header->info.is_free = 0;
+
+  end = rc_runtime_arena_next_block(header);
+  end->info.size = 0;
+  end->info.prev_size = size;
+  end->info.is_free = 0;
+
+  return header;
+}
+
+static void rc_runtime_arena_release_chunk(rc_runtime_arena_t* arena, rc_runtime_block_header_t* header) {
+  rc_runtime_chunk_t* chunk = (rc_runtime_chunk_t*)((uint8_t*)header - RC_RUNTIME_ARENA_CHUNK_HEADER_SIZE);
+
+  if (chunk->prev)
+    chunk->prev->next = chunk->next;
+  else
+    arena->chunks = chunk->next;
+  if (chunk->next)
+    chunk->next->prev = chunk->prev;
+
+  free(chunk);
+}
+
+static rc_runtime_block_header_t* rc_runtime_arena_alloc_block(rc_runtime_arena_t* arena, uint32_t size) {
+  rc_runtime_free_block_t* free_block = arena->free_blocks;
+  rc_runtime_block_header_t* header = NULL;
+  rc_runtime_block_header_t* remainder;
+
+  for (; free_block; free_block = free_block->next) {
+    if (((rc_runtime_block_header_t*)free_block - 1)->info.size >= size) {
+      header = (rc_runtime_block_header_t*)free_block - 1;
+      rc_runtime_arena_remove_free_block(arena, header);
+      break;
+    }
+  }
+
+  if (!header) {
+    /* a large block gets its own chunk, which is released as soon as the block is */
+    header = rc_runtime_arena_add_chunk(arena, (size > RC_RUNTIME_ARENA_CHUNK_SIZE / 4) ? size : RC_RUNTIME_ARENA_CHUNK_SIZE);
+    if (!header)
+      return NULL;
+  }
+
+  /* if the block is much larger than needed, put the rest of it back in the free list. the block after
+   * this one can't be free, or it would have been merged into this one */
+  if (header->info.size - size >= RC_RUNTIME_ARENA_MIN_SPLIT) {
+    remainder = (rc_runtime_block_header_t*)((uint8_t*)(header + 1) + size);
+    remainder->info.size = header->info.size - size - sizeof(rc_runtime_block_header_t);
+    remainder->info.prev_size = size;
+    rc_runtime_arena_next_block(remainder)->info.prev_size = remainder->info.size;
+    header->info.size = size;
+    rc_runtime_arena_add_free_block(arena, remainder);
+  }
+
+  return header;
+}
+
+static void rc_runtime_arena_free_block(rc_runtime_arena_t* arena, rc_runtime_block_header_t* header) {
+  rc_runtime_block_header_t* neighbor = rc_runtime_arena_next_block(header);
+
+  if (neighbor->info.is_free) {
+    rc_runtime_arena_remove_free_block(arena, neighbor);
+    header->info.size += (uint32_t)sizeof(rc_runtime_block_header_t) + neighbor->info.size;
+  }
+
+  neighbor = rc_runtime_arena_prev_block(header);
+  if (neighbor && neighbor->info.is_free) {
+    rc_runtime_arena_remove_free_block(arena, neighbor);
+    neighbor->info.size += (uint32_t)sizeof(rc_runtime_block_header_t) + header->info.size;
+    header = neighbor;
+  }
+
+  neighbor = rc_runtime_arena_next_block(header);
+  neighbor->info.prev_size = header->info.size;
+
+  /* the first block is only followed by the end of the chunk when nothing else in the chunk is in use */
+  if (header->info.prev_size == 0 && neighbor->info.size == 0)
+    rc_runtime_arena_release_chunk(arena, header);
+  else
+    rc_runtime_arena_add_free_block(arena, header);
+}
+
+static void* rc_runtime_alloc_buffer(rc_runtime_t* self, int32_t size) {
+  rc_runtime_arena_t* arena = self->state->arena;
+  rc_runtime_block_header_t* header;
+  uint32_t block_size;
+
+  if (!arena) {
+    arena = (rc_runtime_arena_t*)calloc(1, sizeof(rc_runtime_arena_t));
+    if (!arena)
+      return NULL;
+
+    self->state->arena = arena;
+  }
+
+  /* a free block has to be able to hold the free list pointers */
+  block_size = (size < (int32_t)sizeof(rc_runtime_free_block_t)) ? (uint32_t)sizeof(rc_runtime_free_block_t) : (uint32_t)size;
+  block_size = (uint32_t)RC_RUNTIME_ARENA_ALIGN(block_size);
+
+  header = rc_runtime_arena_alloc_block(arena, block_size);
+  return header ? header + 1 : NULL;
+}
+
+static void rc_runtime_free_buffer(rc_runtime_t* self, void* buffer) {
+  /* the legacy runtime arrays updated by rc_client don't have buffers */
+  if (!buffer || !self->state->arena)
+    return;
+
+  rc_runtime_arena_free_block(self->state->arena, ((rc_runtime_block_header_t*)buffer) - 1);
+}
+
+/* ===== id maps ===== */
+
+/* an open addressing map from an id to the index of the active trigger or lboard with that id, so they
+ * can be found without scanning the arrays. the arrays are still the source of truth. if the map can't
+ * be allocated, or the array was modified without updating it, the array is scanned instead */
+typedef struct rc_runtime_id_slot_t {
+  uint32_t id;
+  uint32_t index;                     /* index of the entry + 1. 0 if the slot is empty */
+} rc_runtime_id_slot_t;
+
+typedef struct rc_runtime_id_map_t {
+  rc_runtime_id_slot_t* slots;
+  uint32_t capacity;                  /* always a power of two, and at least twice count */
+  uint32_t count;
+  uint8_t is_valid;                   /* 0 if the map has to be rebuilt from the array before it's used */
+} rc_runtime_id_map_t;
+
+#define RC_RUNTIME_ID_MAP_MIN_CAPACITY 64
+
+static uint32_t rc_runtime_id_map_home(const rc_runtime_id_map_t* map, uint32_t id) {
+  /* ids are usually sequential. mix them so neighbors don't collide in the low bits */
+  id ^= id >> 16;
+  id *= 0x45D9F3BU;
+  id ^= id >> 16;
+  return id & (map->capacity - 1);
+}
+
+static uint32_t rc_runtime_id_map_find(const rc_runtime_id_map_t* map, uint32_t id) {
+  /* returns the slot containing id, or the empty slot where it would be added */
+  const uint32_t mask = map->capacity - 1;
+  uint32_t i = rc_runtime_id_map_home(map, id);
+
+  while (map->slots[i].index && map->slots[i].id != id)
+    i = (i + 1) & mask;
+
+  return i;
+}
+
+static int rc_runtime_id_map_grow(rc_runtime_id_map_t* map) {
+  rc_runtime_id_slot_t* old_slots = map->slots;
+  const uint32_t old_capacity = map->capacity;
   uint32_t i;
 
-  if (self->triggers) {
-    for (i = 0; i < self->trigger_count; ++i) {
-      if (self->triggers[i].buffer)
-        free(self->triggers[i].buffer);
+  map->capacity = old_capacity ? old_capacity * 2 : RC_RUNTIME_ID_MAP_MIN_CAPACITY;
+  map->slots = (rc_runtime_id_slot_t*)calloc(map->capacity, sizeof(rc_runtime_id_slot_t));
+  if (!map->slots) {
+    map->slots = old_slots;
+    map->capacity = old_capacity;
+    return 0;
+  }
+
+  for (i = 0; i < old_capacity; ++i) {
+    if (old_slots[i].index)
+      memcpy(&map->slots[rc_runtime_id_map_find(map, old_slots[i].id)], &old_slots[i], sizeof(rc_runtime_id_slot_t));
+  }
+
+  free(old_slots);
+  return 1;
+}
+
+static int rc_runtime_id_map_add(rc_runtime_id_map_t* map, uint32_t id, uint32_t index) {
+  uint32_t i;
+
+  if ((map->count + 1) * 2 > map->capacity && !rc_runtime_id_map_grow(map))
+    return 0;
+
+  i = rc_runtime_id_map_find(map, id);
+  if (map->slots[i].index) /* only one entry per id can be mapped */
+    return 0;
+
+  map->slots[i].id = id;
+  map->slots[i].index = index + 1;
+  ++map->count;
+  return 1;
+}
+
+static void rc_runtime_id_map_remove(rc_runtime_id_map_t* map, uint32_t id, uint32_t index) {
+  const uint32_t mask = map->capacity - 1;
+  uint32_t i, j, home;
+
+  i = rc_runtime_id_map_find(map, id);
+  if (map->slots[i].index != index + 1)
+    return;
+
+  /* move later entries of the probe sequence into the hole so finding them doesn't stop at it. an
+   * entry can be moved if its home slot isn't between the hole and where it is now */
+  for (j = (i + 1) & mask; map->slots[j].index; j = (j + 1) & mask) {
+    home = rc_runtime_id_map_home(map, map->slots[j].id);
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      memcpy(&map->slots[i], &map->slots[j], sizeof(rc_runtime_id_slot_t));
+      i = j;
     }
+  }
+
+  map->slots[i].index = 0;
+  --map->count;
+}
+
+static void rc_runtime_id_map_move(rc_runtime_id_map_t* map, uint32_t id, uint32_t from_index, uint32_t to_index) {
+  const uint32_t i = rc_runtime_id_map_find(map, id);
+  if (map->slots[i].index == from_index + 1)
+    map->slots[i].index = to_index + 1;
+}
+
+static rc_runtime_id_map_t* rc_runtime_id_map_begin_rebuild(rc_runtime_id_map_t** map) {
+  if (!*map) {
+    *map = (rc_runtime_id_map_t*)calloc(1, sizeof(rc_runtime_id_map_t));
+    if (!*map)
+      return NULL;
+  }
+
+  if ((*map)->slots)
+    memset((*map)->slots, 0, (*map)->capacity * sizeof(rc_runtime_id_slot_t));
+  else if (!rc_runtime_id_map_grow(*map))
+    return NULL;
+
+  (*map)->count = 0;
+  return *map;
+}
+
+static void rc_runtime_id_map_destroy(rc_runtime_id_map_t* map) {
+  if (map) {
+    free(map->slots);
+    free(map);
+  }
+}
+
+void rc_runtime_invalidate_ids(rc_runtime_t* self) {
+  rc_runtime_state_t* state = self->state;
+
+  if (state->trigger_ids)
+    state->trigger_ids->is_valid = 0;
+  if (state->lboard_ids)
+    state->lboard_ids->is_valid = 0;
+}
+
+static rc_runtime_id_map_t* rc_runtime_get_trigger_ids(rc_runtime_t* self) {
+  rc_runtime_id_map_t* map = self->state->trigger_ids;
+  uint32_t i;
+
+  if (map && map->is_valid)
+    return map;
+
+  map = rc_runtime_id_map_begin_rebuild(&self->state->trigger_ids);
+  if (!map)
+    return NULL;
+
+  /* only map the array if every entry is active and has a unique id. otherwise, keep scanning it */
+  for (i = 0; i < self->trigger_count; ++i) {
+    if (!self->triggers[i].trigger || !rc_runtime_id_map_add(map, self->triggers[i].id, i))
+      return NULL;
+  }
+
+  map->is_valid = 1;
+  return map;
+}
+
+static rc_runtime_id_map_t* rc_runtime_get_lboard_ids(rc_runtime_t* self) {
+  rc_runtime_id_map_t* map = self->state->lboard_ids;
+  uint32_t i;
 
+  if (map && map->is_valid)
+    return map;
+
+  map = rc_runtime_id_map_begin_rebuild(&self->state->lboard_ids);
+  if (!map)
+    return NULL;
+
+  /* only map the array if every entry is active and has a unique id. otherwise, keep scanning it */
+  for (i = 0; i < self->lboard_count; ++i) {
+    if (!self->lboards[i].lboard || !rc_runtime_id_map_add(map, self->lboards[i].id, i))
+      return NULL;
+  }
+
+  map->is_valid = 1;
+  return map;
+}
+
+static int rc_runtime_find_trigger(const rc_runtime_t* self, uint32_t id) {
+  const rc_runtime_id_map_t* map = self->state->trigger_ids;
+  uint32_t i;
+
+  if (map && map->is_valid) {
+    i = map->slots[rc_runtime_id_map_find(map, id)].index;
+    if (i == 0)
+      return -1;
+
+    if (--i < self->trigger_count && self->triggers[i].id == id && self->triggers[i].trigger != NULL)
+      return (int)i;
+
+    /* the array was modified without updating the map */
+  }
+
+  for (i = 0; i < self->trigger_count; ++i) {
+    if (self->triggers[i].id == id && self->triggers[i].trigger != NULL)
+      return (int)i;
+  }
+
+  return -1;
+}
+
+static int rc_runtime_find_lboard(const rc_runtime_t* self, uint32_t id) {
+  const rc_runtime_id_map_t* map = self->state->lboard_ids;
+  uint32_t i;
+
+  if (map && map->is_valid) {
+    i = map->slots[rc_runtime_id_map_find(map, id)].index;
+    if (i == 0)
+      return -1;
+
+    if (--i < self->lboard_count && self->lboards[i].id == id && self->lboards[i].lboard != NULL)
+      return (int)i;
+
+    /* the array was modified without updating the map */
+  }
+
+  for (i = 0; i < self->lboard_count; ++i) {
+    if (self->lboards[i].id == id && self->lboards[i].lboard != NULL)
+      return (int)i;
+  }
+
+  return -1;
+}
+
+/* ===== trigger state ===== */
+
+/* makes sure there's a state for each of the first count triggers. new states are zeroed */
+static int rc_runtime_reserve_trigger_states(rc_runtime_state_t* state, uint32_t count) {
+  rc_runtime_trigger_state_t* triggers;
+  uint32_t capacity;
+
+  if (count <= state->trigger_capacity)
+    return 1;
+
+  capacity = (count + 31) & ~31;
+  triggers = (rc_runtime_trigger_state_t*)realloc(state->triggers, capacity * sizeof(rc_runtime_trigger_state_t));
+  if (!triggers)
+    return 0;
+
+  memset(&triggers[state->trigger_capacity], 0, (capacity - state->trigger_capacity) * sizeof(rc_runtime_trigger_state_t));
+  state->triggers = triggers;
+  state->trigger_capacity = capacity;
+  return 1;
+}
+
+static rc_runtime_trigger_state_t* rc_runtime_get_trigger_state(const rc_runtime_t* self, uint32_t index) {
+  return (index < self->state->trigger_capacity) ? &self->state->triggers[index] : NULL;
+}
+
+static void rc_runtime_release_trigger_state_at(rc_runtime_state_t* state, rc_runtime_trigger_state_t* trigger_state) {
+  rc_trigger_jit_destroy(trigger_state->jit);
+  rc_trigger_steady_destroy(trigger_state->steady);
+  if (trigger_state->shared_indices) {
+    /* lets the table reuse comparisons that no other trigger makes */
+    rc_shared_conditions_release(state->shared_conditions, trigger_state->shared_indices, trigger_state->num_shared_indices);
+    free(trigger_state->shared_indices);
+  }
+
+  memset(trigger_state, 0, sizeof(*trigger_state));
+}
+
+void rc_runtime_release_trigger_state(rc_runtime_t* self) {
+  uint32_t i;
+
+  for (i = 0; i < self->state->trigger_capacity; ++i)
+    rc_runtime_release_trigger_state_at(self->state, &self->state->triggers[i]);
+}
+
+/* ============================= */
+
+void rc_runtime_destroy(rc_runtime_t* self) {
+  rc_runtime_state_t* state = self->state;
+
+  if (self->triggers) {
     free(self->triggers);
     self->triggers = NULL;
 
@@ -69,11 +554,6 @@ void rc_runtime_destroy(rc_runtime_t* self) {
   }
 
   if (self->lboards) {
-    for (i = 0; i < self->lboard_count; ++i) {
-      if (self->lboards[i].buffer)
-        free(self->lboards[i].buffer);
-    }
-
     free(self->lboards);
     self->lboards = NULL;
 
@@ -86,6 +566,28 @@ void rc_runtime_destroy(rc_runtime_t* self) {
     free(self->richpresence);
   }
 
+  if (state) {
+    if (state->triggers) {
+      rc_runtime_release_trigger_state(self);
+      free(state->triggers);
+    }
+
+    rc_trigger_jit_pool_destroy(state->jit_pool);
+
+    rc_runtime_id_map_destroy(state->trigger_ids);
+    rc_runtime_id_map_destroy(state->lboard_ids);
+
+    rc_runtime_set_deferred_parallel_for(self, NULL, NULL);
+
+    /* the trigger and lboard buffers are released with the chunks they were allocated from */
+    rc_runtime_arena_destroy(state->arena);
+
+    rc_shared_conditions_destroy(state->shared_conditions);
+
+    free(state);
+    self->state = NULL;
+  }
+
   if (self->memrefs)
     rc_memrefs_destroy(self->memrefs);
 
@@ -101,61 +603,80 @@ void rc_runtime_checksum(const char* memaddr, uint8_t* md5) {
 }
 
 static void rc_runtime_deactivate_trigger_by_index(rc_runtime_t* self, uint32_t index) {
+  rc_runtime_state_t* state = self->state;
+  rc_runtime_id_map_t* map = (state->trigger_ids && state->trigger_ids->is_valid) ? state->trigger_ids : NULL;
+
   /* free the trigger, then replace it with the last trigger */
-  free(self->triggers[index].buffer);
+  rc_runtime_free_buffer(self, self->triggers[index].buffer);
+  if (index < state->trigger_capacity)
+    rc_runtime_release_trigger_state_at(state, &state->triggers[index]);
+  rc_memrefs_invalidate_schedule(self->memrefs);
+
+  if (map)
+    rc_runtime_id_map_remove(map, self->triggers[index].id, index);
 
-  if (--self->trigger_count > index)
+  if (--self->trigger_count > index) {
     memcpy(&self->triggers[index], &self->triggers[self->trigger_count], sizeof(rc_runtime_trigger_t));
+
+    /* the vacated slot is left zeroed for the next trigger */
+    if (self->trigger_count < state->trigger_capacity) {
+      memcpy(&state->triggers[index], &state->triggers[self->trigger_count], sizeof(rc_runtime_trigger_state_t));
+      memset(&state->triggers[self->trigger_count], 0, sizeof(rc_runtime_trigger_state_t));
+    }
+
+    if (map)
+      rc_runtime_id_map_move(map, self->triggers[index].id, self->trigger_count, index);
+  }
 }
 
 void rc_runtime_deactivate_achievement(rc_runtime_t* self, uint32_t id) {
-  uint32_t i;
+  int i;
 
-  for (i = 0; i < self->trigger_count; ++i) {
-    if (self->triggers[i].id == id && self->triggers[i].trigger != NULL)
-      rc_runtime_deactivate_trigger_by_index(self, i);
-  }
+  while ((i = rc_runtime_find_trigger(self, id)) >= 0)
+    rc_runtime_deactivate_trigger_by_index(self, (uint32_t)i);
 }
 
 int rc_runtime_activate_achievement(rc_runtime_t* self, uint32_t id, const char* memaddr, void* unused_L, int unused_funcs_idx) {
   void* trigger_buffer;
   rc_trigger_t* trigger;
   rc_runtime_trigger_t* runtime_trigger;
+  rc_runtime_trigger_state_t* trigger_state;
   rc_preparse_state_t preparse;
+  rc_runtime_id_map_t* ids;
   const char* preparse_memaddr = memaddr;
   uint8_t md5[16];
   int32_t size;
   uint32_t i;
+  int index;
 
   (void)unused_L;
   (void)unused_funcs_idx;
 
+  rc_memrefs_invalidate_schedule(self->memrefs);
+
   if (memaddr == NULL)
     return RC_INVALID_MEMORY_OPERAND;
 
   rc_runtime_checksum(memaddr, md5);
-
-  /* check to see if the id is already registered with an active trigger */
-  for (i = 0; i < self->trigger_count; ++i) {
-    if (self->triggers[i].id == id && self->triggers[i].trigger != NULL) {
-      if (memcmp(self->triggers[i].md5, md5, 16) == 0) {
-        /* if the checksum hasn't changed, we can reuse the existing item */
-        rc_reset_trigger(self->triggers[i].trigger);
-        return RC_OK;
-      }
-
-      /* checksum has changed, deactivate the the item */
-      rc_runtime_deactivate_trigger_by_index(self, i);
-
-      /* deactivate may reorder the list so we should continue from the current index. however, we
-       * assume that only one trigger is active per id, so having found that, just stop scanning.
-       */
-      break;
+  ids = rc_runtime_get_trigger_ids(self);
+
+  /* check to see if the id is already registered with an active trigger. we assume that only one
+   * trigger is active per id */
+  index = rc_runtime_find_trigger(self, id);
+  if (index >= 0) {
+    if (memcmp(self->triggers[index].md5, md5, 16) == 0) {
+      /* if the checksum hasn't changed, we can reuse the existing item */
+      rc_reset_trigger(self->triggers[index].trigger);
+      return RC_OK;
     }
+
+    /* checksum has changed, deactivate the the item */
+    rc_runtime_deactivate_trigger_by_index(self, (uint32_t)index);
   }
 
-  /* check to see if a disabled trigger for the specific id matches the trigger being registered */
-  for (i = 0; i < self->trigger_count; ++i) {
+  /* check to see if a disabled trigger for the specific id matches the trigger being registered.
+   * the array can only have disabled triggers if it isn't mapped */
+  for (i = 0; i < self->trigger_count && !ids; ++i) {
     if (self->triggers[i].id == id && memcmp(self->triggers[i].md5, md5, 16) == 0) {
       /* retrieve the trigger pointer from the buffer */
       size = 0;
@@ -174,12 +695,16 @@ int rc_runtime_activate_achievement(rc_runtime_t* self, uint32_t id, const char*
   rc_parse_trigger_internal(trigger, &preparse_memaddr, &preparse.parse);
 
   size = preparse.parse.offset;
-  if (size < 0)
+  if (size < 0) {
+    rc_destroy_preparse_state(&preparse);
     return size;
+  }
 
-  trigger_buffer = malloc(size);
-  if (!trigger_buffer)
+  trigger_buffer = rc_runtime_alloc_buffer(self, size);
+  if (!trigger_buffer) {
+    rc_destroy_preparse_state(&preparse);
     return RC_OUT_OF_MEMORY;
+  }
 
   /* populate the item, using the communal memrefs pool */
   rc_reset_parse_state(&preparse.parse, trigger_buffer);
@@ -189,10 +714,15 @@ int rc_runtime_activate_achievement(rc_runtime_t* self, uint32_t id, const char*
   rc_destroy_preparse_state(&preparse);
 
   if (preparse.parse.offset < 0) {
-    free(trigger_buffer);
+    rc_runtime_free_buffer(self, trigger_buffer);
     return preparse.parse.offset;
   }
 
+  if (!rc_runtime_reserve_trigger_states(self->state, self->trigger_count + 1)) {
+    rc_runtime_free_buffer(self, trigger_buffer);
+    return RC_OUT_OF_MEMORY;
+  }
+
   /* grow the trigger buffer if necessary */
   if (self->trigger_count == self->trigger_capacity) {
     self->trigger_capacity += 32;
@@ -202,7 +732,7 @@ int rc_runtime_activate_achievement(rc_runtime_t* self, uint32_t id, const char*
       self->triggers = (rc_runtime_trigger_t*)realloc(self->triggers, self->trigger_capacity * sizeof(rc_runtime_trigger_t));
 
     if (!self->triggers) {
-      free(trigger_buffer);
+      rc_runtime_free_buffer(self, trigger_buffer);
       return RC_OUT_OF_MEMORY;
     }
   }
@@ -215,8 +745,17 @@ int rc_runtime_activate_achievement(rc_runtime_t* self, uint32_t id, const char*
   runtime_trigger->invalid_memref = NULL;
   memcpy(runtime_trigger->md5, md5, 16);
   runtime_trigger->serialized_size = 0;
+
+  /* comparisons that other triggers also make only need to be evaluated once per frame */
+  trigger_state = &self->state->triggers[self->trigger_count];
+  rc_runtime_release_trigger_state_at(self->state, trigger_state);
+  trigger_state->shared_indices = rc_shared_conditions_index_trigger(self->state->shared_conditions, trigger,
+                                                                     &trigger_state->num_shared_indices);
   ++self->trigger_count;
 
+  if (ids && !rc_runtime_id_map_add(ids, id, self->trigger_count - 1))
+    ids->is_valid = 0;
+
   /* reset it, and return it */
   rc_reset_trigger(trigger);
   return RC_OK;
@@ -224,14 +763,8 @@ int rc_runtime_activate_achievement(rc_runtime_t* self, uint32_t id, const char*
 
 rc_trigger_t* rc_runtime_get_achievement(const rc_runtime_t* self, uint32_t id)
 {
-  uint32_t i;
-
-  for (i = 0; i < self->trigger_count; ++i) {
-    if (self->triggers[i].id == id && self->triggers[i].trigger != NULL)
-      return self->triggers[i].trigger;
-  }
-
-  return NULL;
+  const int i = rc_runtime_find_trigger(self, id);
+  return (i >= 0) ? self->triggers[i].trigger : NULL;
 }
 
 int rc_runtime_get_achievement_measured(const rc_runtime_t* runtime, uint32_t id, unsigned* measured_value, unsigned* measured_target)
@@ -285,20 +818,28 @@ int rc_runtime_format_achievement_measured(const rc_runtime_t* runtime, uint32_t
 }
 
 static void rc_runtime_deactivate_lboard_by_index(rc_runtime_t* self, uint32_t index) {
+  rc_runtime_id_map_t* map = (self->state->lboard_ids && self->state->lboard_ids->is_valid) ? self->state->lboard_ids : NULL;
+
   /* free the lboard, then replace it with the last lboard */
-  free(self->lboards[index].buffer);
+  rc_runtime_free_buffer(self, self->lboards[index].buffer);
+  rc_memrefs_invalidate_schedule(self->memrefs);
+
+  if (map)
+    rc_runtime_id_map_remove(map, self->lboards[index].id, index);
 
-  if (--self->lboard_count > index)
+  if (--self->lboard_count > index) {
     memcpy(&self->lboards[index], &self->lboards[self->lboard_count], sizeof(rc_runtime_lboard_t));
+
+    if (map)
+      rc_runtime_id_map_move(map, self->lboards[index].id, self->lboard_count, index);
+  }
 }
 
 void rc_runtime_deactivate_lboard(rc_runtime_t* self, uint32_t id) {
-  uint32_t i;
+  int i;
 
-  for (i = 0; i < self->lboard_count; ++i) {
-    if (self->lboards[i].id == id && self->lboards[i].lboard != NULL)
-      rc_runtime_deactivate_lboard_by_index(self, i);
-  }
+  while ((i = rc_runtime_find_lboard(self, id)) >= 0)
+    rc_runtime_deactivate_lboard_by_index(self, (uint32_t)i);
 }
 
 int rc_runtime_activate_lboard(rc_runtime_t* self, uint32_t id, const char* memaddr, void* unused_L, int unused_funcs_idx) {
@@ -307,38 +848,39 @@ int rc_runtime_activate_lboard(rc_runtime_t* self, uint32_t id, const char* mema
   rc_lboard_t* lboard;
   rc_preparse_state_t preparse;
   rc_runtime_lboard_t* runtime_lboard;
+  rc_runtime_id_map_t* ids;
   int32_t size;
   uint32_t i;
+  int index;
 
   (void)unused_L;
   (void)unused_funcs_idx;
 
+  rc_memrefs_invalidate_schedule(self->memrefs);
+
   if (memaddr == 0)
     return RC_INVALID_MEMORY_OPERAND;
 
   rc_runtime_checksum(memaddr, md5);
-
-  /* check to see if the id is already registered with an active lboard */
-  for (i = 0; i < self->lboard_count; ++i) {
-    if (self->lboards[i].id == id && self->lboards[i].lboard != NULL) {
-      if (memcmp(self->lboards[i].md5, md5, 16) == 0) {
-        /* if the checksum hasn't changed, we can reuse the existing item */
-        rc_reset_lboard(self->lboards[i].lboard);
-        return RC_OK;
-      }
-
-      /* checksum has changed, deactivate the the item */
-      rc_runtime_deactivate_lboard_by_index(self, i);
-
-      /* deactivate may reorder the list so we should continue from the current index. however, we
-       * assume that only one trigger is active per id, so having found that, just stop scanning.
-       */
-      break;
+  ids = rc_runtime_get_lboard_ids(self);
+
+  /* check to see if the id is already registered with an active lboard. we assume that only one
+   * lboard is active per id */
+  index = rc_runtime_find_lboard(self, id);
+  if (index >= 0) {
+    if (memcmp(self->lboards[index].md5, md5, 16) == 0) {
+      /* if the checksum hasn't changed, we can reuse the existing item */
+      rc_reset_lboard(self->lboards[index].lboard);
+      return RC_OK;
     }
+
+    /* checksum has changed, deactivate the the item */
+    rc_runtime_deactivate_lboard_by_index(self, (uint32_t)index);
   }
 
-  /* check to see if a disabled lboard for the specific id matches the lboard being registered */
-  for (i = 0; i < self->lboard_count; ++i) {
+  /* check to see if a disabled lboard for the specific id matches the lboard being registered.
+   * the array can only have disabled lboards if it isn't mapped */
+  for (i = 0; i < self->lboard_count && !ids; ++i) {
     if (self->lboards[i].id == id && memcmp(self->lboards[i].md5, md5, 16) == 0) {
       /* retrieve the lboard pointer from the buffer */
       size = 0;
@@ -357,12 +899,16 @@ int rc_runtime_activate_lboard(rc_runtime_t* self, uint32_t id, const char* mema
   rc_parse_lboard_internal(lboard, memaddr, &preparse.parse);
 
   size = preparse.parse.offset;
-  if (size < 0)
+  if (size < 0) {
+    rc_destroy_preparse_state(&preparse);
     return size;
+  }
 
-  lboard_buffer = malloc(size);
-  if (!lboard_buffer)
+  lboard_buffer = rc_runtime_alloc_buffer(self, size);
+  if (!lboard_buffer) {
+    rc_destroy_preparse_state(&preparse);
     return RC_OUT_OF_MEMORY;
+  }
 
   /* populate the item, using the communal memrefs pool */
   rc_reset_parse_state(&preparse.parse, lboard_buffer);
@@ -372,7 +918,7 @@ int rc_runtime_activate_lboard(rc_runtime_t* self, uint32_t id, const char* mema
   rc_destroy_preparse_state(&preparse);
 
   if (preparse.parse.offset < 0) {
-    free(lboard_buffer);
+    rc_runtime_free_buffer(self, lboard_buffer);
     return preparse.parse.offset;
   }
 
@@ -385,7 +931,7 @@ int rc_runtime_activate_lboard(rc_runtime_t* self, uint32_t id, const char* mema
       self->lboards = (rc_runtime_lboard_t*)realloc(self->lboards, self->lboard_capacity * sizeof(rc_runtime_lboard_t));
 
     if (!self->lboards) {
-      free(lboard_buffer);
+      rc_runtime_free_buffer(self, lboard_buffer);
       return RC_OUT_OF_MEMORY;
     }
   }
@@ -400,6 +946,9 @@ int rc_runtime_activate_lboard(rc_runtime_t* self, uint32_t id, const char* mema
   memcpy(runtime_lboard->md5, md5, 16);
   runtime_lboard->serialized_size = 0;
 
+  if (ids && !rc_runtime_id_map_add(ids, id, self->lboard_count - 1))
+    ids->is_valid = 0;
+
   /* reset it, and return it */
   rc_reset_lboard(lboard);
   return RC_OK;
@@ -407,14 +956,8 @@ int rc_runtime_activate_lboard(rc_runtime_t* self, uint32_t id, const char* mema
 
 rc_lboard_t* rc_runtime_get_lboard(const rc_runtime_t* self, uint32_t id)
 {
-  uint32_t i;
-
-  for (i = 0; i < self->lboard_count; ++i) {
-    if (self->lboards[i].id == id && self->lboards[i].lboard != NULL)
-      return self->lboards[i].lboard;
-  }
-
-  return NULL;
+  const int i = rc_runtime_find_lboard(self, id);
+  return (i >= 0) ? self->lboards[i].lboard : NULL;
 }
 
 int rc_runtime_format_lboard_value(char* buffer, int size, int32_t value, int format)
@@ -431,6 +974,8 @@ int rc_runtime_activate_richpresence(rc_runtime_t* self, const char* script, voi
   (void)unused_L;
   (void)unused_funcs_idx;
 
+  rc_memrefs_invalidate_schedule(self->memrefs);
+
   if (script == NULL)
     return RC_MISSING_DISPLAY_STRING;
 
@@ -453,8 +998,10 @@ int rc_runtime_activate_richpresence(rc_runtime_t* self, const char* script, voi
   rc_parse_richpresence_internal(richpresence, script, &preparse.parse);
 
   size = preparse.parse.offset;
-  if (size < 0)
+  if (size < 0) {
+    rc_destroy_preparse_state(&preparse);
     return size;
+  }
 
   /* if there's a previous script, free it */
   if (self->richpresence) {
@@ -464,14 +1011,18 @@ int rc_runtime_activate_richpresence(rc_runtime_t* self, const char* script, voi
 
   /* allocate and process the new script */
   self->richpresence = (rc_runtime_richpresence_t*)malloc(sizeof(rc_runtime_richpresence_t));
-  if (!self->richpresence)
+  if (!self->richpresence) {
+    rc_destroy_preparse_state(&preparse);
     return RC_OUT_OF_MEMORY;
+  }
 
   memcpy(self->richpresence->md5, md5, sizeof(md5));
 
   self->richpresence->buffer = malloc(size);
-  if (!self->richpresence->buffer)
+  if (!self->richpresence->buffer) {
+    rc_destroy_preparse_state(&preparse);
     return RC_OUT_OF_MEMORY;
+  }
 
   rc_reset_parse_state(&preparse.parse, self->richpresence->buffer);
   rc_preparse_reserve_memrefs(&preparse, self->memrefs);
@@ -508,174 +1059,515 @@ int rc_runtime_get_richpresence(const rc_runtime_t* self, char* buffer, size_t b
   return 0;
 }
 
-void rc_runtime_do_frame(rc_runtime_t* self, rc_runtime_event_handler_t event_handler, rc_runtime_peek_t peek, void* ud, void* unused_L) {
-  rc_runtime_event_t runtime_event;
-  int i;
+int rc_runtime_schedule_memrefs(rc_runtime_t* self) {
+  rc_memrefs_t* memrefs = self->memrefs;
+  uint32_t i;
 
-  runtime_event.value = 0;
+  if (!memrefs || !memrefs->schedule || !memrefs->schedule->dirty)
+    return 0;
 
-  rc_update_memref_values(self->memrefs, peek, ud);
+  if (!rc_memrefs_begin_schedule(memrefs))
+    return 0;
 
-  for (i = self->trigger_count - 1; i >= 0; --i) {
-    rc_trigger_t* trigger = self->triggers[i].trigger;
-    int old_state, new_state;
-    uint32_t old_measured_value;
+  /* only memrefs referenced by something that's active need to be read each frame */
+  for (i = 0; i < self->trigger_count; ++i) {
+    if (self->triggers[i].trigger)
+      rc_memrefs_mark_trigger_reachable(memrefs, self->triggers[i].trigger);
+  }
 
-    if (!trigger)
-      continue;
+  for (i = 0; i < self->lboard_count; ++i) {
+    if (self->lboards[i].lboard)
+      rc_memrefs_mark_lboard_reachable(memrefs, self->lboards[i].lboard);
+  }
 
-    if (self->triggers[i].invalid_memref) {
-      runtime_event.type = RC_RUNTIME_EVENT_ACHIEVEMENT_DISABLED;
-      runtime_event.id = self->triggers[i].id;
-      runtime_event.value = self->triggers[i].invalid_memref->address;
+  if (self->richpresence && self->richpresence->richpresence)
+    rc_memrefs_mark_richpresence_reachable(memrefs, self->richpresence->richpresence);
 
-      trigger->state = RC_TRIGGER_STATE_DISABLED;
-      self->triggers[i].invalid_memref = NULL;
+  rc_memrefs_end_schedule(memrefs);
+  return 1;
+}
 
-      event_handler(&runtime_event);
+/* ===== frame processing ===== */
 
-      runtime_event.value = 0; /* achievement loop expects this to stay at 0 */
-      continue;
+/* where the events raised by a frame go. exactly one of event_handler and buffer is set */
+typedef struct rc_runtime_event_sink_t {
+  rc_runtime_event_handler_t event_handler;
+  rc_runtime_event_buffer_t* buffer;
+} rc_runtime_event_sink_t;
+
+#define RC_RUNTIME_EVENT_BUFFER_MIN_CAPACITY 16
+
+void rc_runtime_init_event_buffer(rc_runtime_event_buffer_t* buffer, rc_runtime_event_t* events, uint32_t capacity) {
+  memset(buffer, 0, sizeof(*buffer));
+
+  if (events) {
+    buffer->events = events;
+    buffer->capacity = capacity;
+  }
+  else {
+    buffer->owns_events = 1;
+  }
+}
+
+void rc_runtime_destroy_event_buffer(rc_runtime_event_buffer_t* buffer) {
+  if (buffer->owns_events)
+    free(buffer->events);
+
+  buffer->events = NULL;
+  buffer->num_events = buffer->capacity = 0;
+}
+
+static int rc_runtime_grow_event_buffer(rc_runtime_event_buffer_t* buffer) {
+  rc_runtime_event_t* events;
+  uint32_t capacity;
+
+  if (!buffer->owns_events)
+    return 0;
+
+  capacity = buffer->capacity ? buffer->capacity * 2 : RC_RUNTIME_EVENT_BUFFER_MIN_CAPACITY;
+  events = (rc_runtime_event_t*)realloc(buffer->events, capacity * sizeof(rc_runtime_event_t));
+  if (!events)
+    return 0;
+
+  buffer->events = events;
+  buffer->capacity = capacity;
+  return 1;
+}
+
+static void rc_runtime_raise_event(const rc_runtime_event_sink_t* sink, const rc_runtime_event_t* runtime_event) {
+  rc_runtime_event_buffer_t* buffer = sink->buffer;
+
+  if (!buffer) {
+    sink->event_handler(runtime_event);
+    return;
+  }
+
+  if (buffer->num_events == buffer->capacity && !rc_runtime_grow_event_buffer(buffer)) {
+    ++buffer->num_dropped;
+    return;
+  }
+
+  memcpy(&buffer->events[buffer->num_events++], runtime_event, sizeof(*runtime_event));
+}
+
+/* the state of an entry before and after it was evaluated, so the events can be raised afterwards */
+typedef struct rc_runtime_trigger_result_t {
+  rc_trigger_t* trigger;              /* the trigger that was evaluated. NULL if it wasn't evaluated */
+  uint32_t old_measured_value;
+  uint8_t old_state;
+  uint8_t new_state;
+} rc_runtime_trigger_result_t;
+
+typedef struct rc_runtime_lboard_result_t {
+  rc_lboard_t* lboard;                /* the lboard that was evaluated. NULL if it wasn't evaluated */
+  int32_t value;
+  uint8_t old_state;
+  uint8_t new_state;
+} rc_runtime_lboard_result_t;
+
+typedef struct rc_runtime_parallel_t {
+  rc_runtime_parallel_for_t parallel_for;
+  void* userdata;
+
+  rc_runtime_trigger_result_t* trigger_results;
+  uint32_t trigger_results_capacity;
+  rc_runtime_lboard_result_t* lboard_results;
+  uint32_t lboard_results_capacity;
+
+  /* only valid while the work items are being processed */
+  rc_runtime_t* runtime;
+  rc_runtime_peek_t peek;
+  void* peek_userdata;
+  uint32_t num_trigger_items;
+} rc_runtime_parallel_t;
+
+/* number of triggers or lboards evaluated by each work item. large enough that handing out an item
+ * costs much less than evaluating it, small enough that the items can be balanced across threads */
+#define RC_RUNTIME_PARALLEL_ITEM_SIZE 32
+
+int rc_runtime_set_deferred_parallel_for(rc_runtime_t* self, rc_runtime_parallel_for_t parallel_for, void* userdata) {
+  rc_runtime_state_t* state = self->state;
+
+  if (!parallel_for) {
+    if (state->parallel) {
+      free(state->parallel->trigger_results);
+      free(state->parallel->lboard_results);
+      free(state->parallel);
+      state->parallel = NULL;
     }
 
-    old_measured_value = trigger->measured_value;
-    old_state = trigger->state;
-    new_state = rc_evaluate_trigger(trigger, peek, ud, unused_L);
+    return RC_OK;
+  }
+
+  if (!state->parallel) {
+    state->parallel = (rc_runtime_parallel_t*)calloc(1, sizeof(rc_runtime_parallel_t));
+    if (!state->parallel)
+      return RC_OUT_OF_MEMORY;
+  }
+
+  state->parallel->parallel_for = parallel_for;
+  state->parallel->userdata = userdata;
+  return RC_OK;
+}
+
+static void rc_runtime_disable_trigger(rc_runtime_t* self, uint32_t index, const rc_runtime_event_sink_t* sink) {
+  rc_runtime_event_t runtime_event;
+
+  runtime_event.type = RC_RUNTIME_EVENT_ACHIEVEMENT_DISABLED;
+  runtime_event.id = self->triggers[index].id;
+  runtime_event.value = self->triggers[index].invalid_memref->address;
+
+  self->triggers[index].trigger->state = RC_TRIGGER_STATE_DISABLED;
+  self->triggers[index].invalid_memref = NULL;
+
+  rc_runtime_raise_event(sink, &runtime_event);
+}
+
+static void rc_runtime_prepare_trigger(rc_runtime_t* self, uint32_t index) {
+  rc_trigger_t* trigger = self->triggers[index].trigger;
+  rc_runtime_trigger_state_t* trigger_state = rc_runtime_get_trigger_state(self, index);
+  if (!trigger_state)
+    return;
+
+  /* only the triggers the runtime evaluates need the memory to track whether they can be skipped */
+  if (!trigger_state->steady || trigger_state->steady->trigger != trigger) {
+    rc_trigger_steady_destroy(trigger_state->steady);
+    trigger_state->steady = rc_trigger_steady_create(trigger);
+  }
+
+  /* the jit is kept even if nothing could be compiled so it isn't attempted every frame */
+  if (self->state->jit_enabled && !trigger_state->jit) {
+    trigger_state->jit = rc_trigger_jit_compile(trigger, self->state->jit_pool);
+
+    /* unmaps the code and falls back to the interpreter for every trigger */
+    if (rc_trigger_jit_pool_failed(self->state->jit_pool))
+      rc_runtime_set_jit_enabled(self, 0);
+  }
+}
+
+static void rc_runtime_evaluate_trigger(rc_runtime_t* self, uint32_t index, rc_runtime_peek_t peek, void* ud,
+                                        rc_shared_conditions_t* shared_conditions, rc_runtime_trigger_result_t* result) {
+  rc_trigger_t* trigger = self->triggers[index].trigger;
+  const rc_runtime_trigger_state_t* trigger_state = rc_runtime_get_trigger_state(self, index);
 
-    /* trigger->state doesn't actually change to RESET, RESET just serves as a notification.
-     * handle the notification, then look at the actual state */
-    if (new_state == RC_TRIGGER_STATE_RESET) {
-      runtime_event.type = RC_RUNTIME_EVENT_ACHIEVEMENT_RESET;
-      runtime_event.id = self->triggers[i].id;
-      event_handler(&runtime_event);
+  result->trigger = trigger;
+  result->old_measured_value = trigger->measured_value;
+  result->old_state = trigger->state;
+
+  if (!trigger_state) {
+    result->new_state = (uint8_t)rc_evaluate_trigger(trigger, peek, ud, NULL);
+    return;
+  }
 
-      new_state = trigger->state;
+  result->new_state = (uint8_t)rc_evaluate_trigger_jit(trigger, peek, ud,
+      self->state->jit_enabled ? trigger_state->jit : NULL, trigger_state->steady, shared_conditions,
+      trigger_state->shared_indices);
+}
+
+static void rc_runtime_raise_trigger_events(rc_runtime_t* self, uint32_t index, const rc_runtime_trigger_result_t* result,
+                                            const rc_runtime_event_sink_t* sink) {
+  rc_trigger_t* trigger = result->trigger;
+  const int old_state = result->old_state;
+  const uint32_t old_measured_value = result->old_measured_value;
+  int new_state = result->new_state;
+  rc_runtime_event_t runtime_event;
+
+  runtime_event.id = self->triggers[index].id;
+  runtime_event.value = 0;
+
+  /* trigger->state doesn't actually change to RESET, RESET just serves as a notification.
+   * handle the notification, then look at the actual state */
+  if (new_state == RC_TRIGGER_STATE_RESET) {
+    runtime_event.type = RC_RUNTIME_EVENT_ACHIEVEMENT_RESET;
+    rc_runtime_raise_event(sink, &runtime_event);
+
+    new_state = trigger->state;
+  }
+
+  /* if the measured value changed and the achievement hasn't triggered, send a notification */
+  if (trigger->measured_value != old_measured_value && old_measured_value != RC_MEASURED_UNKNOWN &&
+      trigger->measured_target != 0 && trigger->measured_value <= trigger->measured_target &&
+      new_state != RC_TRIGGER_STATE_TRIGGERED &&
+      new_state != RC_TRIGGER_STATE_INACTIVE && new_state != RC_TRIGGER_STATE_WAITING) {
+
+    runtime_event.type = RC_RUNTIME_EVENT_ACHIEVEMENT_PROGRESS_UPDATED;
+
+    if (trigger->measured_as_percent) {
+      /* if reporting measured value as a percentage, only send the notification if the percentage changes */
+      const int32_t old_percent = (int32_t)(((unsigned long long)old_measured_value * 100) / trigger->measured_target);
+      const int32_t new_percent = (int32_t)(((unsigned long long)trigger->measured_value * 100) / trigger->measured_target);
+      if (old_percent != new_percent) {
+        runtime_event.value = new_percent;
+        rc_runtime_raise_event(sink, &runtime_event);
+      }
+    }
+    else {
+      runtime_event.value = trigger->measured_value;
+      rc_runtime_raise_event(sink, &runtime_event);
     }
 
-    /* if the measured value changed and the achievement hasn't triggered, send a notification */
-    if (trigger->measured_value != old_measured_value && old_measured_value != RC_MEASURED_UNKNOWN &&
-        trigger->measured_target != 0 && trigger->measured_value <= trigger->measured_target &&
-        new_state != RC_TRIGGER_STATE_TRIGGERED &&
-        new_state != RC_TRIGGER_STATE_INACTIVE && new_state != RC_TRIGGER_STATE_WAITING) {
-
-      runtime_event.type = RC_RUNTIME_EVENT_ACHIEVEMENT_PROGRESS_UPDATED;
-      runtime_event.id = self->triggers[i].id;
-
-      if (trigger->measured_as_percent) {
-        /* if reporting measured value as a percentage, only send the notification if the percentage changes */
-        const int32_t old_percent = (int32_t)(((unsigned long long)old_measured_value * 100) / trigger->measured_target);
-        const int32_t new_percent = (int32_t)(((unsigned long long)trigger->measured_value * 100) / trigger->measured_target);
-        if (old_percent != new_percent) {
-          runtime_event.value = new_percent;
-          event_handler(&runtime_event);
-        }
+    runtime_event.value = 0; /* achievement events expect this to stay at 0 */
+  }
+
+  /* if the state hasn't changed, there won't be any events raised */
+  if (new_state == old_state)
+    return;
+
+  /* raise an UNPRIMED event when changing from PRIMED to anything else */
+  if (old_state == RC_TRIGGER_STATE_PRIMED) {
+    runtime_event.type = RC_RUNTIME_EVENT_ACHIEVEMENT_UNPRIMED;
+    rc_runtime_raise_event(sink, &runtime_event);
+  }
+
+  /* raise events for each of the possible new states */
+  switch (new_state)
+  {
+    case RC_TRIGGER_STATE_TRIGGERED:
+      runtime_event.type = RC_RUNTIME_EVENT_ACHIEVEMENT_TRIGGERED;
+      rc_runtime_raise_event(sink, &runtime_event);
+      break;
+
+    case RC_TRIGGER_STATE_PAUSED:
+      runtime_event.type = RC_RUNTIME_EVENT_ACHIEVEMENT_PAUSED;
+      rc_runtime_raise_event(sink, &runtime_event);
+      break;
+
+    case RC_TRIGGER_STATE_PRIMED:
+      runtime_event.type = RC_RUNTIME_EVENT_ACHIEVEMENT_PRIMED;
+      rc_runtime_raise_event(sink, &runtime_event);
+      break;
+
+    case RC_TRIGGER_STATE_ACTIVE:
+      /* only raise ACTIVATED event when transitioning from an inactive state.
+       * note that inactive in this case means active but cannot trigger. */
+      if (old_state == RC_TRIGGER_STATE_WAITING || old_state == RC_TRIGGER_STATE_PAUSED) {
+        runtime_event.type = RC_RUNTIME_EVENT_ACHIEVEMENT_ACTIVATED;
+        rc_runtime_raise_event(sink, &runtime_event);
       }
-      else {
-        runtime_event.value = trigger->measured_value;
-        event_handler(&runtime_event);
+      break;
+  }
+}
+
+static void rc_runtime_disable_lboard(rc_runtime_t* self, uint32_t index, const rc_runtime_event_sink_t* sink) {
+  rc_runtime_event_t runtime_event;
+
+  runtime_event.type = RC_RUNTIME_EVENT_LBOARD_DISABLED;
+  runtime_event.id = self->lboards[index].id;
+  runtime_event.value = self->lboards[index].invalid_memref->address;
+
+  self->lboards[index].lboard->state = RC_LBOARD_STATE_DISABLED;
+  self->lboards[index].invalid_memref = NULL;
+
+  rc_runtime_raise_event(sink, &runtime_event);
+}
+
+static void rc_runtime_evaluate_lboard(rc_runtime_t* self, uint32_t index, rc_runtime_peek_t peek, void* ud,
+                                       rc_runtime_lboard_result_t* result) {
+  rc_lboard_t* lboard = self->lboards[index].lboard;
+
+  result->lboard = lboard;
+  result->old_state = lboard->state;
+  result->value = 0;
+  result->new_state = (uint8_t)rc_evaluate_lboard(lboard, &result->value, peek, ud, NULL);
+}
+
+static void rc_runtime_raise_lboard_events(rc_runtime_t* self, uint32_t index, const rc_runtime_lboard_result_t* result,
+                                           const rc_runtime_event_sink_t* sink) {
+  const int lboard_state = result->old_state;
+  rc_runtime_event_t runtime_event;
+
+  runtime_event.id = self->lboards[index].id;
+  runtime_event.value = result->value;
+
+  switch (result->new_state)
+  {
+    case RC_LBOARD_STATE_STARTED: /* leaderboard is running */
+      if (lboard_state != RC_LBOARD_STATE_STARTED) {
+        self->lboards[index].value = runtime_event.value;
+
+        runtime_event.type = RC_RUNTIME_EVENT_LBOARD_STARTED;
+        rc_runtime_raise_event(sink, &runtime_event);
       }
+      else if (runtime_event.value != self->lboards[index].value) {
+        self->lboards[index].value = runtime_event.value;
 
-      runtime_event.value = 0; /* achievement loop expects this to stay at 0 */
-    }
+        runtime_event.type = RC_RUNTIME_EVENT_LBOARD_UPDATED;
+        rc_runtime_raise_event(sink, &runtime_event);
+      }
+      break;
 
-    /* if the state hasn't changed, there won't be any events raised */
-    if (new_state == old_state)
-      continue;
+    case RC_LBOARD_STATE_CANCELED:
+      if (lboard_state != RC_LBOARD_STATE_CANCELED) {
+        runtime_event.type = RC_RUNTIME_EVENT_LBOARD_CANCELED;
+        rc_runtime_raise_event(sink, &runtime_event);
+      }
+      break;
+
+    case RC_LBOARD_STATE_TRIGGERED:
+      if (lboard_state != RC_RUNTIME_EVENT_LBOARD_TRIGGERED) {
+        runtime_event.type = RC_RUNTIME_EVENT_LBOARD_TRIGGERED;
+        rc_runtime_raise_event(sink, &runtime_event);
+      }
+      break;
+  }
+}
 
-    /* raise an UNPRIMED event when changing from PRIMED to anything else */
-    if (old_state == RC_TRIGGER_STATE_PRIMED) {
-      runtime_event.type = RC_RUNTIME_EVENT_ACHIEVEMENT_UNPRIMED;
-      runtime_event.id = self->triggers[i].id;
-      event_handler(&runtime_event);
+static void RC_CCONV rc_runtime_process_parallel_item(uint32_t item, void* item_data) {
+  rc_runtime_parallel_t* parallel = (rc_runtime_parallel_t*)item_data;
+  rc_runtime_t* self = parallel->runtime;
+  uint32_t first, last, i;
+
+  /* shared conditions are memoized as they're evaluated, so they can't be used from multiple threads.
+   * they're only an optimization, so every thread evaluates its own copy of the conditions instead */
+  if (item < parallel->num_trigger_items) {
+    first = item * RC_RUNTIME_PARALLEL_ITEM_SIZE;
+    last = first + RC_RUNTIME_PARALLEL_ITEM_SIZE;
+    if (last > self->trigger_count)
+      last = self->trigger_count;
+
+    for (i = first; i < last; ++i) {
+      if (parallel->trigger_results[i].trigger)
+        rc_runtime_evaluate_trigger(self, i, parallel->peek, parallel->peek_userdata, NULL, &parallel->trigger_results[i]);
     }
+  }
+  else {
+    first = (item - parallel->num_trigger_items) * RC_RUNTIME_PARALLEL_ITEM_SIZE;
+    last = first + RC_RUNTIME_PARALLEL_ITEM_SIZE;
+    if (last > self->lboard_count)
+      last = self->lboard_count;
+
+    for (i = first; i < last; ++i) {
+      if (parallel->lboard_results[i].lboard)
+        rc_runtime_evaluate_lboard(self, i, parallel->peek, parallel->peek_userdata, &parallel->lboard_results[i]);
+    }
+  }
+}
 
-    /* raise events for each of the possible new states */
-    switch (new_state)
-    {
-      case RC_TRIGGER_STATE_TRIGGERED:
-        runtime_event.type = RC_RUNTIME_EVENT_ACHIEVEMENT_TRIGGERED;
-        runtime_event.id = self->triggers[i].id;
-        event_handler(&runtime_event);
-        break;
+static int rc_runtime_reserve_parallel_results(rc_runtime_parallel_t* parallel, uint32_t trigger_count, uint32_t lboard_count) {
+  if (trigger_count > parallel->trigger_results_capacity) {
+    rc_runtime_trigger_result_t* trigger_results = (rc_runtime_trigger_result_t*)
+        realloc(parallel->trigger_results, trigger_count * sizeof(rc_runtime_trigger_result_t));
+    if (!trigger_results)
+      return 0;
 
-      case RC_TRIGGER_STATE_PAUSED:
-        runtime_event.type = RC_RUNTIME_EVENT_ACHIEVEMENT_PAUSED;
-        runtime_event.id = self->triggers[i].id;
-        event_handler(&runtime_event);
-        break;
+    parallel->trigger_results = trigger_results;
+    parallel->trigger_results_capacity = trigger_count;
+  }
 
-      case RC_TRIGGER_STATE_PRIMED:
-        runtime_event.type = RC_RUNTIME_EVENT_ACHIEVEMENT_PRIMED;
-        runtime_event.id = self->triggers[i].id;
-        event_handler(&runtime_event);
-        break;
-
-      case RC_TRIGGER_STATE_ACTIVE:
-        /* only raise ACTIVATED event when transitioning from an inactive state.
-         * note that inactive in this case means active but cannot trigger. */
-        if (old_state == RC_TRIGGER_STATE_WAITING || old_state == RC_TRIGGER_STATE_PAUSED) {
-          runtime_event.type = RC_RUNTIME_EVENT_ACHIEVEMENT_ACTIVATED;
-          runtime_event.id = self->triggers[i].id;
-          event_handler(&runtime_event);
-        }
-        break;
-    }
+  if (lboard_count > parallel->lboard_results_capacity) {
+    rc_runtime_lboard_result_t* lboard_results = (rc_runtime_lboard_result_t*)
+        realloc(parallel->lboard_results, lboard_count * sizeof(rc_runtime_lboard_result_t));
+    if (!lboard_results)
+      return 0;
+
+    parallel->lboard_results = lboard_results;
+    parallel->lboard_results_capacity = lboard_count;
   }
 
-  for (i = self->lboard_count - 1; i >= 0; --i) {
-    rc_lboard_t* lboard = self->lboards[i].lboard;
-    int lboard_state;
+  return 1;
+}
 
-    if (!lboard)
-      continue;
+/* see rc_runtime_set_deferred_parallel_for for how this differs from evaluating serially */
+static int rc_runtime_do_frame_deferred(rc_runtime_t* self, const rc_runtime_event_sink_t* sink, rc_runtime_peek_t peek, void* ud) {
+  rc_runtime_parallel_t* parallel = self->state->parallel;
+  const uint32_t trigger_count = self->trigger_count;
+  const uint32_t lboard_count = self->lboard_count;
+  uint32_t num_lboard_items;
+  uint32_t i;
+
+  if (!rc_runtime_reserve_parallel_results(parallel, trigger_count, lboard_count))
+    return 0;
+
+  /* anything that modifies the runtime has to happen before the items are handed out. invalid entries
+   * are disabled in the replay below so their events are interleaved with the others as they would be */
+  for (i = 0; i < trigger_count; ++i) {
+    rc_runtime_trigger_result_t* result = &parallel->trigger_results[i];
+    result->trigger = self->triggers[i].invalid_memref ? NULL : self->triggers[i].trigger;
+    if (result->trigger)
+      rc_runtime_prepare_trigger(self, i);
+  }
+
+  for (i = 0; i < lboard_count; ++i)
+    parallel->lboard_results[i].lboard = self->lboards[i].invalid_memref ? NULL : self->lboards[i].lboard;
+
+  parallel->runtime = self;
+  parallel->peek = peek;
+  parallel->peek_userdata = ud;
+  parallel->num_trigger_items = (trigger_count + RC_RUNTIME_PARALLEL_ITEM_SIZE - 1) / RC_RUNTIME_PARALLEL_ITEM_SIZE;
+  num_lboard_items = (lboard_count + RC_RUNTIME_PARALLEL_ITEM_SIZE - 1) / RC_RUNTIME_PARALLEL_ITEM_SIZE;
 
-    if (self->lboards[i].invalid_memref) {
-      runtime_event.type = RC_RUNTIME_EVENT_LBOARD_DISABLED;
-      runtime_event.id = self->lboards[i].id;
-      runtime_event.value = self->lboards[i].invalid_memref->address;
+  if (parallel->num_trigger_items + num_lboard_items > 0) {
+    parallel->parallel_for(parallel->num_trigger_items + num_lboard_items,
+                           rc_runtime_process_parallel_item, parallel, parallel->userdata);
+  }
 
-      lboard->state = RC_LBOARD_STATE_DISABLED;
-      self->lboards[i].invalid_memref = NULL;
+  parallel->runtime = NULL;
 
-      event_handler(&runtime_event);
+  /* replay the events in the same order as rc_runtime_do_frame. the event handler may deactivate
+   * entries, which moves others into their slots, so only raise events for what was evaluated */
+  for (i = trigger_count; i-- > 0;) {
+    if (i >= self->trigger_count || !self->triggers[i].trigger)
       continue;
-    }
 
-    lboard_state = lboard->state;
-    switch (rc_evaluate_lboard(lboard, &runtime_event.value, peek, ud, unused_L))
-    {
-      case RC_LBOARD_STATE_STARTED: /* leaderboard is running */
-        if (lboard_state != RC_LBOARD_STATE_STARTED) {
-          self->lboards[i].value = runtime_event.value;
+    if (self->triggers[i].invalid_memref)
+      rc_runtime_disable_trigger(self, i, sink);
+    else if (self->triggers[i].trigger == parallel->trigger_results[i].trigger)
+      rc_runtime_raise_trigger_events(self, i, &parallel->trigger_results[i], sink);
+  }
 
-          runtime_event.type = RC_RUNTIME_EVENT_LBOARD_STARTED;
-          runtime_event.id = self->lboards[i].id;
-          event_handler(&runtime_event);
-        }
-        else if (runtime_event.value != self->lboards[i].value) {
-          self->lboards[i].value = runtime_event.value;
+  for (i = lboard_count; i-- > 0;) {
+    if (i >= self->lboard_count || !self->lboards[i].lboard)
+      continue;
 
-          runtime_event.type = RC_RUNTIME_EVENT_LBOARD_UPDATED;
-          runtime_event.id = self->lboards[i].id;
-          event_handler(&runtime_event);
-        }
-        break;
+    if (self->lboards[i].invalid_memref)
+      rc_runtime_disable_lboard(self, i, sink);
+    else if (self->lboards[i].lboard == parallel->lboard_results[i].lboard)
+      rc_runtime_raise_lboard_events(self, i, &parallel->lboard_results[i], sink);
+  }
 
-      case RC_LBOARD_STATE_CANCELED:
-        if (lboard_state != RC_LBOARD_STATE_CANCELED) {
-          runtime_event.type = RC_RUNTIME_EVENT_LBOARD_CANCELED;
-          runtime_event.id = self->lboards[i].id;
-          event_handler(&runtime_event);
-        }
-        break;
+  return 1;
+}
 
-      case RC_LBOARD_STATE_TRIGGERED:
-        if (lboard_state != RC_RUNTIME_EVENT_LBOARD_TRIGGERED) {
-          runtime_event.type = RC_RUNTIME_EVENT_LBOARD_TRIGGERED;
-          runtime_event.id = self->lboards[i].id;
-          event_handler(&runtime_event);
-        }
-        break;
+static void rc_runtime_process_frame(rc_runtime_t* self, const rc_runtime_event_sink_t* sink, rc_runtime_peek_t peek, void* ud, void* unused_L) {
+  rc_runtime_trigger_result_t trigger_result;
+  rc_runtime_lboard_result_t lboard_result;
+  int i;
+
+  rc_runtime_schedule_memrefs(self);
+  rc_update_memref_values(self->memrefs, peek, ud);
+  rc_shared_conditions_begin_frame(self->state->shared_conditions);
+
+  /* rc_client rebuilds the triggers array without going through the runtime. if the states can't be
+   * allocated, the triggers without one are evaluated without them */
+  rc_runtime_reserve_trigger_states(self->state, self->trigger_count);
+
+  /* if the results can't be allocated, evaluate serially */
+  if (!self->state->parallel || !rc_runtime_do_frame_deferred(self, sink, peek, ud)) {
+    for (i = self->trigger_count - 1; i >= 0; --i) {
+      if (!self->triggers[i].trigger)
+        continue;
+
+      if (self->triggers[i].invalid_memref) {
+        rc_runtime_disable_trigger(self, i, sink);
+        continue;
+      }
+
+      rc_runtime_prepare_trigger(self, i);
+      rc_runtime_evaluate_trigger(self, i, peek, ud, self->state->shared_conditions, &trigger_result);
+      rc_runtime_raise_trigger_events(self, i, &trigger_result, sink);
+    }
+
+    for (i = self->lboard_count - 1; i >= 0; --i) {
+      if (!self->lboards[i].lboard)
+        continue;
+
+      if (self->lboards[i].invalid_memref) {
+        rc_runtime_disable_lboard(self, i, sink);
+        continue;
+      }
+
+      rc_runtime_evaluate_lboard(self, i, peek, ud, &lboard_result);
+      rc_runtime_raise_lboard_events(self, i, &lboard_result, sink);
     }
   }
 
@@ -683,6 +1575,24 @@ void rc_runtime_do_frame(rc_runtime_t* self, rc_runtime_event_handler_t event_ha
     rc_update_richpresence(self->richpresence->richpresence, peek, ud, unused_L);
 }
 
+void rc_runtime_do_frame(rc_runtime_t* self, rc_runtime_event_handler_t event_handler, rc_runtime_peek_t peek, void* ud, void* unused_L) {
+  rc_runtime_event_sink_t sink;
+  sink.event_handler = event_handler;
+  sink.buffer = NULL;
+
+  rc_runtime_process_frame(self, &sink, peek, ud, unused_L);
+}
+
+uint32_t rc_runtime_do_frame_buffered(rc_runtime_t* self, rc_runtime_event_buffer_t* buffer, rc_runtime_peek_t peek, void* ud) {
+  const uint32_t num_events = buffer->num_events;
+  rc_runtime_event_sink_t sink;
+  sink.event_handler = NULL;
+  sink.buffer = buffer;
+
+  rc_runtime_process_frame(self, &sink, peek, ud, NULL);
+  return buffer->num_events - num_events;
+}
+
 void rc_runtime_reset(rc_runtime_t* self) {
   uint32_t i;
 
@@ -747,6 +1657,9 @@ int rc_trigger_contains_memref(const rc_trigger_t* trigger, const rc_memref_t* m
 static void rc_runtime_invalidate_memref(rc_runtime_t* self, rc_memref_t* memref) {
   uint32_t i;
 
+  /* stop reading the address */
+  rc_memrefs_mark_dirty(self->memrefs);
+
   /* disable any achievements dependent on the address */
   for (i = 0; i < self->trigger_count; ++i) {
     if (!self->triggers[i].invalid_memref && rc_trigger_contains_memref(self->triggers[i].trigger, memref))
@@ -797,6 +1710,35 @@ void rc_runtime_invalidate_address(rc_runtime_t* self, uint32_t address) {
   } while (memref_list);
 }
 
+void rc_runtime_set_fused_reads_enabled(rc_runtime_t* self, int enabled) {
+  rc_memrefs_set_fuse_reads(self->memrefs, enabled);
+}
+
+void rc_runtime_set_dirty_pages(rc_runtime_t* self, const uint8_t* dirty_pages, uint32_t num_pages, uint32_t page_size) {
+  rc_memrefs_set_dirty_pages(self->memrefs, dirty_pages, num_pages, page_size);
+}
+
+int rc_runtime_set_jit_enabled(rc_runtime_t* self, int enabled) {
+  rc_runtime_state_t* state = self->state;
+  uint32_t i;
+
+  if (!enabled) {
+    for (i = 0; i < state->trigger_capacity; ++i) {
+      rc_trigger_jit_destroy(state->triggers[i].jit);
+      state->triggers[i].jit = NULL;
+    }
+
+    rc_trigger_jit_pool_destroy(state->jit_pool);
+    state->jit_pool = NULL;
+  }
+  else if (!state->jit_pool) {
+    state->jit_pool = rc_trigger_jit_pool_create();
+  }
+
+  state->jit_enabled = (state->jit_pool != NULL) ? 1 : 0;
+  return RC_TRIGGER_JIT_SUPPORTED;
+}
+
 void rc_runtime_validate_addresses(rc_runtime_t* self, rc_runtime_event_handler_t event_handler,
     rc_runtime_validate_address_t validate_handler) {
   int num_invalid = 0;
@@ -366,14 +366,20 @@ static int rc_runtime_progress_write_condset(rc_runtime_progress_t* progress, rc
 
 static int rc_runtime_progress_read_condset(rc_runtime_progress_t* progress, rc_condset_t* condset)
 {
+  rc_condset_with_trailing_conditions_t* condset_with_conditions = (rc_condset_with_trailing_conditions_t*)condset;
   rc_condition_t* cond;
   uint32_t flags;
 
   condset->is_paused = (char)rc_runtime_progress_read_uint(progress);
 
   cond = condset->conditions;
+  if (cond) /* an empty condset doesn't have the trailing data */
+    condset_with_conditions->has_hits = 0;
+
   while (cond) {
     cond->current_hits = rc_runtime_progress_read_uint(progress);
+    if (cond->current_hits)
+      condset_with_conditions->has_hits = 1;
     flags = rc_runtime_progress_read_uint(progress);
 
     cond->is_true = (flags & RC_COND_FLAG_IS_TRUE_MASK);
@@ -1049,6 +1055,9 @@ int rc_runtime_deserialize_progress_sized(rc_runtime_t* runtime, const uint8_t*
     progress.offset = next_chunk_offset;
   } while (result == RC_OK && chunk_id != RC_RUNTIME_CHUNK_DONE);
 
+  /* memref values were restored directly into the records */
+  rc_memrefs_mark_dirty(runtime->memrefs);
+
   if (result != RC_OK) {
     rc_runtime_reset(runtime);
   }
@@ -1,7 +1,101 @@
 #include "rc_internal.h"
 
 #include <stddef.h>
-#include <string.h> /* memset */
+#include <stdlib.h> /* malloc, free */
+#include <string.h> /* memset, memcpy, memcmp */
+
+static rc_condset_t* rc_trigger_next_condset(const rc_trigger_t* self, const rc_condset_t* condset) {
+  return (condset == self->requirement) ? self->alternative : condset->next;
+}
+
+static const rc_memref_value_t* rc_trigger_get_operand_input(const rc_operand_t* operand) {
+  if (rc_operand_is_memref(operand))
+    return &operand->value.memref->value;
+
+  if (rc_operand_is_recall(operand) && rc_operand_type_is_memref(operand->memref_access_type) && operand->value.memref)
+    return &operand->value.memref->value;
+
+  return NULL;
+}
+
+static void rc_trigger_add_input(rc_trigger_steady_t* steady, const rc_operand_t* operand) {
+  const rc_memref_value_t* memref = rc_trigger_get_operand_input(operand);
+  uint32_t i;
+
+  if (!memref)
+    return;
+
+  for (i = 0; i < steady->num_inputs; ++i) {
+    if (steady->inputs[i].memref == memref)
+      return;
+  }
+
+  steady->inputs[i].memref = memref;
+  memcpy(&steady->inputs[i].value, memref, sizeof(*memref));
+  ++steady->num_inputs;
+}
+
+rc_trigger_steady_t* rc_trigger_steady_create(const rc_trigger_t* trigger) {
+  rc_trigger_steady_t* steady;
+  rc_condset_t* condset;
+  rc_condition_t* condition;
+  uint32_t num_conditions = 0;
+  uint32_t num_condsets = 0;
+  int has_hit_targets = 0;
+
+  condset = trigger->requirement ? trigger->requirement : trigger->alternative;
+  for (; condset; condset = rc_trigger_next_condset(trigger, condset)) {
+    for (condition = condset->conditions; condition; condition = condition->next) {
+      has_hit_targets |= (condition->required_hits != 0);
+      ++num_conditions;
+    }
+
+    ++num_condsets;
+  }
+
+  /* if any condition has a hit target, evaluating the trigger with the same inputs can have a
+   * different outcome depending on how many times it's been evaluated. without hit targets,
+   * AddHits and SubHits don't affect anything either */
+  if (has_hit_targets)
+    num_conditions = 0;
+
+  /* each condition has at most two inputs. duplicates are merged, so some of the space may go unused */
+  steady = (rc_trigger_steady_t*)malloc(sizeof(rc_trigger_steady_t) +
+      (num_conditions ? (num_conditions * 2 * sizeof(rc_trigger_input_t) +
+                         num_conditions * sizeof(rc_trigger_steady_condition_t) +
+                         num_condsets * sizeof(rc_trigger_steady_condset_t)) : 0));
+  if (!steady)
+    return NULL;
+
+  memset(steady, 0, sizeof(*steady));
+  steady->trigger = trigger;
+
+  /* the steady state is kept even if the trigger doesn't qualify, so it isn't checked every frame */
+  if (num_conditions == 0)
+    return steady;
+
+  steady->inputs = (rc_trigger_input_t*)(steady + 1);
+  steady->conditions = (rc_trigger_steady_condition_t*)(steady->inputs + num_conditions * 2);
+  steady->condsets = (rc_trigger_steady_condset_t*)(steady->conditions + num_conditions);
+
+  condset = trigger->requirement ? trigger->requirement : trigger->alternative;
+  for (; condset; condset = rc_trigger_next_condset(trigger, condset)) {
+    for (condition = condset->conditions; condition; condition = condition->next) {
+      rc_trigger_add_input(steady, &condition->operand1);
+      rc_trigger_add_input(steady, &condition->operand2);
+
+      steady->conditions[steady->num_conditions++].condition = condition;
+    }
+
+    steady->condsets[steady->num_condsets++].condset = condset;
+  }
+
+  return steady;
+}
+
+void rc_trigger_steady_destroy(rc_trigger_steady_t* steady) {
+  free(steady);
+}
 
 void rc_parse_trigger_internal(rc_trigger_t* self, const char** memaddr, rc_parse_state_t* parse) {
   rc_condset_t** next;
@@ -133,6 +227,21 @@ static void rc_reset_trigger_hitcounts(rc_trigger_t* self) {
   }
 }
 
+static void rc_reset_trigger_evaluated_hitcounts(rc_trigger_t* self) {
+  rc_condset_t* condset;
+
+  if (self->requirement) {
+    rc_reset_condset_evaluated(self->requirement);
+  }
+
+  condset = self->alternative;
+
+  while (condset) {
+    rc_reset_condset_evaluated(condset);
+    condset = condset->next;
+  }
+}
+
 static void rc_update_trigger_memrefs(rc_trigger_t* self, rc_peek_t peek, void* ud) {
   if (self->has_memrefs) {
     rc_trigger_with_memrefs_t* trigger = (rc_trigger_with_memrefs_t*)self;
@@ -150,47 +259,138 @@ rc_memrefs_t* rc_trigger_get_memrefs(rc_trigger_t* self) {
 }
 
 int rc_evaluate_trigger(rc_trigger_t* self, rc_peek_t peek, void* ud, void* unused_L) {
-  rc_eval_state_t eval_state;
-  rc_condset_t* condset;
-  rc_typed_value_t measured_value;
-  int measured_from_hits = 0;
-  int ret;
-  char is_paused;
-  char is_primed;
-
   (void)unused_L;
 
-  switch (self->state)
-  {
-    case RC_TRIGGER_STATE_TRIGGERED:
-      /* previously triggered. do nothing - return INACTIVE so caller doesn't think it triggered again */
-      return RC_TRIGGER_STATE_INACTIVE;
+  return rc_evaluate_trigger_jit(self, peek, ud, NULL, NULL, NULL, NULL);
+}
 
-    case RC_TRIGGER_STATE_DISABLED:
-      /* unsupported. do nothing - return INACTIVE */
-      return RC_TRIGGER_STATE_INACTIVE;
+static int rc_trigger_capture_inputs(rc_trigger_steady_t* steady) {
+  rc_trigger_input_t* input = steady->inputs;
+  rc_trigger_input_t* stop = input + steady->num_inputs;
+  int unchanged = 1;
+
+  /* the value can change without setting the changed flag (e.g. when a memref is re-primed),
+   * so compare everything that the conditions can read */
+  for (; input < stop; ++input) {
+    if (memcmp(input->memref, &input->value, sizeof(input->value)) != 0) {
+      memcpy(&input->value, input->memref, sizeof(input->value));
+      unchanged = 0;
+    }
+  }
 
-    case RC_TRIGGER_STATE_INACTIVE:
-      /* not yet active. update the memrefs so deltas are correct when it becomes active, then return INACTIVE */
-      rc_update_trigger_memrefs(self, peek, ud);
-      return RC_TRIGGER_STATE_INACTIVE;
+  return unchanged;
+}
 
-    default:
-      break;
+static void rc_trigger_capture_steady_state(rc_trigger_t* self, rc_trigger_steady_t* steady) {
+  rc_trigger_steady_condition_t* condition = steady->conditions;
+  rc_trigger_steady_condition_t* stop = condition + steady->num_conditions;
+  uint32_t i;
+
+  for (; condition < stop; ++condition) {
+    condition->current_hits = condition->condition->current_hits;
+    condition->is_true = condition->condition->is_true;
   }
 
-  /* update the memory references */
-  rc_update_trigger_memrefs(self, peek, ud);
+  for (i = 0; i < steady->num_condsets; ++i)
+    steady->condsets[i].is_paused = steady->condsets[i].condset->is_paused;
 
-  /* process the trigger */
-  memset(&eval_state, 0, sizeof(eval_state));
-  eval_state.peek = peek;
-  eval_state.peek_userdata = ud;
+  steady->measured_value = self->measured_value;
+  steady->state = self->state;
+  steady->has_hits = self->has_hits;
+}
+
+static int rc_trigger_update_steady_state(rc_trigger_t* self, rc_trigger_steady_t* steady) {
+  rc_trigger_steady_condition_t* condition = steady->conditions;
+  rc_trigger_steady_condition_t* stop = condition + steady->num_conditions;
+  uint32_t i;
+
+  if (steady->measured_value != self->measured_value || steady->state != self->state ||
+      steady->has_hits != self->has_hits) {
+    return 0;
+  }
+
+  for (i = 0; i < steady->num_condsets; ++i) {
+    if (steady->condsets[i].is_paused != steady->condsets[i].condset->is_paused)
+      return 0;
+  }
+
+  /* the only thing allowed to change is tallying hits on untargeted conditions */
+  for (; condition < stop; ++condition) {
+    const uint32_t current_hits = condition->condition->current_hits;
+    if (condition->is_true != condition->condition->is_true)
+      return 0;
+
+    if (current_hits == condition->current_hits) {
+      condition->tally = 0;
+    }
+    else if (current_hits == condition->current_hits + 1) {
+      condition->current_hits = current_hits;
+      condition->tally = 1;
+    }
+    else {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+static int rc_trigger_apply_steady_state(rc_trigger_t* self, rc_trigger_steady_t* steady) {
+  rc_trigger_steady_condition_t* condition = steady->conditions;
+  rc_trigger_steady_condition_t* stop = condition + steady->num_conditions;
+  uint32_t i;
+
+  /* make sure nothing was changed outside of evaluation (reset, deserialized, etc) */
+  if (steady->measured_value != self->measured_value || steady->state != self->state ||
+      steady->has_hits != self->has_hits) {
+    return 0;
+  }
+
+  for (i = 0; i < steady->num_condsets; ++i) {
+    if (steady->condsets[i].is_paused != steady->condsets[i].condset->is_paused)
+      return 0;
+  }
+
+  /* same state and same inputs as an evaluation that only tallied hits. tally them again */
+  for (; condition < stop; ++condition) {
+    rc_condition_t* actual = condition->condition;
+    if (condition->current_hits != actual->current_hits || condition->is_true != actual->is_true) {
+      /* undo any tallies that were already applied */
+      while (condition > steady->conditions) {
+        --condition;
+        condition->current_hits -= condition->tally;
+        condition->condition->current_hits = condition->current_hits;
+      }
+
+      return 0;
+    }
+
+    condition->current_hits += condition->tally;
+    actual->current_hits = condition->current_hits;
+  }
+
+  return 1;
+}
+
+static int rc_evaluate_trigger_conditions(rc_trigger_t* self, const rc_eval_state_t* settings,
+                                          const rc_condset_native_t* native) {
+  rc_eval_state_t eval_state;
+  rc_condset_t* condset;
+  rc_typed_value_t measured_value;
+  int measured_from_hits = 0;
+  int ret;
+  char is_paused;
+  char is_primed;
+
+  memcpy(&eval_state, settings, sizeof(eval_state));
 
   measured_value.type = RC_VALUE_TYPE_NONE;
 
   if (self->requirement != NULL) {
-    ret = rc_test_condset(self->requirement, &eval_state);
+    ret = rc_test_condset_native(self->requirement, &eval_state, native);
+    if (eval_state.shared_indices)
+      eval_state.shared_indices += rc_condset_count_conditions(self->requirement);
+
     is_paused = eval_state.is_paused;
     is_primed = eval_state.is_primed;
 
@@ -204,14 +404,21 @@ int rc_evaluate_trigger(rc_trigger_t* self, rc_peek_t peek, void* ud, void* unus
     is_primed = 1;
   }
 
+  /* if the core is false, nothing the alts do can make the trigger fire */
   condset = self->alternative;
-  if (condset) {
+  if (condset && (ret || !eval_state.can_short_curcuit)) {
     int sub = 0;
     char sub_paused = 1;
     char sub_primed = 0;
 
     do {
-      sub |= rc_test_condset(condset, &eval_state);
+      if (native)
+        ++native;
+
+      sub |= rc_test_condset_native(condset, &eval_state, native);
+      if (eval_state.shared_indices)
+        eval_state.shared_indices += rc_condset_count_conditions(condset);
+
       sub_paused &= eval_state.is_paused;
       sub_primed |= eval_state.is_primed;
 
@@ -244,7 +451,7 @@ int rc_evaluate_trigger(rc_trigger_t* self, rc_peek_t peek, void* ud, void* unus
   /* if any ResetIf condition was true, reset the hit counts */
   if (eval_state.was_reset) {
     /* if the measured value came from a hit count, reset it. do this before calling
-     * rc_reset_trigger_hitcounts in case we need to call rc_condset_is_measured_from_hitcount */
+     * rc_reset_trigger_evaluated_hitcounts in case we need to call rc_condset_is_measured_from_hitcount */
     if (measured_from_hits) {
       self->measured_value = 0;
     }
@@ -265,7 +472,7 @@ int rc_evaluate_trigger(rc_trigger_t* self, rc_peek_t peek, void* ud, void* unus
       }
     }
 
-    rc_reset_trigger_hitcounts(self);
+    rc_reset_trigger_evaluated_hitcounts(self);
 
     /* if there were hit counts to clear, return RESET, but don't change the state */
     if (self->has_hits) {
@@ -316,6 +523,71 @@ int rc_evaluate_trigger(rc_trigger_t* self, rc_peek_t peek, void* ud, void* unus
   return self->state;
 }
 
+static int rc_evaluate_trigger_internal(rc_trigger_t* self, const rc_eval_state_t* settings,
+                                        const rc_condset_native_t* native, rc_trigger_steady_t* steady) {
+  int ret;
+
+  switch (self->state)
+  {
+    case RC_TRIGGER_STATE_TRIGGERED:
+      /* previously triggered. do nothing - return INACTIVE so caller doesn't think it triggered again */
+      return RC_TRIGGER_STATE_INACTIVE;
+
+    case RC_TRIGGER_STATE_DISABLED:
+      /* unsupported. do nothing - return INACTIVE */
+      return RC_TRIGGER_STATE_INACTIVE;
+
+    case RC_TRIGGER_STATE_INACTIVE:
+      /* not yet active. update the memrefs so deltas are correct when it becomes active, then return INACTIVE */
+      rc_update_trigger_memrefs(self, settings->peek, settings->peek_userdata);
+      return RC_TRIGGER_STATE_INACTIVE;
+
+    default:
+      break;
+  }
+
+  /* update the memory references */
+  rc_update_trigger_memrefs(self, settings->peek, settings->peek_userdata);
+
+  if (!steady || steady->trigger != self || !steady->num_conditions)
+    return rc_evaluate_trigger_conditions(self, settings, native);
+
+  if (!rc_trigger_capture_inputs(steady)) {
+    steady->is_steady = 0;
+    return rc_evaluate_trigger_conditions(self, settings, native);
+  }
+
+  /* nothing the trigger reads has changed. if the last evaluation only tallied hits, this one would too */
+  if (steady->is_steady && rc_trigger_apply_steady_state(self, steady))
+    return self->state;
+
+  rc_trigger_capture_steady_state(self, steady);
+  ret = rc_evaluate_trigger_conditions(self, settings, native);
+  steady->is_steady = (ret == self->state && rc_trigger_update_steady_state(self, steady));
+  return ret;
+}
+
+int rc_evaluate_trigger_jit(rc_trigger_t* self, rc_peek_t peek, void* ud, const rc_trigger_jit_t* jit,
+                            rc_trigger_steady_t* steady, rc_shared_conditions_t* shared_conditions,
+                            const uint16_t* shared_indices) {
+  const rc_condset_native_t* native = NULL;
+  rc_eval_state_t settings;
+
+  /* the first entry in jit->condsets is always for the core group */
+  if (jit && jit->condsets && jit->trigger == self)
+    native = jit->condsets;
+
+  memset(&settings, 0, sizeof(settings));
+  settings.peek = peek;
+  settings.peek_userdata = ud;
+  if (shared_conditions) {
+    settings.shared_conditions = shared_conditions;
+    settings.shared_indices = shared_indices;
+  }
+
+  return rc_evaluate_trigger_internal(self, &settings, native, steady);
+}
+
 int rc_test_trigger(rc_trigger_t* self, rc_peek_t peek, void* ud, void* unused_L) {
   /* for backwards compatibilty, rc_test_trigger always assumes the achievement is active */
   self->state = RC_TRIGGER_STATE_ACTIVE;
@@ -323,6 +595,21 @@ int rc_test_trigger(rc_trigger_t* self, rc_peek_t peek, void* ud, void* unused_L
   return (rc_evaluate_trigger(self, peek, ud, unused_L) == RC_TRIGGER_STATE_TRIGGERED);
 }
 
+int rc_test_trigger_short_circuit(rc_trigger_t* self, rc_peek_t peek, void* ud) {
+  /* the hit counts are still tallied, but conditions after the first false one in a group, and the
+   * alts when the core is false, are not evaluated. only use this when the hit counts aren't used */
+  rc_eval_state_t settings;
+
+  self->state = RC_TRIGGER_STATE_ACTIVE;
+
+  memset(&settings, 0, sizeof(settings));
+  settings.peek = peek;
+  settings.peek_userdata = ud;
+  settings.can_short_curcuit = 1;
+
+  return (rc_evaluate_trigger_internal(self, &settings, NULL, NULL) == RC_TRIGGER_STATE_TRIGGERED);
+}
+
 void rc_reset_trigger(rc_trigger_t* self) {
   if (!self)
     return;
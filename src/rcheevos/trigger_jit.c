@@ -0,0 +1,960 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+ #define _DEFAULT_SOURCE /* MAP_ANONYMOUS, sysconf */
+#endif
+
+#include "rc_internal.h"
+
+#if RC_TRIGGER_JIT_SUPPORTED
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* ===== x86-64 encoder ===== */
+
+/* only the registers that the generated code uses */
+enum {
+  RC_JIT_RAX = 0,
+  RC_JIT_RCX = 1,
+  RC_JIT_RDX = 2,
+  RC_JIT_RBX = 3,
+  RC_JIT_RSI = 6,
+  RC_JIT_RDI = 7,
+  RC_JIT_R8 = 8,
+  RC_JIT_R9 = 9,
+  RC_JIT_R10 = 10,
+  RC_JIT_R11 = 11,
+  RC_JIT_R15 = 15
+};
+
+/* register assignments. the generated code doesn't call anything but the pool's routines, so all of the
+ * caller-saved registers are available. rbx and r15 are only used (and saved) when a segment needs them */
+#define RC_JIT_STATE RC_JIT_RDI      /* rc_eval_state_t* */
+#define RC_JIT_CONDITION RC_JIT_RSI  /* first rc_condition_t* of the segment */
+#define RC_JIT_HITS RC_JIT_RDX       /* address of the pool's hit count routine */
+#define RC_JIT_AND_NEXT RC_JIT_R10   /* eval_state->and_next */
+#define RC_JIT_OR_NEXT RC_JIT_R11    /* eval_state->or_next */
+#define RC_JIT_RESET_NEXT RC_JIT_R15 /* eval_state->reset_next */
+#define RC_JIT_ADD_HITS RC_JIT_RBX   /* eval_state->add_hits */
+
+/* condition codes for Jcc (0x70 + cc) and SETcc (0x0F90 + cc). comparisons are unsigned */
+enum {
+  RC_JIT_CC_AE = 0x3,
+  RC_JIT_CC_E = 0x4,
+  RC_JIT_CC_NE = 0x5,
+  RC_JIT_CC_BE = 0x6,
+  RC_JIT_CC_A = 0x7,
+  RC_JIT_CC_B = 0x2
+};
+
+#define RC_JIT_OFFSET(type, field) ((uint32_t)offsetof(type, field))
+#define RC_JIT_NO_CODE 0xFFFFFFFF
+
+typedef struct rc_jit_buffer_t {
+  uint8_t* data;
+  uint32_t size;
+  uint32_t capacity;
+  int failed;
+}
+rc_jit_buffer_t;
+
+static void rc_jit_byte(rc_jit_buffer_t* buf, uint8_t byte) {
+  if (buf->failed)
+    return;
+
+  if (buf->size == buf->capacity) {
+    uint8_t* data;
+
+    buf->capacity = buf->capacity ? buf->capacity * 2 : 4096;
+    data = (uint8_t*)realloc(buf->data, buf->capacity);
+    if (!data) {
+      buf->failed = 1;
+      return;
+    }
+
+    buf->data = data;
+  }
+
+  buf->data[buf->size++] = byte;
+}
+
+static void rc_jit_dword(rc_jit_buffer_t* buf, uint32_t value) {
+  rc_jit_byte(buf, (uint8_t)(value));
+  rc_jit_byte(buf, (uint8_t)(value >> 8));
+  rc_jit_byte(buf, (uint8_t)(value >> 16));
+  rc_jit_byte(buf, (uint8_t)(value >> 24));
+}
+
+static void rc_jit_opcode(rc_jit_buffer_t* buf, int wide, uint32_t opcode, int reg, int rm) {
+  const uint8_t rex = (uint8_t)(0x40 | (wide ? 0x08 : 0) | ((reg & 8) ? 0x04 : 0) | ((rm & 8) ? 0x01 : 0));
+  if (rex != 0x40)
+    rc_jit_byte(buf, rex);
+
+  if (opcode > 0xFF)
+    rc_jit_byte(buf, (uint8_t)(opcode >> 8));
+  rc_jit_byte(buf, (uint8_t)opcode);
+}
+
+/* <opcode> reg, rm - where rm is a register */
+static void rc_jit_op_rr(rc_jit_buffer_t* buf, uint32_t opcode, int reg, int rm) {
+  rc_jit_opcode(buf, 0, opcode, reg, rm);
+  rc_jit_byte(buf, (uint8_t)(0xC0 | ((reg & 7) << 3) | (rm & 7)));
+}
+
+/* <opcode> reg, [base + offset] */
+static void rc_jit_op_rm_wide(rc_jit_buffer_t* buf, int wide, uint32_t opcode, int reg, int base, uint32_t offset) {
+  const int is_short = (offset < 0x80);
+  rc_jit_opcode(buf, wide, opcode, reg, base);
+  rc_jit_byte(buf, (uint8_t)((is_short ? 0x40 : 0x80) | ((reg & 7) << 3) | (base & 7)));
+  if ((base & 7) == 4)
+    rc_jit_byte(buf, 0x24); /* rsp and r12 need a SIB byte */
+
+  if (is_short)
+    rc_jit_byte(buf, (uint8_t)offset);
+  else
+    rc_jit_dword(buf, offset);
+}
+
+static void rc_jit_op_rm(rc_jit_buffer_t* buf, uint32_t opcode, int reg, int base, uint32_t offset) {
+  rc_jit_op_rm_wide(buf, 0, opcode, reg, base, offset);
+}
+
+static void rc_jit_push(rc_jit_buffer_t* buf, int reg) {
+  rc_jit_opcode(buf, 0, 0x50 + (reg & 7), 0, reg);
+}
+
+static void rc_jit_pop(rc_jit_buffer_t* buf, int reg) {
+  rc_jit_opcode(buf, 0, 0x58 + (reg & 7), 0, reg);
+}
+
+/* mov reg, imm64 */
+static void rc_jit_mov_r64_imm(rc_jit_buffer_t* buf, int reg, const void* pointer) {
+  const uint64_t value = (uint64_t)(uintptr_t)pointer;
+  rc_jit_opcode(buf, 1, 0xB8 + (reg & 7), 0, reg);
+  rc_jit_dword(buf, (uint32_t)value);
+  rc_jit_dword(buf, (uint32_t)(value >> 32));
+}
+
+/* mov reg, imm32 */
+static void rc_jit_mov_r32_imm(rc_jit_buffer_t* buf, int reg, uint32_t value) {
+  if (value == 0) {
+    rc_jit_op_rr(buf, 0x31, reg, reg); /* xor reg, reg */
+  }
+  else {
+    rc_jit_opcode(buf, 0, 0xB8 + (reg & 7), 0, reg);
+    rc_jit_dword(buf, value);
+  }
+}
+
+/* mov byte [base + offset], imm8 */
+static void rc_jit_mov_m8_imm(rc_jit_buffer_t* buf, int base, uint32_t offset, uint8_t value) {
+  rc_jit_op_rm(buf, 0xC6, 0, base, offset);
+  rc_jit_byte(buf, value);
+}
+
+/* setcc al; movzx eax, al */
+static void rc_jit_set_eax(rc_jit_buffer_t* buf, uint8_t cc) {
+  rc_jit_op_rr(buf, 0x0F90 + cc, 0, RC_JIT_RAX);
+  rc_jit_op_rr(buf, 0x0FB6, RC_JIT_RAX, RC_JIT_RAX);
+}
+
+/* jcc rel8 (or jmp rel8 if cc is 0xFF). returns the location to pass to rc_jit_bind */
+static uint32_t rc_jit_jump(rc_jit_buffer_t* buf, uint8_t cc) {
+  rc_jit_byte(buf, (cc == 0xFF) ? 0xEB : (uint8_t)(0x70 + cc));
+  rc_jit_byte(buf, 0);
+  return buf->size;
+}
+
+/* points a jump returned by rc_jit_jump at the current location */
+static void rc_jit_bind(rc_jit_buffer_t* buf, uint32_t jump) {
+  const uint32_t distance = buf->size - jump;
+  if (buf->failed)
+    return;
+
+  if (distance > 127)
+    buf->failed = 1;
+  else
+    buf->data[jump - 1] = (uint8_t)distance;
+}
+
+/* ===== code generation ===== */
+
+/* the memory layout of the structures accessed by the generated code */
+#define RC_JIT_EVAL(field) RC_JIT_OFFSET(rc_eval_state_t, field)
+#define RC_JIT_COND(field) RC_JIT_OFFSET(rc_condition_t, field)
+#define RC_JIT_MEMREF(field) (RC_JIT_OFFSET(rc_memref_t, value) + RC_JIT_OFFSET(rc_memref_value_t, field))
+#define RC_JIT_OPERAND_MEMREF(operand) (RC_JIT_COND(operand) + RC_JIT_OFFSET(rc_operand_t, value.memref))
+#define RC_JIT_OPERAND_NUM(operand) (RC_JIT_COND(operand) + RC_JIT_OFFSET(rc_operand_t, value.num))
+#define RC_JIT_MEASURED_VALUE (RC_JIT_EVAL(measured_value) + RC_JIT_OFFSET(rc_typed_value_t, value))
+#define RC_JIT_MEASURED_TYPE (RC_JIT_EVAL(measured_value) + RC_JIT_OFFSET(rc_typed_value_t, type))
+
+/* the chain state is known while generating the code. a flag is only kept in its register after
+ * a condition that sets it (AndNext, OrNext, ResetNextIf, AddHits, SubHits). otherwise, it still has
+ * the value it had when the segment was entered, and the code that would look at it isn't generated. */
+typedef struct rc_jit_chain_t {
+  uint8_t and_next;
+  uint8_t or_next;
+  uint8_t reset_next;
+  uint8_t add_hits;
+
+  /* whether any condition in the segment uses the callee-saved registers */
+  uint8_t uses_reset_next;
+  uint8_t uses_add_hits;
+}
+rc_jit_chain_t;
+
+static int rc_jit_is_condition_supported(const rc_condition_t* condition) {
+  switch (condition->type) {
+    case RC_CONDITION_ADD_SOURCE:
+    case RC_CONDITION_SUB_SOURCE:
+    case RC_CONDITION_ADD_ADDRESS:
+    case RC_CONDITION_REMEMBER:
+      /* these are handled by rc_modified_memref_t. no code is generated for them */
+      return 1;
+
+    case RC_CONDITION_MEASURED:
+      /* Measured without a hit target has to evaluate the left operand */
+      if (condition->required_hits == 0)
+        return 0;
+      break;
+
+    case RC_CONDITION_STANDARD:
+    case RC_CONDITION_PAUSE_IF:
+    case RC_CONDITION_RESET_IF:
+    case RC_CONDITION_TRIGGER:
+    case RC_CONDITION_MEASURED_IF:
+    case RC_CONDITION_ADD_HITS:
+    case RC_CONDITION_SUB_HITS:
+    case RC_CONDITION_RESET_NEXT_IF:
+    case RC_CONDITION_AND_NEXT:
+    case RC_CONDITION_OR_NEXT:
+      break;
+
+    default:
+      return 0;
+  }
+
+  /* only integer comparisons of unmodified memrefs are supported */
+  switch (condition->optimized_comparator) {
+    case RC_PROCESSING_COMPARE_MEMREF_TO_CONST:
+    case RC_PROCESSING_COMPARE_DELTA_TO_CONST:
+    case RC_PROCESSING_COMPARE_MEMREF_TO_MEMREF:
+    case RC_PROCESSING_COMPARE_MEMREF_TO_DELTA:
+    case RC_PROCESSING_COMPARE_DELTA_TO_MEMREF:
+    case RC_PROCESSING_COMPARE_ALWAYS_TRUE:
+    case RC_PROCESSING_COMPARE_ALWAYS_FALSE:
+      return 1;
+
+    default:
+      return 0;
+  }
+}
+
+static uint8_t rc_jit_condition_code(uint8_t oper) {
+  switch (oper) {
+    case RC_OPERATOR_EQ: return RC_JIT_CC_E;
+    case RC_OPERATOR_NE: return RC_JIT_CC_NE;
+    case RC_OPERATOR_LT: return RC_JIT_CC_B;
+    case RC_OPERATOR_LE: return RC_JIT_CC_BE;
+    case RC_OPERATOR_GT: return RC_JIT_CC_A;
+    default: return RC_JIT_CC_AE;
+  }
+}
+
+/* loads the delta value of the memref in rax into reg */
+static void rc_jit_load_delta(rc_jit_buffer_t* buf, int reg) {
+  rc_jit_op_rm(buf, 0x8B, reg, RC_JIT_RAX, RC_JIT_MEMREF(value));           /* mov reg, [rax+value] */
+  rc_jit_op_rm(buf, 0x80, 7, RC_JIT_RAX, RC_JIT_MEMREF(changed));           /* cmp byte [rax+changed], 0 */
+  rc_jit_byte(buf, 0);
+  rc_jit_op_rm(buf, 0x0F45, reg, RC_JIT_RAX, RC_JIT_MEMREF(prior));         /* cmovne reg, [rax+prior] */
+}
+
+/* loads the memref of an operand of the condition into rax */
+static void rc_jit_load_memref(rc_jit_buffer_t* buf, uint32_t operand) {
+  rc_jit_op_rm_wide(buf, 1, 0x8B, RC_JIT_RAX, RC_JIT_CONDITION, operand);   /* mov rax, [cond+operand] */
+}
+
+/* matches rc_test_condition. leaves the result in eax */
+static void rc_jit_emit_compare(rc_jit_buffer_t* buf, const rc_condition_t* condition, uint32_t cond) {
+  const uint8_t cc = rc_jit_condition_code(condition->oper);
+
+  switch (condition->optimized_comparator) {
+    case RC_PROCESSING_COMPARE_MEMREF_TO_CONST:
+      rc_jit_load_memref(buf, cond + RC_JIT_OPERAND_MEMREF(operand1));
+      rc_jit_op_rm(buf, 0x8B, RC_JIT_RCX, RC_JIT_RAX, RC_JIT_MEMREF(value));
+      rc_jit_op_rm(buf, 0x3B, RC_JIT_RCX, RC_JIT_CONDITION, cond + RC_JIT_OPERAND_NUM(operand2));
+      rc_jit_set_eax(buf, cc);
+      break;
+
+    case RC_PROCESSING_COMPARE_DELTA_TO_CONST:
+      rc_jit_load_memref(buf, cond + RC_JIT_OPERAND_MEMREF(operand1));
+      rc_jit_load_delta(buf, RC_JIT_RCX);
+      rc_jit_op_rm(buf, 0x3B, RC_JIT_RCX, RC_JIT_CONDITION, cond + RC_JIT_OPERAND_NUM(operand2));
+      rc_jit_set_eax(buf, cc);
+      break;
+
+    case RC_PROCESSING_COMPARE_MEMREF_TO_MEMREF:
+      rc_jit_load_memref(buf, cond + RC_JIT_OPERAND_MEMREF(operand1));
+      rc_jit_op_rm(buf, 0x8B, RC_JIT_RCX, RC_JIT_RAX, RC_JIT_MEMREF(value));
+      rc_jit_load_memref(buf, cond + RC_JIT_OPERAND_MEMREF(operand2));
+      rc_jit_op_rm(buf, 0x3B, RC_JIT_RCX, RC_JIT_RAX, RC_JIT_MEMREF(value)); /* cmp ecx, [rax+value] */
+      rc_jit_set_eax(buf, cc);
+      break;
+
+    case RC_PROCESSING_COMPARE_MEMREF_TO_DELTA:
+      /* both operands are the same memref. if it hasn't changed, it's compared to itself */
+      rc_jit_load_memref(buf, cond + RC_JIT_OPERAND_MEMREF(operand1));
+      rc_jit_op_rm(buf, 0x8B, RC_JIT_RCX, RC_JIT_RAX, RC_JIT_MEMREF(value));
+      rc_jit_load_delta(buf, RC_JIT_R8);
+      rc_jit_op_rr(buf, 0x3B, RC_JIT_RCX, RC_JIT_R8);                         /* cmp ecx, r8d */
+      rc_jit_set_eax(buf, cc);
+      break;
+
+    case RC_PROCESSING_COMPARE_DELTA_TO_MEMREF:
+      rc_jit_load_memref(buf, cond + RC_JIT_OPERAND_MEMREF(operand1));
+      rc_jit_op_rm(buf, 0x8B, RC_JIT_RCX, RC_JIT_RAX, RC_JIT_MEMREF(value));
+      rc_jit_load_delta(buf, RC_JIT_R8);
+      rc_jit_op_rr(buf, 0x3B, RC_JIT_R8, RC_JIT_RCX);                         /* cmp r8d, ecx */
+      rc_jit_set_eax(buf, cc);
+      break;
+
+    case RC_PROCESSING_COMPARE_ALWAYS_TRUE:
+      rc_jit_mov_r32_imm(buf, RC_JIT_RAX, 1);
+      break;
+
+    default:
+      rc_jit_mov_r32_imm(buf, RC_JIT_RAX, 0);
+      break;
+  }
+}
+
+/* the part of rc_condset_evaluate_condition_no_add_hits after the chained logic flags have been applied.
+ * it's the same for every condition, so it's generated once per pool and called with the condition in rcx
+ * and the result of the chained logic in eax. leaves cond_valid in eax */
+static void rc_jit_emit_hits_routine(rc_jit_buffer_t* buf) {
+  uint32_t is_false, untargeted, hit_met, no_hits;
+
+  rc_jit_op_rm(buf, 0x8B, RC_JIT_R8, RC_JIT_RCX, RC_JIT_COND(current_hits));                /* mov r8d, [rcx+current_hits] */
+  rc_jit_op_rm(buf, 0x8B, RC_JIT_R9, RC_JIT_RCX, RC_JIT_COND(required_hits));               /* mov r9d, [rcx+required_hits] */
+  rc_jit_op_rr(buf, 0x85, RC_JIT_RAX, RC_JIT_RAX);                                          /* test eax, eax */
+  is_false = rc_jit_jump(buf, RC_JIT_CC_E);
+
+  /* true conditions should update their hit count */
+  rc_jit_mov_m8_imm(buf, RC_JIT_STATE, RC_JIT_EVAL(has_hits), 1);
+  rc_jit_op_rr(buf, 0x85, RC_JIT_R9, RC_JIT_R9);                                            /* test r9d, r9d */
+  untargeted = rc_jit_jump(buf, RC_JIT_CC_E);
+
+  /* only true if the hit count becomes met. if it was already met, do nothing */
+  rc_jit_op_rr(buf, 0x3B, RC_JIT_R8, RC_JIT_R9);                                            /* cmp r8d, r9d */
+  hit_met = rc_jit_jump(buf, RC_JIT_CC_AE);
+  rc_jit_op_rr(buf, 0xFF, 0, RC_JIT_R8);                                                    /* inc r8d */
+  rc_jit_op_rm(buf, 0x89, RC_JIT_R8, RC_JIT_RCX, RC_JIT_COND(current_hits));
+  rc_jit_mov_r32_imm(buf, RC_JIT_RAX, 0);
+  rc_jit_op_rr(buf, 0x3B, RC_JIT_R8, RC_JIT_R9);
+  rc_jit_op_rr(buf, 0x0F94, 0, RC_JIT_RAX);                                                 /* sete al */
+  rc_jit_byte(buf, 0xC3);                                                                   /* ret */
+
+  /* no target hit count, just keep tallying */
+  rc_jit_bind(buf, untargeted);
+  rc_jit_op_rm(buf, 0xFF, 0, RC_JIT_RCX, RC_JIT_COND(current_hits));                        /* inc [rcx+current_hits] */
+  rc_jit_bind(buf, hit_met);
+  rc_jit_byte(buf, 0xC3);
+
+  /* target has been true in the past, if the hit target is met, consider it true now */
+  rc_jit_bind(buf, is_false);
+  rc_jit_op_rr(buf, 0x85, RC_JIT_R8, RC_JIT_R8);                                            /* test r8d, r8d */
+  no_hits = rc_jit_jump(buf, RC_JIT_CC_E);
+  rc_jit_mov_m8_imm(buf, RC_JIT_STATE, RC_JIT_EVAL(has_hits), 1);
+  rc_jit_op_rr(buf, 0x3B, RC_JIT_R8, RC_JIT_R9);
+  rc_jit_op_rr(buf, 0x0F94, 0, RC_JIT_RAX);                                                 /* sete al (eax is 0) */
+  rc_jit_bind(buf, no_hits);
+  rc_jit_byte(buf, 0xC3);
+}
+
+/* matches rc_condset_evaluate_condition_no_add_hits. expects the comparison result in eax and
+ * leaves cond_valid in eax. cond is the offset of the condition from the first condition in the segment */
+static void rc_jit_emit_update_hits(rc_jit_buffer_t* buf, uint32_t cond, rc_jit_chain_t* chain) {
+  uint32_t not_reset = RC_JIT_NO_CODE, was_reset = RC_JIT_NO_CODE;
+
+  rc_jit_op_rm(buf, 0x88, RC_JIT_RAX, RC_JIT_CONDITION, cond + RC_JIT_COND(is_true));     /* mov [cond+is_true], al */
+
+  if (chain->reset_next) {
+    /* previous ResetNextIf resets the hit count on this condition and prevents it from being true */
+    rc_jit_op_rr(buf, 0x85, RC_JIT_RESET_NEXT, RC_JIT_RESET_NEXT);                        /* test r15d, r15d */
+    not_reset = rc_jit_jump(buf, RC_JIT_CC_E);
+    rc_jit_op_rm(buf, 0x83, 7, RC_JIT_CONDITION, cond + RC_JIT_COND(current_hits));       /* cmp [cond+current_hits], 0 */
+    rc_jit_byte(buf, 0);
+    rc_jit_op_rr(buf, 0x0F95, 0, RC_JIT_RCX);                                             /* setne cl */
+    rc_jit_op_rm(buf, 0x08, RC_JIT_RCX, RC_JIT_STATE, RC_JIT_EVAL(was_cond_reset));       /* or [state+was_cond_reset], cl */
+    rc_jit_op_rm(buf, 0xC7, 0, RC_JIT_CONDITION, cond + RC_JIT_COND(current_hits));       /* mov [cond+current_hits], 0 */
+    rc_jit_dword(buf, 0);
+    rc_jit_mov_r32_imm(buf, RC_JIT_RAX, 0);
+    was_reset = rc_jit_jump(buf, 0xFF);
+    rc_jit_bind(buf, not_reset);
+  }
+
+  /* apply chained logic flags */
+  if (chain->and_next)
+    rc_jit_op_rr(buf, 0x23, RC_JIT_RAX, RC_JIT_AND_NEXT);                                 /* and eax, r10d */
+  if (chain->or_next)
+    rc_jit_op_rr(buf, 0x0B, RC_JIT_RAX, RC_JIT_OR_NEXT);                                  /* or eax, r11d */
+
+  rc_jit_op_rm_wide(buf, 1, 0x8D, RC_JIT_RCX, RC_JIT_CONDITION, cond);                    /* lea rcx, [cond] */
+  rc_jit_op_rr(buf, 0xFF, 2, RC_JIT_HITS);                                                /* call rdx */
+
+  if (was_reset != RC_JIT_NO_CODE)
+    rc_jit_bind(buf, was_reset);
+
+  /* reset chained logic flags for the next condition */
+  chain->and_next = chain->or_next = 0;
+}
+
+/* matches rc_condset_evaluate_total_hits for a condition with a hit target. leaves the total in ecx.
+ * the accumulator is zero afterwards, which is also its value when the segment was entered */
+static void rc_jit_emit_total_hits(rc_jit_buffer_t* buf, uint32_t cond, rc_jit_chain_t* chain) {
+  rc_jit_mov_r32_imm(buf, RC_JIT_R8, 0);
+  rc_jit_op_rm(buf, 0x8B, RC_JIT_RCX, RC_JIT_CONDITION, cond + RC_JIT_COND(current_hits));
+  if (chain->add_hits)
+    rc_jit_op_rr(buf, 0x03, RC_JIT_RCX, RC_JIT_ADD_HITS);                                 /* add ecx, ebx */
+  else
+    rc_jit_op_rr(buf, 0x85, RC_JIT_RCX, RC_JIT_RCX);                                      /* test ecx, ecx */
+  rc_jit_op_rr(buf, 0x0F48, RC_JIT_RCX, RC_JIT_R8);                                       /* cmovs ecx, r8d */
+
+  chain->add_hits = 0;
+}
+
+/* matches rc_condset_evaluate_condition. leaves cond_valid in eax */
+static void rc_jit_emit_evaluate(rc_jit_buffer_t* buf, const rc_condition_t* condition, uint32_t cond,
+                                 rc_jit_chain_t* chain) {
+  uint32_t no_add_hits;
+
+  rc_jit_emit_update_hits(buf, cond, chain);
+
+  /* the accumulator is only cleared if it's non-zero and the condition has a target. in both
+   * cases, it's zero afterwards, and ebx isn't looked at again until another AddHits reloads it */
+  if (chain->add_hits && condition->required_hits != 0) {
+    rc_jit_op_rr(buf, 0x85, RC_JIT_ADD_HITS, RC_JIT_ADD_HITS);                            /* test ebx, ebx */
+    no_add_hits = rc_jit_jump(buf, RC_JIT_CC_E);
+    rc_jit_emit_total_hits(buf, cond, chain);
+    rc_jit_op_rm(buf, 0x3B, RC_JIT_RCX, RC_JIT_CONDITION, cond + RC_JIT_COND(required_hits));
+    rc_jit_set_eax(buf, RC_JIT_CC_AE);
+    rc_jit_bind(buf, no_add_hits);
+  }
+
+  chain->reset_next = 0;
+}
+
+static void rc_jit_emit_prologue(rc_jit_buffer_t* buf, const void* hits, const rc_jit_chain_t* chain) {
+  if (chain->uses_add_hits)
+    rc_jit_push(buf, RC_JIT_ADD_HITS);
+  if (chain->uses_reset_next)
+    rc_jit_push(buf, RC_JIT_RESET_NEXT);
+
+  rc_jit_mov_r64_imm(buf, RC_JIT_HITS, hits);
+}
+
+static void rc_jit_emit_epilogue(rc_jit_buffer_t* buf, const rc_jit_chain_t* chain) {
+  /* write back any chain flags that were changed. the others still have their initial values */
+  if (chain->and_next)
+    rc_jit_op_rm(buf, 0x88, RC_JIT_AND_NEXT, RC_JIT_STATE, RC_JIT_EVAL(and_next));
+  if (chain->or_next)
+    rc_jit_op_rm(buf, 0x88, RC_JIT_OR_NEXT, RC_JIT_STATE, RC_JIT_EVAL(or_next));
+  if (chain->reset_next)
+    rc_jit_op_rm(buf, 0x88, RC_JIT_RESET_NEXT, RC_JIT_STATE, RC_JIT_EVAL(reset_next));
+  if (chain->add_hits)
+    rc_jit_op_rm(buf, 0x89, RC_JIT_ADD_HITS, RC_JIT_STATE, RC_JIT_EVAL(add_hits));
+
+  if (chain->uses_reset_next)
+    rc_jit_pop(buf, RC_JIT_RESET_NEXT);
+  if (chain->uses_add_hits)
+    rc_jit_pop(buf, RC_JIT_ADD_HITS);
+  rc_jit_byte(buf, 0xC3); /* ret */
+}
+
+/* matches the handlers called by rc_test_condset_internal, with can_short_curcuit not set */
+static void rc_jit_emit_condition(rc_jit_buffer_t* buf, const rc_condition_t* condition, uint32_t cond,
+                                  rc_jit_chain_t* chain) {
+  uint32_t skip;
+
+  switch (condition->type) {
+    case RC_CONDITION_ADD_SOURCE:
+    case RC_CONDITION_SUB_SOURCE:
+    case RC_CONDITION_ADD_ADDRESS:
+    case RC_CONDITION_REMEMBER:
+      return;
+
+    default:
+      break;
+  }
+
+  rc_jit_emit_compare(buf, condition, cond);
+
+  switch (condition->type) {
+    case RC_CONDITION_STANDARD:
+      rc_jit_emit_evaluate(buf, condition, cond, chain);
+      rc_jit_op_rm(buf, 0x20, RC_JIT_RAX, RC_JIT_STATE, RC_JIT_EVAL(is_true));            /* and [state+is_true], al */
+      rc_jit_op_rm(buf, 0x20, RC_JIT_RAX, RC_JIT_STATE, RC_JIT_EVAL(is_primed));
+      break;
+
+    case RC_CONDITION_PAUSE_IF:
+      rc_jit_emit_evaluate(buf, condition, cond, chain);
+      rc_jit_op_rr(buf, 0x85, RC_JIT_RAX, RC_JIT_RAX);
+      skip = rc_jit_jump(buf, RC_JIT_CC_E);
+      rc_jit_mov_m8_imm(buf, RC_JIT_STATE, RC_JIT_EVAL(is_paused), 1);
+      rc_jit_mov_m8_imm(buf, RC_JIT_STATE, RC_JIT_EVAL(is_true), 0);
+      rc_jit_mov_m8_imm(buf, RC_JIT_STATE, RC_JIT_EVAL(is_primed), 0);
+      rc_jit_mov_m8_imm(buf, RC_JIT_STATE, RC_JIT_EVAL(stop_processing), 1);
+      /* as soon as we find a PauseIf that evaluates to true, stop processing the rest of the group */
+      rc_jit_emit_epilogue(buf, chain);
+      rc_jit_bind(buf, skip);
+      if (condition->required_hits == 0) {
+        rc_jit_op_rm(buf, 0xC7, 0, RC_JIT_CONDITION, cond + RC_JIT_COND(current_hits));
+        rc_jit_dword(buf, 0);
+      }
+      break;
+
+    case RC_CONDITION_RESET_IF:
+      rc_jit_emit_evaluate(buf, condition, cond, chain);
+      rc_jit_op_rr(buf, 0x85, RC_JIT_RAX, RC_JIT_RAX);
+      skip = rc_jit_jump(buf, RC_JIT_CC_E);
+      rc_jit_op_rm(buf, 0x80, 1, RC_JIT_CONDITION, cond + RC_JIT_COND(is_true));          /* or [cond+is_true], 2 */
+      rc_jit_byte(buf, 0x02);
+      rc_jit_mov_m8_imm(buf, RC_JIT_STATE, RC_JIT_EVAL(is_true), 0);
+      rc_jit_mov_m8_imm(buf, RC_JIT_STATE, RC_JIT_EVAL(is_primed), 0);
+      rc_jit_mov_m8_imm(buf, RC_JIT_STATE, RC_JIT_EVAL(was_reset), 1);
+      rc_jit_mov_m8_imm(buf, RC_JIT_STATE, RC_JIT_EVAL(stop_processing), 1);
+      rc_jit_bind(buf, skip);
+      break;
+
+    case RC_CONDITION_TRIGGER:
+      rc_jit_emit_evaluate(buf, condition, cond, chain);
+      rc_jit_op_rm(buf, 0x20, RC_JIT_RAX, RC_JIT_STATE, RC_JIT_EVAL(is_true));
+      break;
+
+    case RC_CONDITION_MEASURED:
+      /* only Measured with a hit target is supported. capture the total hits */
+      rc_jit_emit_update_hits(buf, cond, chain);
+      rc_jit_emit_total_hits(buf, cond, chain);
+      rc_jit_op_rm(buf, 0x3B, RC_JIT_RCX, RC_JIT_CONDITION, cond + RC_JIT_COND(required_hits));
+      rc_jit_set_eax(buf, RC_JIT_CC_AE);
+      rc_jit_op_rm(buf, 0x20, RC_JIT_RAX, RC_JIT_STATE, RC_JIT_EVAL(is_true));
+      rc_jit_op_rm(buf, 0x20, RC_JIT_RAX, RC_JIT_STATE, RC_JIT_EVAL(is_primed));
+      rc_jit_op_rm(buf, 0x89, RC_JIT_RCX, RC_JIT_STATE, RC_JIT_MEASURED_VALUE);
+      rc_jit_mov_m8_imm(buf, RC_JIT_STATE, RC_JIT_MEASURED_TYPE, RC_VALUE_TYPE_UNSIGNED);
+      rc_jit_mov_m8_imm(buf, RC_JIT_STATE, RC_JIT_EVAL(measured_from_hits), 1);
+      chain->reset_next = 0;
+      break;
+
+    case RC_CONDITION_MEASURED_IF:
+      rc_jit_emit_evaluate(buf, condition, cond, chain);
+      rc_jit_op_rm(buf, 0x20, RC_JIT_RAX, RC_JIT_STATE, RC_JIT_EVAL(is_true));
+      rc_jit_op_rm(buf, 0x20, RC_JIT_RAX, RC_JIT_STATE, RC_JIT_EVAL(is_primed));
+      rc_jit_op_rm(buf, 0x20, RC_JIT_RAX, RC_JIT_STATE, RC_JIT_EVAL(can_measure));
+      break;
+
+    case RC_CONDITION_ADD_HITS:
+    case RC_CONDITION_SUB_HITS:
+      rc_jit_emit_update_hits(buf, cond, chain);
+      if (!chain->add_hits) {
+        rc_jit_mov_r32_imm(buf, RC_JIT_ADD_HITS, 0);
+        chain->add_hits = 1;
+      }
+      /* add/sub ebx, [cond+current_hits] */
+      rc_jit_op_rm(buf, (condition->type == RC_CONDITION_ADD_HITS) ? 0x03 : 0x2B,
+                   RC_JIT_ADD_HITS, RC_JIT_CONDITION, cond + RC_JIT_COND(current_hits));
+      chain->reset_next = 0;
+      break;
+
+    case RC_CONDITION_RESET_NEXT_IF:
+      rc_jit_emit_update_hits(buf, cond, chain);
+      rc_jit_op_rr(buf, 0x89, RC_JIT_RAX, RC_JIT_RESET_NEXT);                             /* mov r15d, eax */
+      chain->reset_next = 1;
+      break;
+
+    case RC_CONDITION_AND_NEXT:
+      rc_jit_emit_update_hits(buf, cond, chain);
+      rc_jit_op_rr(buf, 0x89, RC_JIT_RAX, RC_JIT_AND_NEXT);                               /* mov r10d, eax */
+      chain->and_next = 1;
+      break;
+
+    case RC_CONDITION_OR_NEXT:
+      rc_jit_emit_update_hits(buf, cond, chain);
+      rc_jit_op_rr(buf, 0x89, RC_JIT_RAX, RC_JIT_OR_NEXT);                                /* mov r11d, eax */
+      chain->or_next = 1;
+      break;
+
+    default:
+      buf->failed = 1;
+      break;
+  }
+}
+
+/* determines whether code can be generated for a segment of conditions */
+static int rc_jit_is_segment_supported(const rc_condition_t* conditions, uint32_t num_conditions) {
+  uint32_t i;
+
+  if (num_conditions == 0)
+    return 0;
+
+  for (i = 0; i < num_conditions; ++i) {
+    if (!rc_jit_is_condition_supported(&conditions[i]))
+      return 0;
+  }
+
+  return 1;
+}
+
+/* generates a function for a segment of conditions. the generated code only depends on the
+ * shape of the segment (see rc_jit_shape_key). the operands are read from the conditions */
+static void rc_jit_emit_segment(rc_jit_buffer_t* buf, const rc_condition_t* conditions, uint32_t num_conditions,
+                                const void* hits) {
+  rc_jit_chain_t chain;
+  uint32_t i;
+
+  /* rc_test_condset_native only calls the function if no chain is carried into the segment */
+  memset(&chain, 0, sizeof(chain));
+
+  for (i = 0; i < num_conditions; ++i) {
+    switch (conditions[i].type) {
+      case RC_CONDITION_RESET_NEXT_IF:
+        chain.uses_reset_next = 1;
+        break;
+
+      case RC_CONDITION_ADD_HITS:
+      case RC_CONDITION_SUB_HITS:
+        chain.uses_add_hits = 1;
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  rc_jit_emit_prologue(buf, hits, &chain);
+
+  for (i = 0; i < num_conditions; ++i)
+    rc_jit_emit_condition(buf, &conditions[i], i * (uint32_t)sizeof(rc_condition_t), &chain);
+
+  rc_jit_emit_epilogue(buf, &chain);
+}
+
+/* ===== code pool ===== */
+
+/* a mapping that holds generated code */
+typedef struct rc_jit_chunk_t {
+  struct rc_jit_chunk_t* next;
+  uint8_t* code;
+  size_t size;
+  size_t used;
+}
+rc_jit_chunk_t;
+
+/* the generated code for a segment shape */
+typedef struct rc_jit_shape_t {
+  struct rc_jit_shape_t* next;
+  rc_condset_native_func_t func;
+  uint32_t hash;
+  uint32_t key_size;
+  /* followed by key_size bytes of key */
+}
+rc_jit_shape_t;
+
+#define RC_JIT_SHAPE_BUCKETS 64
+
+/* triggers are made of a small number of condition patterns, so segments from different triggers
+ * (and different sets) frequently generate identical code. the code is shared, which keeps the
+ * amount of code executed each frame small enough to stay in the instruction cache, and it lives
+ * as long as the pool */
+struct rc_trigger_jit_pool_t {
+  rc_jit_chunk_t* chunks;                        /* new code is added to the first chunk */
+  rc_jit_shape_t* shapes[RC_JIT_SHAPE_BUCKETS];
+  const void* hits;                              /* see rc_jit_emit_hits_routine */
+  uint8_t failed;                                /* see rc_trigger_jit_pool_failed */
+};
+
+#define RC_JIT_CHUNK_SIZE 0x10000
+#define RC_JIT_CODE_ALIGNMENT 16
+
+static rc_jit_chunk_t* rc_jit_chunk_alloc(uint32_t size) {
+  const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+  rc_jit_chunk_t* chunk;
+  void* mapping;
+
+  chunk = (rc_jit_chunk_t*)malloc(sizeof(rc_jit_chunk_t));
+  if (!chunk)
+    return NULL;
+
+  chunk->size = (size > RC_JIT_CHUNK_SIZE) ? size : RC_JIT_CHUNK_SIZE;
+  chunk->size = (chunk->size + page_size - 1) & ~(page_size - 1);
+  chunk->used = 0;
+  chunk->next = NULL;
+
+  mapping = mmap(NULL, chunk->size, PROT_READ | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapping == MAP_FAILED) {
+    free(chunk);
+    return NULL;
+  }
+
+  chunk->code = (uint8_t*)mapping;
+  return chunk;
+}
+
+/* copies the code into the pool. returns the address of the copy, or NULL on failure */
+static uint8_t* rc_jit_pool_add(rc_trigger_jit_pool_t* pool, const uint8_t* code, uint32_t size) {
+  rc_jit_chunk_t* chunk = pool->chunks;
+  uint8_t* address;
+
+  if (pool->failed)
+    return NULL;
+
+  if (!chunk || chunk->used + size > chunk->size) {
+    chunk = rc_jit_chunk_alloc(size);
+    if (!chunk)
+      return NULL;
+
+    chunk->next = pool->chunks;
+    pool->chunks = chunk;
+  }
+
+  /* the pages are never writable and executable at the same time. code is only generated while
+   * the runtime is processing a frame, so none of the code in the chunk can be running. if either
+   * mprotect fails, the code already in the chunk may no longer be executable, so the pool is marked
+   * as failed and the caller has to release it before evaluating any of its code */
+  if (mprotect(chunk->code, chunk->size, PROT_READ | PROT_WRITE) != 0) {
+    pool->failed = 1;
+    return NULL;
+  }
+
+  address = chunk->code + chunk->used;
+  memcpy(address, code, size);
+
+  chunk->used += size;
+  while (chunk->used & (RC_JIT_CODE_ALIGNMENT - 1))
+    chunk->code[chunk->used++] = 0xCC; /* int3 */
+
+  if (mprotect(chunk->code, chunk->size, PROT_READ | PROT_EXEC) != 0) {
+    pool->failed = 1;
+    return NULL;
+  }
+
+  return address;
+}
+
+static rc_condset_native_func_t rc_jit_function(uint8_t* address) {
+  rc_condset_native_func_t func;
+
+  /* ISO C doesn't allow casting between object and function pointers */
+  memcpy(&func, &address, sizeof(func));
+  return func;
+}
+
+rc_trigger_jit_pool_t* rc_trigger_jit_pool_create(void) {
+  rc_trigger_jit_pool_t* pool;
+  rc_jit_buffer_t buf;
+
+  pool = (rc_trigger_jit_pool_t*)calloc(1, sizeof(rc_trigger_jit_pool_t));
+  if (!pool)
+    return NULL;
+
+  memset(&buf, 0, sizeof(buf));
+  rc_jit_emit_hits_routine(&buf);
+
+  if (!buf.failed)
+    pool->hits = rc_jit_pool_add(pool, buf.data, buf.size);
+
+  free(buf.data);
+
+  if (!pool->hits) {
+    rc_trigger_jit_pool_destroy(pool);
+    return NULL;
+  }
+
+  return pool;
+}
+
+int rc_trigger_jit_pool_failed(const rc_trigger_jit_pool_t* pool) {
+  return pool && pool->failed;
+}
+
+void rc_trigger_jit_pool_destroy(rc_trigger_jit_pool_t* pool) {
+  rc_jit_chunk_t* chunk;
+  rc_jit_shape_t* shape;
+  uint32_t i;
+
+  if (!pool)
+    return;
+
+  while ((chunk = pool->chunks) != NULL) {
+    pool->chunks = chunk->next;
+    munmap(chunk->code, chunk->size);
+    free(chunk);
+  }
+
+  for (i = 0; i < RC_JIT_SHAPE_BUCKETS; ++i) {
+    while ((shape = pool->shapes[i]) != NULL) {
+      pool->shapes[i] = shape->next;
+      free(shape);
+    }
+  }
+
+  free(pool);
+}
+
+/* everything about the conditions that affects the generated code */
+static void rc_jit_shape_key(const rc_condition_t* conditions, uint32_t num_conditions, uint8_t* key) {
+  uint32_t i;
+
+  for (i = 0; i < num_conditions; ++i) {
+    *key++ = conditions[i].type;
+    *key++ = conditions[i].optimized_comparator;
+    *key++ = conditions[i].oper;
+    *key++ = (conditions[i].required_hits != 0) ? 1 : 0;
+  }
+}
+
+/* returns the function for a segment, generating it if no segment with the same shape has been seen */
+static rc_condset_native_func_t rc_jit_get_segment(rc_trigger_jit_pool_t* pool,
+                                                   const rc_condition_t* conditions, uint32_t num_conditions) {
+  const uint32_t key_size = num_conditions * 4;
+  rc_jit_shape_t* shape;
+  rc_jit_buffer_t buf;
+  uint8_t* key;
+  uint8_t* code;
+  uint32_t hash = 2166136261U, i;
+
+  if (!rc_jit_is_segment_supported(conditions, num_conditions))
+    return NULL;
+
+  shape = (rc_jit_shape_t*)malloc(sizeof(rc_jit_shape_t) + key_size);
+  if (!shape)
+    return NULL;
+
+  key = (uint8_t*)(shape + 1);
+  rc_jit_shape_key(conditions, num_conditions, key);
+  for (i = 0; i < key_size; ++i)
+    hash = (hash ^ key[i]) * 16777619U;
+
+  {
+    const rc_jit_shape_t* existing = pool->shapes[hash % RC_JIT_SHAPE_BUCKETS];
+    for (; existing; existing = existing->next) {
+      if (existing->hash == hash && existing->key_size == key_size &&
+          memcmp(existing + 1, key, key_size) == 0) {
+        free(shape);
+        return existing->func;
+      }
+    }
+  }
+
+  memset(&buf, 0, sizeof(buf));
+  rc_jit_emit_segment(&buf, conditions, num_conditions, pool->hits);
+
+  code = buf.failed ? NULL : rc_jit_pool_add(pool, buf.data, buf.size);
+  free(buf.data);
+
+  if (!code) {
+    free(shape);
+    return NULL;
+  }
+
+  shape->func = rc_jit_function(code);
+  shape->hash = hash;
+  shape->key_size = key_size;
+  shape->next = pool->shapes[hash % RC_JIT_SHAPE_BUCKETS];
+  pool->shapes[hash % RC_JIT_SHAPE_BUCKETS] = shape;
+
+  return shape->func;
+}
+
+/* returns non-zero if code was generated for any segment of the condset */
+static int rc_jit_compile_condset(rc_trigger_jit_pool_t* pool, rc_condset_t* condset, rc_condset_native_t* native) {
+  const rc_condition_t* conditions = rc_condset_get_conditions(condset);
+
+  native->pause = rc_jit_get_segment(pool, conditions, condset->num_pause_conditions);
+  conditions += condset->num_pause_conditions;
+  native->reset = rc_jit_get_segment(pool, conditions, condset->num_reset_conditions);
+  conditions += condset->num_reset_conditions;
+  native->hittarget = rc_jit_get_segment(pool, conditions, condset->num_hittarget_conditions);
+  conditions += condset->num_hittarget_conditions;
+  native->measured = rc_jit_get_segment(pool, conditions, condset->num_measured_conditions);
+  conditions += condset->num_measured_conditions;
+  native->other = rc_jit_get_segment(pool, conditions, condset->num_other_conditions);
+
+  return (native->pause || native->reset || native->hittarget || native->measured || native->other);
+}
+
+rc_trigger_jit_t* rc_trigger_jit_compile(const rc_trigger_t* trigger, rc_trigger_jit_pool_t* pool) {
+  rc_trigger_jit_t* jit;
+  rc_condset_t* condset;
+  int compiled = 0;
+  uint32_t i;
+
+  jit = (rc_trigger_jit_t*)calloc(1, sizeof(rc_trigger_jit_t));
+  if (!jit)
+    return NULL;
+
+  jit->trigger = trigger;
+  jit->num_condsets = 1;
+  for (condset = trigger->alternative; condset; condset = condset->next)
+    ++jit->num_condsets;
+
+  jit->condsets = (rc_condset_native_t*)calloc(jit->num_condsets, sizeof(rc_condset_native_t));
+  if (!jit->condsets) {
+    free(jit);
+    return NULL;
+  }
+
+  if (trigger->requirement)
+    compiled |= rc_jit_compile_condset(pool, trigger->requirement, &jit->condsets[0]);
+
+  i = 1;
+  for (condset = trigger->alternative; condset; condset = condset->next, ++i)
+    compiled |= rc_jit_compile_condset(pool, condset, &jit->condsets[i]);
+
+  /* if nothing was generated, the trigger will be processed by the interpreter. the empty jit
+   * is still returned so the caller knows not to try again */
+  if (!compiled) {
+    free(jit->condsets);
+    jit->condsets = NULL;
+  }
+
+  return jit;
+}
+
+void rc_trigger_jit_destroy(rc_trigger_jit_t* jit) {
+  if (!jit)
+    return;
+
+  /* the code belongs to the pool */
+  free(jit->condsets);
+  free(jit);
+}
+
+#else /* !RC_TRIGGER_JIT_SUPPORTED */
+
+rc_trigger_jit_pool_t* rc_trigger_jit_pool_create(void) {
+  return NULL;
+}
+
+int rc_trigger_jit_pool_failed(const rc_trigger_jit_pool_t* pool) {
+  (void)pool;
+  return 0;
+}
+
+void rc_trigger_jit_pool_destroy(rc_trigger_jit_pool_t* pool) {
+  (void)pool;
+}
+
+rc_trigger_jit_t* rc_trigger_jit_compile(const rc_trigger_t* trigger, rc_trigger_jit_pool_t* pool) {
+  (void)trigger;
+  (void)pool;
+  return NULL;
+}
+
+void rc_trigger_jit_destroy(rc_trigger_jit_t* jit) {
+  (void)jit;
+}
+
+#endif /* RC_TRIGGER_JIT_SUPPORTED */
@@ -108,6 +108,10 @@ static void rc_parse_legacy_value(rc_value_t* self, const char** memaddr, rc_par
 
     condset = (rc_condset_t*)condset_with_conditions;
     memset(condset, 0, sizeof(*condset));
+    if (parse->buffer) {
+      condset_with_conditions->has_hits = 0;
+      condset_with_conditions->is_selective = 0;
+    }
     condset->num_measured_conditions = num_measured_conditions;
     cond = &condset_with_conditions->conditions[0];
 
@@ -204,6 +208,8 @@ static void rc_parse_legacy_value(rc_value_t* self, const char** memaddr, rc_par
     cond->next = NULL;
     rc_condition_update_parse_state(cond, parse);
 
+    rc_condset_compile(condset, parse);
+
     /* finalize clause */
     *next_clause = condset;
     next_clause = &condset->next;
@@ -325,7 +331,7 @@ int rc_evaluate_value_typed(rc_value_t* self, rc_typed_value_t* value, rc_peek_t
       /* if any ResetIf condition was true, reset the hit counts
        * NOTE: ResetIf only affects the current condset when used in values!
        */
-      rc_reset_condset(condset);
+      rc_reset_condset_evaluated(condset);
     }
 
     if (eval_state.measured_value.type != RC_VALUE_TYPE_NONE) {
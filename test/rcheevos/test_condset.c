@@ -4883,6 +4883,181 @@ static void test_get_real_operand1_indirect_static()
   ASSERT_NUM_EQUALS(operand->is_combining, 0);
 }
 
+static void _assert_parse_condset_optimized(rc_condset_t** condset, rc_memrefs_t* memrefs, void* buffer, const char* memaddr, uint8_t optimize)
+{
+  rc_parse_state_t parse;
+  int size;
+
+  rc_init_parse_state(&parse, buffer);
+  rc_init_parse_state_memrefs(&parse, memrefs);
+  parse.optimize = optimize;
+
+  *condset = rc_parse_condset(&memaddr, &parse);
+  size = parse.offset;
+  rc_destroy_parse_state(&parse);
+
+  ASSERT_NUM_GREATER(size, 0);
+  ASSERT_PTR_NOT_NULL(*condset);
+}
+#define assert_parse_condset_optimized(condset, memrefs_out, buffer, memaddr, optimize) ASSERT_HELPER(_assert_parse_condset_optimized(condset, memrefs_out, buffer, memaddr, optimize), "assert_parse_condset_optimized")
+
+static void test_optimize_comparator(const char* memaddr, uint8_t expected_comparator)
+{
+  rc_condset_t* condset;
+  rc_condition_t* condition;
+  rc_memrefs_t memrefs;
+  char buffer[2048];
+
+  assert_parse_condset(&condset, &memrefs, buffer, memaddr);
+
+  condition = condset->conditions;
+  while (condition->next)
+    condition = condition->next;
+
+  ASSERT_NUM_EQUALS(condition->optimized_comparator, expected_comparator);
+}
+
+static void test_optimize_disabled()
+{
+  rc_condset_t* condset;
+  rc_memrefs_t memrefs;
+  char buffer[2048];
+
+  assert_parse_condset_optimized(&condset, &memrefs, buffer, "0xL0001<16", 0);
+  ASSERT_NUM_EQUALS(condset->conditions->optimized_comparator, RC_PROCESSING_COMPARE_MEMREF_TO_CONST_TRANSFORMED);
+
+  assert_parse_condset_optimized(&condset, &memrefs, buffer, "0xL0001<16", 1);
+  ASSERT_NUM_EQUALS(condset->conditions->optimized_comparator, RC_PROCESSING_COMPARE_ALWAYS_TRUE);
+}
+
+static void test_optimize_always_true_tallies_hits()
+{
+  uint8_t ram[] = {0x00, 0x12, 0x34, 0xAB, 0x56};
+  memory_t memory;
+  rc_condset_t* condset;
+  rc_memrefs_t memrefs;
+  char buffer[2048];
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  /* the first condition is always true, the last is never true */
+  assert_parse_condset(&condset, &memrefs, buffer, "0xL0001<16_0xH0002=52_N:0xM0003>1_0xH0004=86");
+  assert_evaluate_condset(condset, memrefs, &memory, 0);
+  assert_hit_count(condset, 0, 1);
+  assert_hit_count(condset, 1, 1);
+  assert_hit_count(condset, 2, 0);
+  assert_hit_count(condset, 3, 0);
+  ASSERT_NUM_EQUALS(condset_get_cond(condset, 0)->is_true, 1);
+  ASSERT_NUM_EQUALS(condset_get_cond(condset, 2)->is_true, 0);
+  ASSERT_NUM_EQUALS(condset_get_cond(condset, 3)->is_true, 1);
+
+  ram[2] = 0;
+  assert_evaluate_condset(condset, memrefs, &memory, 0);
+  assert_hit_count(condset, 0, 2);
+  assert_hit_count(condset, 1, 1);
+  assert_hit_count(condset, 2, 0);
+  assert_hit_count(condset, 3, 0);
+}
+
+static void test_optimize_fold_addsource_constants()
+{
+  uint8_t ram[] = {0x00, 0x12, 0x34, 0xAB, 0x56};
+  memory_t memory;
+  rc_condset_t* condset;
+  rc_memrefs_t memrefs;
+  char buffer[2048];
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  /* (5 * 3) - 2 + 0x12 = 31. only the last addition has to be calculated each frame */
+  assert_parse_condset(&condset, &memrefs, buffer, "A:5*3_B:2_0xH0001=31");
+  ASSERT_NUM_EQUALS(rc_memrefs_count_modified_memrefs(&memrefs), 1);
+  assert_evaluate_condset(condset, memrefs, &memory, 1);
+
+  assert_parse_condset_optimized(&condset, &memrefs, buffer, "A:5*3_B:2_0xH0001=31", 0);
+  ASSERT_NUM_EQUALS(rc_memrefs_count_modified_memrefs(&memrefs), 3);
+  assert_evaluate_condset(condset, memrefs, &memory, 1);
+
+  /* 10 - 4 + 0x12 = 24 */
+  assert_parse_condset(&condset, &memrefs, buffer, "B:4_A:10_0xH0001=24");
+  ASSERT_NUM_EQUALS(rc_memrefs_count_modified_memrefs(&memrefs), 1);
+  assert_evaluate_condset(condset, memrefs, &memory, 1);
+}
+
+static void _assert_optimized_condset_matches(const char* memaddr) {
+  uint8_t ram[] = { 0x00, 0x01, 0x02, 0x03, 0x00, 0x01, 0x02, 0x03 };
+  memory_t memory;
+  rc_condset_t* condset;
+  rc_condset_t* reference;
+  rc_condition_t* condition;
+  rc_condition_t* reference_condition;
+  rc_memrefs_t memrefs;
+  rc_memrefs_t reference_memrefs;
+  rc_eval_state_t eval_state;
+  rc_eval_state_t reference_eval_state;
+  char buffer[2048];
+  char reference_buffer[2048];
+  uint32_t seed = 12345;
+  int frame;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  assert_parse_condset_optimized(&condset, &memrefs, buffer, memaddr, 1);
+  assert_parse_condset_optimized(&reference, &reference_memrefs, reference_buffer, memaddr, 0);
+
+  for (frame = 0; frame < 1000; ++frame) {
+    seed = seed * 1103515245 + 12345;
+    if ((seed >> 8) % 4 == 0) /* boundary values are the interesting ones */
+      ram[(seed >> 20) % sizeof(ram)] = ((seed >> 10) & 1) ? 0xFF : 0x00;
+    else
+      ram[(seed >> 20) % sizeof(ram)] = (uint8_t)(seed >> 24);
+
+    rc_update_memref_values(&memrefs, peek, &memory);
+    rc_update_memref_values(&reference_memrefs, peek, &memory);
+
+    memset(&eval_state, 0, sizeof(eval_state));
+    eval_state.peek = peek;
+    eval_state.peek_userdata = &memory;
+    memcpy(&reference_eval_state, &eval_state, sizeof(eval_state));
+
+    ASSERT_NUM_EQUALS(rc_test_condset(condset, &eval_state), rc_test_condset(reference, &reference_eval_state));
+    ASSERT_NUM_EQUALS(eval_state.is_paused, reference_eval_state.is_paused);
+    ASSERT_NUM_EQUALS(eval_state.is_primed, reference_eval_state.is_primed);
+    ASSERT_NUM_EQUALS(eval_state.was_reset, reference_eval_state.was_reset);
+    ASSERT_NUM_EQUALS(eval_state.has_hits, reference_eval_state.has_hits);
+    ASSERT_NUM_EQUALS(eval_state.measured_value.type, reference_eval_state.measured_value.type);
+    ASSERT_NUM_EQUALS(eval_state.measured_value.value.u32, reference_eval_state.measured_value.value.u32);
+
+    reference_condition = reference->conditions;
+    for (condition = condset->conditions; condition; condition = condition->next) {
+      ASSERT_NUM_EQUALS(condition->current_hits, reference_condition->current_hits);
+      ASSERT_NUM_EQUALS(condition->is_true, reference_condition->is_true);
+      reference_condition = reference_condition->next;
+    }
+
+    if (eval_state.was_reset || frame % 200 == 100) {
+      rc_reset_condset(condset);
+      rc_reset_condset(reference);
+    }
+  }
+}
+#define assert_optimized_condset_matches(memaddr) ASSERT_HELPER(_assert_optimized_condset_matches(memaddr), "assert_optimized_condset_matches")
+
+static void test_optimize_matches_evaluation() {
+  assert_optimized_condset_matches("0xL0001<16_0xH0002>=0_0xM0003=1_0xH0004<128");
+  assert_optimized_condset_matches("N:0xL0001>15_0xH0002<128_O:0xM0003>=2_0xH0004<128.5.");
+  assert_optimized_condset_matches("A:5_A:3_0xH0001<40_0xN0002<=1_d0xK0003>8");
+  assert_optimized_condset_matches("B:4_A:0xL0001_0xL0002>30_A:0xL0003_0xL0004<=30");
+  assert_optimized_condset_matches("A:0xH0001%10_0=10_A:0xH0002&0x0F_0<16_P:0xK0003>=8");
+  assert_optimized_condset_matches("R:0xO0003=1_0xH0001>=0.10._C:0xM0002=1_0xL0004<16(4)");
+  assert_optimized_condset_matches("Z:0xO0001=0_0xL0002<16.3._T:0xW0001<=16777215_0xH0003<64");
+  assert_optimized_condset_matches("A:0xL0001*4_0xH0002<61_A:0xL0003/2_0xH0004>7_M:0xH0005<128(20)");
+  assert_optimized_condset_matches("K:0xH0001_{recall}<128_B:0xH0002_0=0xH0003");
+}
+
 static void test_ignore_parse_errors(const char* memaddr, uint8_t is_value, int32_t expected_error)
 {
   const char* memaddr_test;
@@ -4906,6 +5081,94 @@ static void test_ignore_parse_errors(const char* memaddr, uint8_t is_value, int3
   rc_destroy_preparse_state(&preparse);
 }
 
+typedef struct field_condition_t {
+  uint8_t shift;
+  uint8_t field_mask;
+  uint8_t oper;
+  uint8_t value;
+  uint8_t is_delta;
+} field_condition_t;
+
+static void _assert_field_conditions(const char* memaddr, const field_condition_t* fields, int num_fields) {
+  uint8_t ram[] = {0x00, 0x00, 0x00};
+  memory_t memory;
+  rc_condset_t* condset;
+  rc_condition_t* condition;
+  rc_memrefs_t memrefs;
+  char buffer[2048];
+  uint32_t seed = 12345;
+  uint8_t prior = 0;
+  uint8_t byte;
+  int frame, i;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  assert_parse_condset(&condset, &memrefs, buffer, memaddr);
+
+  for (frame = 0; frame < 1024; ++frame) {
+    /* visit every value first, then random transitions so the delta varies */
+    seed = seed * 1103515245 + 12345;
+    prior = ram[1];
+    ram[1] = (frame < 256) ? (uint8_t)frame : (uint8_t)(seed >> 24);
+
+    _assert_evaluate_condset(condset, &memrefs, &memory, 0);
+
+    condition = condset->conditions;
+    for (i = 0; i < num_fields; ++i) {
+      ASSERT_PTR_NOT_NULL(condition);
+      byte = fields[i].is_delta ? prior : ram[1];
+      ASSERT_NUM_EQUALS(condition->is_true,
+          rc_test_condition_compare((byte >> fields[i].shift) & fields[i].field_mask, fields[i].value, fields[i].oper));
+      condition = condition->next;
+    }
+  }
+}
+#define assert_field_conditions(memaddr, fields) ASSERT_HELPER(_assert_field_conditions(memaddr, fields, sizeof(fields) / sizeof(fields[0])), "assert_field_conditions")
+
+static void test_field_compares() {
+  /* bits and nibbles of the same byte are compared by masking the byte. the last condition is
+   * never true, so the condset is false and the hit targets are never met */
+  const field_condition_t fields[] = {
+    { 0, 0x01, RC_OPERATOR_EQ, 1, 0 },  /* 0xM0001=1 */
+    { 1, 0x01, RC_OPERATOR_EQ, 0, 0 },  /* 0xN0001=0 */
+    { 2, 0x01, RC_OPERATOR_NE, 1, 0 },  /* 0xO0001!=1 */
+    { 3, 0x01, RC_OPERATOR_LT, 1, 0 },  /* 0xP0001<1 */
+    { 4, 0x01, RC_OPERATOR_GT, 0, 0 },  /* 0xQ0001>0 */
+    { 5, 0x01, RC_OPERATOR_GE, 1, 0 },  /* 0xR0001>=1 */
+    { 6, 0x01, RC_OPERATOR_LE, 0, 0 },  /* 0xS0001<=0 */
+    { 7, 0x01, RC_OPERATOR_NE, 0, 0 },  /* 0xT0001!=0 */
+    { 0, 0x0F, RC_OPERATOR_EQ, 5, 0 },  /* 0xL0001=5 */
+    { 4, 0x0F, RC_OPERATOR_NE, 12, 0 }, /* 0xU0001!=12 */
+    { 0, 0x0F, RC_OPERATOR_LT, 1, 0 },  /* 0xL0001<1 */
+    { 4, 0x0F, RC_OPERATOR_GT, 14, 0 }, /* 0xU0001>14 */
+    { 0, 0x0F, RC_OPERATOR_LT, 8, 0 },  /* 0xL0001<8 - can't be masked */
+    { 4, 0x0F, RC_OPERATOR_GE, 0, 0 },  /* 0xU0001>=0 - always true */
+    { 3, 0x01, RC_OPERATOR_EQ, 1, 1 },  /* d0xP0001=1 */
+    { 3, 0x01, RC_OPERATOR_EQ, 0, 0 },  /* 0xP0001=0 */
+    { 4, 0x0F, RC_OPERATOR_NE, 3, 1 },  /* d0xU0001!=3 */
+    { 0, 0x01, RC_OPERATOR_EQ, 2, 0 }   /* 0xM0001=2 - never true */
+  };
+
+  assert_field_conditions("0xM0001=1.1000._0xN0001=0.1000._0xO0001!=1.1000._0xP0001<1.1000._0xQ0001>0.1000._"
+                          "0xR0001>=1.1000._0xS0001<=0.1000._0xT0001!=0.1000._0xL0001=5.1000._0xU0001!=12.1000._"
+                          "0xL0001<1.1000._0xU0001>14.1000._0xL0001<8.1000._0xU0001>=0.1000._d0xP0001=1.1000._"
+                          "0xP0001=0.1000._d0xU0001!=3.1000._0xM0001=2", fields);
+}
+
+static void test_field_compares_in_separate_segments() {
+  /* a run of field compares can't continue into the next segment, which is evaluated separately */
+  const field_condition_t fields[] = {
+    { 0, 0x01, RC_OPERATOR_EQ, 1, 0 },  /* P:0xM0001=1.1000. */
+    { 1, 0x01, RC_OPERATOR_EQ, 1, 0 },  /* R:0xN0001=1.1000. */
+    { 2, 0x01, RC_OPERATOR_EQ, 1, 0 },  /* 0xO0001=1.1000. */
+    { 0, 0x0F, RC_OPERATOR_EQ, 3, 0 },  /* 0xL0001=3.1000. */
+    { 0, 0x01, RC_OPERATOR_EQ, 2, 0 }   /* 0xM0001=2 */
+  };
+
+  assert_field_conditions("P:0xM0001=1.1000._R:0xN0001=1.1000._0xO0001=1.1000._0xL0001=3.1000._0xM0001=2", fields);
+}
+
 void test_condset(void) {
   TEST_SUITE_BEGIN();
 
@@ -5061,6 +5324,38 @@ void test_condset(void) {
   TEST(test_get_real_operand1_recall);
   TEST(test_get_real_operand1_indirect_static);
 
+  /* optimizer */
+  TEST_PARAMS2(test_optimize_comparator, "0xL0001<16", RC_PROCESSING_COMPARE_ALWAYS_TRUE);
+  TEST_PARAMS2(test_optimize_comparator, "0xL0001>15", RC_PROCESSING_COMPARE_ALWAYS_FALSE);
+  TEST_PARAMS2(test_optimize_comparator, "0xL0001<15", RC_PROCESSING_COMPARE_MEMREF_TO_CONST_TRANSFORMED);
+  TEST_PARAMS2(test_optimize_comparator, "0xM0001=2", RC_PROCESSING_COMPARE_ALWAYS_FALSE);
+  TEST_PARAMS2(test_optimize_comparator, "0xM0001!=2", RC_PROCESSING_COMPARE_ALWAYS_TRUE);
+  TEST_PARAMS2(test_optimize_comparator, "0xM0001<=1", RC_PROCESSING_COMPARE_ALWAYS_TRUE);
+  TEST_PARAMS2(test_optimize_comparator, "d0xK0001>8", RC_PROCESSING_COMPARE_ALWAYS_FALSE);
+  TEST_PARAMS2(test_optimize_comparator, "0xW0001<=16777215", RC_PROCESSING_COMPARE_ALWAYS_TRUE);
+  TEST_PARAMS2(test_optimize_comparator, "0xH0001>=0", RC_PROCESSING_COMPARE_ALWAYS_TRUE);
+  TEST_PARAMS2(test_optimize_comparator, "0xH0001<0", RC_PROCESSING_COMPARE_ALWAYS_FALSE);
+  TEST_PARAMS2(test_optimize_comparator, "16>0xL0001", RC_PROCESSING_COMPARE_ALWAYS_TRUE);
+  TEST_PARAMS2(test_optimize_comparator, "0xN0001<0xL0002", RC_PROCESSING_COMPARE_MEMREF_TO_MEMREF_TRANSFORMED);
+  TEST_PARAMS2(test_optimize_comparator, "0xH0001<256", RC_PROCESSING_COMPARE_MEMREF_TO_CONST); /* peek may return more than 8 bits */
+  TEST_PARAMS2(test_optimize_comparator, "b0xL0001<16", RC_PROCESSING_COMPARE_DEFAULT); /* bcd is not bounded */
+  TEST_PARAMS2(test_optimize_comparator, "fF0001>=0", RC_PROCESSING_COMPARE_DEFAULT); /* float is not bounded */
+  TEST_PARAMS2(test_optimize_comparator, "A:0xL0001_0xL0002>30", RC_PROCESSING_COMPARE_ALWAYS_FALSE);
+  TEST_PARAMS2(test_optimize_comparator, "A:0xL0001_0xL0002>29", RC_PROCESSING_COMPARE_DEFAULT);
+  TEST_PARAMS2(test_optimize_comparator, "A:0xH0001%10_0=10", RC_PROCESSING_COMPARE_ALWAYS_FALSE);
+  TEST_PARAMS2(test_optimize_comparator, "A:0xH0001&7_0<8", RC_PROCESSING_COMPARE_ALWAYS_TRUE);
+  TEST_PARAMS2(test_optimize_comparator, "A:0xH0001*2_0<512", RC_PROCESSING_COMPARE_DEFAULT); /* 8-bit is not bounded */
+  TEST_PARAMS2(test_optimize_comparator, "A:0xH0001_B:0xL0002_0=0", RC_PROCESSING_COMPARE_DEFAULT); /* subtraction may underflow */
+  TEST_PARAMS2(test_optimize_comparator, "K:0xL0001_{recall}<16", RC_PROCESSING_COMPARE_DEFAULT); /* recall is not bounded */
+  TEST(test_optimize_disabled);
+  TEST(test_optimize_always_true_tallies_hits);
+  TEST(test_optimize_fold_addsource_constants);
+  TEST(test_optimize_matches_evaluation);
+
+  /* field compares */
+  TEST(test_field_compares);
+  TEST(test_field_compares_in_separate_segments);
+
   /* ignore parse errors */
   TEST_PARAMS3(test_ignore_parse_errors, "M:0x1234=5_M:0x1234=6", 0, RC_MULTIPLE_MEASURED);
   TEST_PARAMS3(test_ignore_parse_errors, "M:0x1234", 0, RC_INVALID_OPERATOR); /* right side required for Measured non-value */
@@ -5,6 +5,7 @@
 
 #include <float.h>
 #include <math.h> /* pow */
+#include <stdlib.h> /* malloc */
 
 static void test_mask(char size, uint32_t expected)
 {
@@ -409,6 +410,92 @@ static void test_allocate_shared_indirect_address() {
   rc_destroy_parse_state(&parse);
 }
 
+static void test_allocate_integer_modified_memref() {
+  rc_parse_state_t parse;
+  rc_memrefs_t memrefs;
+  rc_operand_t byte1, byte2, bcd1, float0, fp, recall, const0, const7, chained;
+  rc_modified_memref_t* modified_memref;
+  rc_modified_memref_t generic;
+  const rc_operand_t* modifiers[3];
+  const uint8_t opers[] = {
+    RC_OPERATOR_MULT, RC_OPERATOR_DIV, RC_OPERATOR_AND, RC_OPERATOR_XOR, RC_OPERATOR_MOD,
+    RC_OPERATOR_ADD, RC_OPERATOR_SUB, RC_OPERATOR_SUB_PARENT, RC_OPERATOR_INDIRECT_READ
+  };
+  uint8_t ram[] = { 0x00, 0x12, 0x34, 0xAB, 0x56 };
+  size_t i, j, k;
+  memory_t memory;
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_init_parse_state(&parse, NULL);
+  rc_init_parse_state_memrefs(&parse, &memrefs);
+
+  memset(&byte1, 0, sizeof(byte1));
+  byte1.value.memref = rc_alloc_memref(&parse, 1, RC_MEMSIZE_8_BITS);
+  byte1.type = byte1.memref_access_type = RC_OPERAND_ADDRESS;
+  byte1.size = RC_MEMSIZE_8_BITS;
+  memcpy(&byte2, &byte1, sizeof(byte2));
+  byte2.value.memref = rc_alloc_memref(&parse, 2, RC_MEMSIZE_8_BITS);
+  memcpy(&bcd1, &byte1, sizeof(bcd1));
+  bcd1.type = RC_OPERAND_BCD;
+  memset(&float0, 0, sizeof(float0));
+  float0.value.memref = rc_alloc_memref(&parse, 0, RC_MEMSIZE_32_BITS);
+  float0.type = float0.memref_access_type = RC_OPERAND_ADDRESS;
+  float0.size = RC_MEMSIZE_FLOAT;
+  memset(&fp, 0, sizeof(fp));
+  fp.value.dbl = 1.5;
+  fp.type = RC_OPERAND_FP;
+  memset(&recall, 0, sizeof(recall));
+  recall.type = RC_OPERAND_RECALL;
+  recall.memref_access_type = RC_OPERAND_ADDRESS;
+  recall.size = RC_MEMSIZE_32_BITS;
+  rc_operand_set_const(&const0, 0);
+  rc_operand_set_const(&const7, 7);
+
+  /* operands that can't be floats use the integer calculation */
+  ASSERT_NUM_EQUALS(rc_alloc_modified_memref(&parse, RC_MEMSIZE_32_BITS, &byte1, RC_OPERATOR_MULT, &const7)->is_integer, 1);
+  ASSERT_NUM_EQUALS(rc_alloc_modified_memref(&parse, RC_MEMSIZE_32_BITS, &bcd1, RC_OPERATOR_ADD, &byte2)->is_integer, 1);
+  ASSERT_NUM_EQUALS(rc_alloc_modified_memref(&parse, RC_MEMSIZE_8_BITS, &byte1, RC_OPERATOR_INDIRECT_READ, &const7)->is_integer, 1);
+
+  /* anything that might be a float uses the typed calculation */
+  ASSERT_NUM_EQUALS(rc_alloc_modified_memref(&parse, RC_MEMSIZE_32_BITS, &byte1, RC_OPERATOR_MULT, &fp)->is_integer, 0);
+  ASSERT_NUM_EQUALS(rc_alloc_modified_memref(&parse, RC_MEMSIZE_32_BITS, &float0, RC_OPERATOR_ADD, &const7)->is_integer, 0);
+  ASSERT_NUM_EQUALS(rc_alloc_modified_memref(&parse, RC_MEMSIZE_32_BITS, &recall, RC_OPERATOR_ADD, &byte1)->is_integer, 0);
+  ASSERT_NUM_EQUALS(rc_alloc_modified_memref(&parse, RC_MEMSIZE_FLOAT, &byte1, RC_OPERATOR_INDIRECT_READ, &const0)->is_integer, 0);
+
+  /* a chain is integer as long as every link is */
+  memcpy(&chained, &byte1, sizeof(chained));
+  chained.value.memref = &rc_alloc_modified_memref(&parse, RC_MEMSIZE_32_BITS, &byte1, RC_OPERATOR_SUB, &byte2)->memref;
+  chained.size = RC_MEMSIZE_32_BITS;
+  ASSERT_NUM_EQUALS(rc_alloc_modified_memref(&parse, RC_MEMSIZE_32_BITS, &chained, RC_OPERATOR_DIV, &const7)->is_integer, 1);
+  chained.value.memref = &rc_alloc_modified_memref(&parse, RC_MEMSIZE_FLOAT, &byte1, RC_OPERATOR_INDIRECT_READ, &const0)->memref;
+  ASSERT_NUM_EQUALS(rc_alloc_modified_memref(&parse, RC_MEMSIZE_32_BITS, &chained, RC_OPERATOR_DIV, &const7)->is_integer, 0);
+
+  /* the integer calculation must match the typed calculation, including dividing by zero and underflow */
+  modifiers[0] = &const0;
+  modifiers[1] = &const7;
+  modifiers[2] = &byte2;
+  for (i = 0; i < 3; ++i) {
+    ram[1] = (uint8_t)(0x12 + i * 0x70);
+    ram[2] = (uint8_t)(i * 3);
+    rc_update_memref_values(&memrefs, peek, &memory);
+
+    for (j = 0; j < sizeof(opers) / sizeof(opers[0]); ++j) {
+      for (k = 0; k < sizeof(modifiers) / sizeof(modifiers[0]); ++k) {
+        modified_memref = rc_alloc_modified_memref(&parse, RC_MEMSIZE_8_BITS, &bcd1, opers[j], modifiers[k]);
+        ASSERT_NUM_EQUALS(modified_memref->is_integer, 1);
+
+        memcpy(&generic, modified_memref, sizeof(generic));
+        generic.is_integer = 0;
+        ASSERT_NUM_EQUALS(rc_get_modified_memref_value(modified_memref, peek, &memory),
+                          rc_get_modified_memref_value(&generic, peek, &memory));
+      }
+    }
+  }
+
+  rc_destroy_parse_state(&parse);
+}
+
 static void test_sizing_mode_grow_buffer() {
   int i;
   rc_parse_state_t parse;
@@ -441,6 +528,63 @@ static void test_sizing_mode_grow_buffer() {
   rc_destroy_parse_state(&parse);
 }
 
+static void test_allocate_shared_address_pool() {
+  rc_parse_state_t parse, lookup_parse;
+  rc_memrefs_t* memrefs = (rc_memrefs_t*)malloc(sizeof(rc_memrefs_t));
+  rc_memrefs_t local_memrefs;
+  rc_memref_t* memref1;
+  rc_modified_memref_t* child1;
+  rc_operand_t parent1, offset0;
+  uint32_t i;
+
+  rc_memrefs_init(memrefs);
+  rc_init_parse_state(&parse, NULL);
+  rc_init_parse_state_memrefs(&parse, NULL);
+  parse.memrefs = memrefs;
+
+  /* enough items to spill into several chunks */
+  for (i = 0; i < 1000; i++)
+    rc_alloc_memref(&parse, i, RC_MEMSIZE_8_BITS);
+  ASSERT_NUM_EQUALS(rc_memrefs_count_memrefs(memrefs), 1000);
+
+  memref1 = rc_alloc_memref(&parse, 500, RC_MEMSIZE_8_BITS);
+  ASSERT_NUM_EQUALS(memref1->address, 500);
+  ASSERT_NUM_EQUALS(memref1->value.size, RC_MEMSIZE_8_BITS);
+  ASSERT_NUM_EQUALS(rc_memrefs_count_memrefs(memrefs), 1000);
+
+  rc_alloc_memref(&parse, 500, RC_MEMSIZE_16_BITS); /* differing size will not match */
+  ASSERT_NUM_EQUALS(rc_memrefs_count_memrefs(memrefs), 1001);
+
+  parent1.value.memref = memref1;
+  parent1.type = RC_OPERAND_ADDRESS;
+  parent1.size = RC_MEMSIZE_8_BITS;
+  for (i = 0; i < 100; i++) {
+    rc_operand_set_const(&offset0, i);
+    rc_alloc_modified_memref(&parse, RC_MEMSIZE_8_BITS, &parent1, RC_OPERATOR_INDIRECT_READ, &offset0);
+  }
+  ASSERT_NUM_EQUALS(rc_memrefs_count_modified_memrefs(memrefs), 100);
+
+  rc_operand_set_const(&offset0, 50);
+  child1 = rc_alloc_modified_memref(&parse, RC_MEMSIZE_8_BITS, &parent1, RC_OPERATOR_INDIRECT_READ, &offset0);
+  ASSERT_NUM_EQUALS(child1->modifier.value.num, 50);
+  ASSERT_NUM_EQUALS(rc_memrefs_count_modified_memrefs(memrefs), 100);
+
+  /* items in the pool should be found when it's used as an existing list. the chunks that
+   * spilled out of the pool live in the scratch buffer of the first parse state, so it has
+   * to outlive the pool */
+  rc_init_parse_state(&lookup_parse, NULL);
+  rc_init_parse_state_memrefs(&lookup_parse, &local_memrefs);
+  lookup_parse.existing_memrefs = memrefs;
+
+  ASSERT_PTR_EQUALS(rc_alloc_memref(&lookup_parse, 500, RC_MEMSIZE_8_BITS), memref1);
+  ASSERT_PTR_EQUALS(rc_alloc_modified_memref(&lookup_parse, RC_MEMSIZE_8_BITS, &parent1, RC_OPERATOR_INDIRECT_READ, &offset0), child1);
+  ASSERT_NUM_EQUALS(get_memref_count(&lookup_parse), 0);
+
+  rc_destroy_parse_state(&lookup_parse);
+  rc_memrefs_destroy(memrefs);
+  rc_destroy_parse_state(&parse);
+}
+
 static void test_update_memref_values() {
   rc_parse_state_t parse;
   rc_memrefs_t memrefs;
@@ -500,6 +644,203 @@ static void test_update_memref_values() {
   rc_destroy_parse_state(&parse);
 }
 
+static void test_update_memref_values_pool() {
+  rc_parse_state_t parse;
+  rc_memrefs_t* memrefs = (rc_memrefs_t*)malloc(sizeof(rc_memrefs_t));
+  rc_memref_t* memref[48];
+  uint8_t ram[48];
+  memory_t memory;
+  uint32_t i;
+
+  for (i = 0; i < sizeof(ram); i++)
+    ram[i] = (uint8_t)i;
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_memrefs_init(memrefs);
+  rc_init_parse_state(&parse, NULL);
+  rc_init_parse_state_memrefs(&parse, NULL);
+  parse.memrefs = memrefs;
+
+  /* more than one 32-item block, spilling into a second chunk */
+  for (i = 0; i < 40; i++)
+    memref[i] = rc_alloc_memref(&parse, i, RC_MEMSIZE_8_BITS);
+
+  rc_update_memref_values(memrefs, peek, &memory);
+  ASSERT_NUM_EQUALS(memref[0]->value.value, 0);
+  ASSERT_NUM_EQUALS(memref[0]->value.changed, 0);
+  ASSERT_NUM_EQUALS(memref[35]->value.value, 35);
+  ASSERT_NUM_EQUALS(memref[35]->value.changed, 1);
+
+  ram[35] = 0x80;
+  rc_update_memref_values(memrefs, peek, &memory);
+  ASSERT_NUM_EQUALS(memref[34]->value.value, 34);
+  ASSERT_NUM_EQUALS(memref[34]->value.changed, 0);
+  ASSERT_NUM_EQUALS(memref[35]->value.value, 0x80);
+  ASSERT_NUM_EQUALS(memref[35]->value.changed, 1);
+  ASSERT_NUM_EQUALS(memref[35]->value.prior, 35);
+
+  rc_update_memref_values(memrefs, peek, &memory);
+  ASSERT_NUM_EQUALS(memref[35]->value.value, 0x80);
+  ASSERT_NUM_EQUALS(memref[35]->value.changed, 0);
+  ASSERT_NUM_EQUALS(memref[35]->value.prior, 35);
+
+  /* memrefs added after the first update are picked up */
+  for (; i < 48; i++)
+    memref[i] = rc_alloc_memref(&parse, i, RC_MEMSIZE_8_BITS);
+
+  rc_update_memref_values(memrefs, peek, &memory);
+  ASSERT_NUM_EQUALS(memref[47]->value.value, 47);
+  ASSERT_NUM_EQUALS(memref[47]->value.changed, 1);
+
+  /* invalidated memrefs are no longer read */
+  memref[3]->value.type = RC_VALUE_TYPE_NONE;
+  rc_memrefs_mark_dirty(memrefs);
+  ram[3] = 0x33;
+  ram[4] = 0x44;
+  rc_update_memref_values(memrefs, peek, &memory);
+  ASSERT_NUM_EQUALS(memref[3]->value.value, 3);
+  ASSERT_NUM_EQUALS(memref[4]->value.value, 0x44);
+  ASSERT_NUM_EQUALS(memref[4]->value.changed, 1);
+  ASSERT_NUM_EQUALS(memref[47]->value.changed, 0);
+
+  /* values written directly to the records are honored once the pool is marked dirty */
+  memref[5]->value.value = 0x55;
+  memref[5]->value.prior = 0x50;
+  memref[5]->value.changed = 1;
+  rc_memrefs_mark_dirty(memrefs);
+  rc_update_memref_values(memrefs, peek, &memory);
+  ASSERT_NUM_EQUALS(memref[5]->value.value, 5);
+  ASSERT_NUM_EQUALS(memref[5]->value.changed, 1);
+  ASSERT_NUM_EQUALS(memref[5]->value.prior, 0x55);
+  ASSERT_NUM_EQUALS(memref[4]->value.changed, 0);
+
+  rc_memrefs_destroy(memrefs);
+  rc_destroy_parse_state(&parse);
+}
+
+static void test_update_memref_values_pool_changed_mask() {
+  rc_parse_state_t parse;
+  rc_memrefs_t* memrefs = (rc_memrefs_t*)malloc(sizeof(rc_memrefs_t));
+  rc_memref_t* memref[45];
+  uint8_t ram[45];
+  memory_t memory;
+  uint32_t i, frame, expected_changed;
+
+  memset(ram, 0, sizeof(ram));
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_memrefs_init(memrefs);
+  rc_init_parse_state(&parse, NULL);
+  rc_init_parse_state_memrefs(&parse, NULL);
+  parse.memrefs = memrefs;
+
+  /* a full 32-item block, followed by a partial block */
+  for (i = 0; i < 45; i++)
+    memref[i] = rc_alloc_memref(&parse, i, RC_MEMSIZE_8_BITS);
+
+  rc_update_memref_values(memrefs, peek, &memory);
+
+  for (frame = 1; frame <= 6; frame++) {
+    /* change every frame'th address */
+    for (i = 0; i < 45; i += frame)
+      ram[i]++;
+
+    rc_update_memref_values(memrefs, peek, &memory);
+
+    for (i = 0; i < 45; i++) {
+      expected_changed = (i % frame == 0) ? 1 : 0;
+      ASSERT_NUM_EQUALS(memref[i]->value.value, ram[i]);
+      ASSERT_NUM_EQUALS(memref[i]->value.changed, expected_changed);
+    }
+  }
+
+  rc_memrefs_destroy(memrefs);
+  rc_destroy_parse_state(&parse);
+}
+
+typedef struct counting_memory_t {
+  memory_t memory;
+  uint32_t num_peeks;
+  uint32_t addresses[16];
+} counting_memory_t;
+
+static uint32_t counting_peek(uint32_t address, uint32_t num_bytes, void* ud) {
+  counting_memory_t* counting_memory = (counting_memory_t*)ud;
+  if (counting_memory->num_peeks < sizeof(counting_memory->addresses) / sizeof(counting_memory->addresses[0]))
+    counting_memory->addresses[counting_memory->num_peeks] = address;
+  counting_memory->num_peeks++;
+  return peek(address, num_bytes, &counting_memory->memory);
+}
+
+static void test_update_memref_values_fused_reads() {
+  rc_parse_state_t parse;
+  rc_memrefs_t* memrefs = (rc_memrefs_t*)malloc(sizeof(rc_memrefs_t));
+  rc_memref_t* memref[11];
+  uint8_t ram[16];
+  counting_memory_t counting_memory;
+  uint32_t i, frame;
+
+  for (i = 0; i < sizeof(ram); i++)
+    ram[i] = (uint8_t)(i * 0x11 + 3);
+  counting_memory.memory.ram = ram;
+  counting_memory.memory.size = sizeof(ram);
+
+  rc_memrefs_init(memrefs);
+  rc_init_parse_state(&parse, NULL);
+  rc_init_parse_state_memrefs(&parse, NULL);
+  parse.memrefs = memrefs;
+
+  /* 0x0000-0x0003 can be served by one read */
+  memref[0] = rc_alloc_memref(&parse, 0x0001, RC_MEMSIZE_8_BITS);
+  memref[1] = rc_alloc_memref(&parse, 0x0000, RC_MEMSIZE_16_BITS);
+  memref[2] = rc_alloc_memref(&parse, 0x0000, RC_MEMSIZE_8_BITS);
+  memref[3] = rc_alloc_memref(&parse, 0x0002, RC_MEMSIZE_BIT_3);
+  memref[4] = rc_alloc_memref(&parse, 0x0003, RC_MEMSIZE_HIGH);
+  /* abuts the previous group, but would make it larger than 32 bits */
+  memref[5] = rc_alloc_memref(&parse, 0x0004, RC_MEMSIZE_24_BITS);
+  /* 0x0008-0x000B can be served by one read */
+  memref[6] = rc_alloc_memref(&parse, 0x0009, RC_MEMSIZE_8_BITS);
+  memref[7] = rc_alloc_memref(&parse, 0x0008, RC_MEMSIZE_32_BITS);
+  memref[8] = rc_alloc_memref(&parse, 0x000A, RC_MEMSIZE_16_BITS_BE);
+  /* 0x000D-0x000F would require a three byte read. read as 0x000D and 0x000E-0x000F */
+  memref[9] = rc_alloc_memref(&parse, 0x000D, RC_MEMSIZE_8_BITS);
+  memref[10] = rc_alloc_memref(&parse, 0x000E, RC_MEMSIZE_16_BITS);
+
+  /* without fusion, each memref is read individually, in the order they were allocated */
+  counting_memory.num_peeks = 0;
+  rc_update_memref_values(memrefs, counting_peek, &counting_memory);
+  ASSERT_NUM_EQUALS(counting_memory.num_peeks, 11);
+  for (i = 0; i < sizeof(memref) / sizeof(memref[0]); i++)
+    ASSERT_NUM_EQUALS(counting_memory.addresses[i], memref[i]->address);
+
+  rc_memrefs_set_fuse_reads(memrefs, 1);
+
+  for (frame = 0; frame < 4; frame++) {
+    ram[frame * 4] ^= 0x5A;
+    ram[frame * 4 + 3] += 0x10;
+
+    counting_memory.num_peeks = 0;
+    rc_update_memref_values(memrefs, counting_peek, &counting_memory);
+    ASSERT_NUM_EQUALS(counting_memory.num_peeks, 5);
+
+    for (i = 0; i < sizeof(memref) / sizeof(memref[0]); i++) {
+      const uint32_t expected = rc_peek_value(memref[i]->address, memref[i]->value.size, peek, &counting_memory.memory);
+      ASSERT_NUM_EQUALS(memref[i]->value.value, expected);
+    }
+  }
+
+  /* the changed flags match what was modified in the last frame (0x000C and 0x000F) */
+  ASSERT_NUM_EQUALS(memref[0]->value.changed, 0);
+  ASSERT_NUM_EQUALS(memref[7]->value.changed, 0);
+  ASSERT_NUM_EQUALS(memref[9]->value.changed, 0);
+  ASSERT_NUM_EQUALS(memref[10]->value.changed, 1);
+
+  rc_memrefs_destroy(memrefs);
+  rc_destroy_parse_state(&parse);
+}
+
 void test_memref(void) {
   TEST_SUITE_BEGIN();
 
@@ -510,9 +851,14 @@ void test_memref(void) {
   TEST(test_allocate_shared_address);
   TEST(test_allocate_shared_address2);
   TEST(test_allocate_shared_indirect_address);
+  TEST(test_allocate_integer_modified_memref);
+  TEST(test_allocate_shared_address_pool);
 
   TEST(test_sizing_mode_grow_buffer);
   TEST(test_update_memref_values);
+  TEST(test_update_memref_values_pool);
+  TEST(test_update_memref_values_pool_changed_mask);
+  TEST(test_update_memref_values_fused_reads);
 
   /* rc_parse_memref is thoroughly tested by rc_parse_operand tests */
 
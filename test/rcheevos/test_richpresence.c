@@ -391,6 +391,151 @@ static void test_conditional_display_unnecessary_measured_indirect() {
   assert_richpresence_output(richpresence, &memory, "True");
 }
 
+static rc_condset_selectivity_t* get_display_selectivity(rc_richpresence_display_t* display) {
+  return rc_condset_get_selectivity(display->trigger.requirement);
+}
+
+static void test_conditional_display_short_circuit() {
+  uint8_t ram[] = { 0x00, 0x12, 0x34, 0xAB, 0x56 };
+  memory_t memory;
+  rc_richpresence_t* richpresence;
+  rc_condition_t* condition;
+  char buffer[2048];
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  assert_parse_richpresence(&richpresence, buffer, "Display:\n?0xH0000=1_0xH0001=18?Both\nNeither");
+  assert_richpresence_output(richpresence, &memory, "Neither");
+
+  /* the first condition is false, so the second is never evaluated */
+  condition = richpresence->first_display->trigger.requirement->conditions;
+  ASSERT_NUM_EQUALS(condition->current_hits, 0);
+  ASSERT_NUM_EQUALS(condition->next->current_hits, 0);
+
+  ram[0] = 1;
+  assert_richpresence_output(richpresence, &memory, "Both");
+  ASSERT_NUM_EQUALS(condition->current_hits, 1);
+  ASSERT_NUM_EQUALS(condition->next->current_hits, 1);
+
+  /* hit targets are tallied every frame, so those displays can't be short circuited */
+  assert_parse_richpresence(&richpresence, buffer, "Display:\n?0xH0000=2_0xH0001=18.3.?Three\nLess");
+  assert_richpresence_output(richpresence, &memory, "Less");
+  condition = richpresence->first_display->trigger.requirement->conditions;
+  ASSERT_NUM_EQUALS(condition->current_hits, 0);
+  ASSERT_NUM_EQUALS(condition->next->current_hits, 1);
+  ASSERT_PTR_NULL(get_display_selectivity(richpresence->first_display));
+}
+
+static void test_conditional_display_reorder() {
+  uint8_t ram[] = { 0x00, 0x12, 0x34, 0xAB, 0x56 };
+  memory_t memory;
+  rc_richpresence_t* richpresence;
+  rc_condset_selectivity_t* selectivity;
+  char buffer[2048];
+  int i;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  assert_parse_richpresence(&richpresence, buffer, "Display:\n?0xH0001>=16_0xH0002=52_0xH0000=1?Match\nOther");
+  selectivity = get_display_selectivity(richpresence->first_display);
+  ASSERT_PTR_NOT_NULL(selectivity);
+  ASSERT_NUM_EQUALS(selectivity->num_entries, 3);
+
+  /* the last condition is always false. it should be moved to the front. change an input
+   * each frame so the evaluation isn't skipped */
+  for (i = 0; i < 32; ++i) {
+    ram[1] = (uint8_t)(0x12 + (i & 1));
+    assert_richpresence_output(richpresence, &memory, "Other");
+  }
+
+  ASSERT_NUM_EQUALS(selectivity->entries[0].index, 2);
+  ASSERT_NUM_EQUALS(selectivity->entries[1].index, 0);
+  ASSERT_NUM_EQUALS(selectivity->entries[2].index, 1);
+
+  ram[0] = 1;
+  assert_richpresence_output(richpresence, &memory, "Match");
+  ram[2] = 0;
+  assert_richpresence_output(richpresence, &memory, "Other");
+}
+
+static void test_conditional_display_reorder_chain() {
+  uint8_t ram[] = { 0x00, 0x12, 0x34, 0xAB, 0x56 };
+  memory_t memory;
+  rc_richpresence_t* richpresence;
+  rc_condset_selectivity_t* selectivity;
+  char buffer[2048];
+  int i;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  /* the AndNext chain can't be reordered, and conditions can't be moved across it */
+  assert_parse_richpresence(&richpresence, buffer,
+      "Display:\n?0xH0001>=16_0xH0002=52_N:0xH0003=171_0xH0004=86_0xH0000=1?Match\nOther");
+  selectivity = get_display_selectivity(richpresence->first_display);
+  ASSERT_PTR_NOT_NULL(selectivity);
+  ASSERT_NUM_EQUALS(selectivity->num_entries, 4);
+  ASSERT_NUM_EQUALS(selectivity->entries[2].num_conditions, 2);
+  ASSERT_NUM_EQUALS(selectivity->entries[2].is_independent, 0);
+
+  for (i = 0; i < 32; ++i) {
+    ram[1] = (uint8_t)(0x12 + (i & 1));
+    assert_richpresence_output(richpresence, &memory, "Other");
+  }
+
+  ASSERT_NUM_EQUALS(selectivity->entries[0].index, 0);
+  ASSERT_NUM_EQUALS(selectivity->entries[1].index, 1);
+  ASSERT_NUM_EQUALS(selectivity->entries[2].index, 2);
+  ASSERT_NUM_EQUALS(selectivity->entries[3].index, 4);
+
+  /* without two adjacent independent conditions, there's nothing to reorder */
+  assert_parse_richpresence(&richpresence, buffer,
+      "Display:\n?0xH0001=18_N:0xH0003=171_0xH0004=86_0xH0000=1?Match\nOther");
+  ASSERT_PTR_NULL(get_display_selectivity(richpresence->first_display));
+}
+
+static void test_conditional_display_reorder_matches_evaluation() {
+  static const char* names[] = { "First", "Second", "Third", "Default" };
+  uint8_t ram[] = { 0x00, 0x01, 0x02, 0x03, 0x00, 0x01, 0x02, 0x03 };
+  memory_t memory;
+  rc_richpresence_t* richpresence;
+  rc_richpresence_t* reference;
+  rc_richpresence_display_t* display;
+  const char* script = "Display:\n"
+      "?0xH0001<2_0xH0002!=0_0xH0003=d0xH0003_0xL0004<3?First\n"
+      "?0xH0005>0_N:0xH0006=1_O:0xH0007=2_0xH0000>0_0xH0001!=3?Second\n"
+      "?0xH0002=p0xH0002_0xH0003<3_0xH0004>=1_0xH0006<=2?Third\n"
+      "Default";
+  char buffer[4096];
+  char reference_buffer[4096];
+  uint32_t seed = 12345;
+  int frame, index;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  assert_parse_richpresence(&richpresence, buffer, script);
+  assert_parse_richpresence(&reference, reference_buffer, script);
+
+  for (frame = 0; frame < 500; ++frame) {
+    seed = seed * 1103515245 + 12345;
+    ram[(seed >> 20) % sizeof(ram)] = (uint8_t)((seed >> 24) % 4);
+
+    /* evaluate each display of the reference without short circuiting */
+    rc_update_richpresence(reference, peek, &memory, NULL);
+    index = 0;
+    for (display = reference->first_display; display->next; display = display->next) {
+      if (rc_test_trigger(&display->trigger, peek, &memory, NULL))
+        break;
+      ++index;
+    }
+
+    assert_richpresence_output(richpresence, &memory, names[index]);
+  }
+}
+
 static void test_conditional_display_invalid() {
   int lines_read = 0;
   ASSERT_NUM_EQUALS(rc_richpresence_size_lines("Display:\n?I:0x0x0000=1?True\nFalse\n", &lines_read), RC_INVALID_MEMORY_OPERAND);
@@ -1417,6 +1562,10 @@ void test_richpresence(void) {
   TEST(test_conditional_display_indirect);
   TEST(test_conditional_display_unnecessary_measured);
   TEST(test_conditional_display_unnecessary_measured_indirect);
+  TEST(test_conditional_display_short_circuit);
+  TEST(test_conditional_display_reorder);
+  TEST(test_conditional_display_reorder_chain);
+  TEST(test_conditional_display_reorder_matches_evaluation);
   TEST(test_conditional_display_invalid);
 
   /* value macros */
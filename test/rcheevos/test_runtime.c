@@ -5,6 +5,8 @@
 
 #include "../test_framework.h"
 
+#include <stdlib.h>
+
 static rc_runtime_event_t events[16];
 static int event_count = 0;
 
@@ -186,6 +188,839 @@ static void test_deactivate_achievements(void)
   rc_runtime_destroy(&runtime);
 }
 
+static void test_deactivate_achievement_modified_memref(void)
+{
+  uint8_t ram[] = { 1, 10, 20, 30 };
+  memory_t memory;
+  rc_runtime_t runtime;
+  rc_modified_memref_t* modified_memref;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_runtime_init(&runtime);
+
+  assert_activate_achievement(&runtime, 1, "I:0xH0000_0xH0001=99");
+  assert_activate_achievement(&runtime, 2, "0xH0003=99");
+  modified_memref = runtime.memrefs->modified_memrefs.items;
+  ASSERT_NUM_EQUALS(runtime.memrefs->modified_memrefs.count, 1);
+
+  /* indirect read of $(1+1) */
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(runtime.memrefs->schedule->num_modified_memrefs, 1);
+  ASSERT_NUM_EQUALS(modified_memref->memref.value.value, 20);
+  ASSERT_NUM_EQUALS(modified_memref->memref.value.changed, 1);
+
+  /* no longer referenced by an active achievement. should not be evaluated */
+  rc_runtime_deactivate_achievement(&runtime, 1);
+  ram[0] = 2;
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(runtime.memrefs->schedule->num_modified_memrefs, 0);
+  ASSERT_NUM_EQUALS(modified_memref->memref.value.value, 20);
+
+  /* referenced again. current value should be captured without reporting a change */
+  assert_activate_achievement(&runtime, 1, "I:0xH0000_0xH0001=99");
+  ASSERT_NUM_EQUALS(runtime.memrefs->modified_memrefs.count, 1);
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(runtime.memrefs->schedule->num_modified_memrefs, 1);
+  ASSERT_NUM_EQUALS(modified_memref->memref.value.value, 30);
+  ASSERT_NUM_EQUALS(modified_memref->memref.value.prior, 20);
+  ASSERT_NUM_EQUALS(modified_memref->memref.value.changed, 0);
+
+  /* subsequent changes are reported normally */
+  ram[0] = 1;
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(modified_memref->memref.value.value, 20);
+  ASSERT_NUM_EQUALS(modified_memref->memref.value.prior, 30);
+  ASSERT_NUM_EQUALS(modified_memref->memref.value.changed, 1);
+
+  rc_runtime_destroy(&runtime);
+}
+
+static void test_deactivate_achievement_parks_memrefs(void)
+{
+  uint8_t ram[] = { 0, 10, 10 };
+  memory_t memory;
+  rc_runtime_t runtime;
+  rc_memref_t* memref1;
+  rc_memref_t* memref2;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_runtime_init(&runtime);
+
+  assert_activate_achievement(&runtime, 1, "0xH0001=99");
+  assert_activate_achievement(&runtime, 2, "0xH0002=99");
+  assert_activate_achievement(&runtime, 3, "0xH0002=98");
+  memref1 = &runtime.memrefs->memrefs.items[0];
+  memref2 = &runtime.memrefs->memrefs.items[1];
+
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(runtime.memrefs->schedule->num_memrefs, 2);
+  ASSERT_NUM_EQUALS(memref1->value.value, 10);
+  ASSERT_NUM_EQUALS(memref2->value.value, 10);
+
+  /* memref1 is no longer referenced and should not be read. memref2 is still referenced by achievement 3 */
+  rc_runtime_deactivate_achievement(&runtime, 1);
+  rc_runtime_deactivate_achievement(&runtime, 2);
+  ram[1] = ram[2] = 11;
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(runtime.memrefs->schedule->num_memrefs, 1);
+  ASSERT_NUM_EQUALS(memref1->value.value, 10);
+  ASSERT_NUM_EQUALS(memref2->value.value, 11);
+  ASSERT_NUM_EQUALS(memref2->value.changed, 1);
+
+  /* referenced again. current value should be captured without reporting a change */
+  ram[1] = 12;
+  assert_activate_achievement(&runtime, 1, "0xH0001=99");
+  ASSERT_NUM_EQUALS(runtime.memrefs->memrefs.count, 2);
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(runtime.memrefs->schedule->num_memrefs, 2);
+  ASSERT_NUM_EQUALS(memref1->value.value, 12);
+  ASSERT_NUM_EQUALS(memref1->value.prior, 10);
+  ASSERT_NUM_EQUALS(memref1->value.changed, 0);
+
+  /* subsequent changes are reported normally */
+  ram[1] = 13;
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(memref1->value.value, 13);
+  ASSERT_NUM_EQUALS(memref1->value.prior, 12);
+  ASSERT_NUM_EQUALS(memref1->value.changed, 1);
+
+  rc_runtime_destroy(&runtime);
+}
+
+typedef struct counting_memory_t {
+  memory_t memory;
+  uint32_t num_peeks;
+} counting_memory_t;
+
+static uint32_t counting_peek(uint32_t address, uint32_t num_bytes, void* ud)
+{
+  counting_memory_t* counting_memory = (counting_memory_t*)ud;
+  counting_memory->num_peeks++;
+  return peek(address, num_bytes, &counting_memory->memory);
+}
+
+static void test_dirty_pages_matches_full_read(void)
+{
+  uint8_t ram[64];
+  uint8_t dirty_pages[1];
+  counting_memory_t full_memory, dirty_memory;
+  rc_runtime_t full_runtime, dirty_runtime;
+  rc_memref_t* full_memref;
+  rc_memref_t* dirty_memref;
+  uint32_t seed = 12345;
+  uint32_t frame, i, address, num_memrefs;
+  const char* memaddr[] = {
+    "0xH0001=5_d0xH0001=4",    /* page 0 */
+    "0x 0007>1000",            /* straddles pages 0 and 1 */
+    "0xX0010!=0_0xH0020=0xH0021",
+    "0xL0030=3_0xU0030>2",
+    "0xM0038=1_0xH003f=0"      /* page 7 */
+  };
+
+  memset(ram, 0, sizeof(ram));
+  full_memory.memory.ram = dirty_memory.memory.ram = ram;
+  full_memory.memory.size = dirty_memory.memory.size = sizeof(ram);
+  full_memory.num_peeks = dirty_memory.num_peeks = 0;
+
+  rc_runtime_init(&full_runtime);
+  rc_runtime_init(&dirty_runtime);
+  rc_runtime_set_fused_reads_enabled(&dirty_runtime, 1);
+
+  for (i = 0; i < sizeof(memaddr) / sizeof(memaddr[0]); ++i) {
+    assert_activate_achievement(&full_runtime, i + 1, memaddr[i]);
+    assert_activate_achievement(&dirty_runtime, i + 1, memaddr[i]);
+  }
+
+  num_memrefs = full_runtime.memrefs->memrefs.count;
+  ASSERT_NUM_EQUALS(dirty_runtime.memrefs->memrefs.count, num_memrefs);
+
+  for (frame = 0; frame < 200; ++frame) {
+    /* write a few random bytes, and mark their 8-byte pages as dirty */
+    dirty_pages[0] = 0;
+    for (i = frame % 3; i > 0; --i) {
+      seed = seed * 1103515245 + 12345;
+      address = (seed >> 16) % sizeof(ram);
+      ram[address] = (uint8_t)(seed >> 8);
+      dirty_pages[0] |= (uint8_t)(1 << (address / 8));
+    }
+
+    rc_runtime_do_frame(&full_runtime, event_handler, counting_peek, &full_memory, NULL);
+    rc_runtime_set_dirty_pages(&dirty_runtime, dirty_pages, 8, 8);
+    rc_runtime_do_frame(&dirty_runtime, event_handler, counting_peek, &dirty_memory, NULL);
+
+    for (i = 0; i < num_memrefs; ++i) {
+      full_memref = &full_runtime.memrefs->memrefs.items[i];
+      dirty_memref = &dirty_runtime.memrefs->memrefs.items[i];
+      ASSERT_NUM_EQUALS(dirty_memref->value.value, full_memref->value.value);
+      ASSERT_NUM_EQUALS(dirty_memref->value.prior, full_memref->value.prior);
+      ASSERT_NUM_EQUALS(dirty_memref->value.changed, full_memref->value.changed);
+    }
+
+    for (i = 0; i < full_runtime.trigger_count; ++i)
+      ASSERT_NUM_EQUALS(dirty_runtime.triggers[i].trigger->state, full_runtime.triggers[i].trigger->state);
+  }
+
+  /* most frames leave most pages clean */
+  ASSERT_NUM_LESS(dirty_memory.num_peeks, full_memory.num_peeks / 2);
+
+  rc_runtime_destroy(&full_runtime);
+  rc_runtime_destroy(&dirty_runtime);
+}
+
+static void test_dirty_pages_ignored_after_memrefs_change(void)
+{
+  uint8_t ram[] = { 0, 10, 10, 0 };
+  uint8_t dirty_pages[1] = { 0 };
+  memory_t memory;
+  rc_runtime_t runtime;
+  rc_memref_t* memref1;
+  rc_memref_t* memref2;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_runtime_init(&runtime);
+
+  /* the first frame has to read everything */
+  assert_activate_achievement(&runtime, 1, "0xH0001=99");
+  memref1 = &runtime.memrefs->memrefs.items[0];
+  rc_runtime_set_dirty_pages(&runtime, dirty_pages, 1, 256);
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(memref1->value.value, 10);
+
+  /* page not marked as written, memory isn't read */
+  ram[1] = 11;
+  rc_runtime_set_dirty_pages(&runtime, dirty_pages, 1, 256);
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(memref1->value.value, 10);
+  ASSERT_NUM_EQUALS(memref1->value.changed, 0);
+
+  /* no bitmap, memory is read */
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(memref1->value.value, 11);
+  ASSERT_NUM_EQUALS(memref1->value.changed, 1);
+
+  /* new memref hasn't been read, so the bitmap can't be trusted */
+  assert_activate_achievement(&runtime, 2, "0xH0002=99");
+  memref2 = &runtime.memrefs->memrefs.items[1];
+  rc_runtime_set_dirty_pages(&runtime, dirty_pages, 1, 256);
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(memref1->value.value, 11);
+  ASSERT_NUM_EQUALS(memref1->value.changed, 0);
+  ASSERT_NUM_EQUALS(memref2->value.value, 10);
+
+  /* page marked as written */
+  ram[2] = 12;
+  dirty_pages[0] = 1;
+  rc_runtime_set_dirty_pages(&runtime, dirty_pages, 1, 256);
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(memref2->value.value, 12);
+  ASSERT_NUM_EQUALS(memref2->value.changed, 1);
+
+  /* unsupported page size is ignored */
+  ram[2] = 13;
+  dirty_pages[0] = 0;
+  rc_runtime_set_dirty_pages(&runtime, dirty_pages, 1, 100);
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(memref2->value.value, 13);
+
+  rc_runtime_destroy(&runtime);
+}
+
+static void test_fused_indirect_reads_match_individual_reads(void)
+{
+  uint8_t ram[64];
+  counting_memory_t individual_memory, fused_memory;
+  rc_runtime_t individual_runtime, fused_runtime;
+  rc_modified_memref_t* individual_memref;
+  rc_modified_memref_t* fused_memref;
+  uint32_t seed = 54321;
+  uint32_t frame, i, num_modified_memrefs;
+  const char* memaddr[] = {
+    "I:0xH0000_0xH0004=1_I:0xH0000_0xH0005=2",
+    "I:0xH0000_0x 0006=3_I:0xH0000_0xX0010>4",
+    "I:0xH0001_0xH0000=5_I:0xH0001_0xH0002=6"  /* different pointer */
+  };
+
+  memset(ram, 0, sizeof(ram));
+  individual_memory.memory.ram = fused_memory.memory.ram = ram;
+  individual_memory.memory.size = fused_memory.memory.size = sizeof(ram);
+
+  rc_runtime_init(&individual_runtime);
+  rc_runtime_init(&fused_runtime);
+  rc_runtime_set_fused_reads_enabled(&fused_runtime, 1);
+
+  for (i = 0; i < sizeof(memaddr) / sizeof(memaddr[0]); ++i) {
+    assert_activate_achievement(&individual_runtime, i + 1, memaddr[i]);
+    assert_activate_achievement(&fused_runtime, i + 1, memaddr[i]);
+  }
+
+  num_modified_memrefs = individual_runtime.memrefs->modified_memrefs.count;
+  ASSERT_NUM_EQUALS(fused_runtime.memrefs->modified_memrefs.count, num_modified_memrefs);
+
+  /* first update builds the schedule */
+  rc_runtime_do_frame(&fused_runtime, event_handler, counting_peek, &fused_memory, NULL);
+  rc_runtime_do_frame(&individual_runtime, event_handler, counting_peek, &individual_memory, NULL);
+  ASSERT_NUM_EQUALS(fused_runtime.memrefs->schedule->num_indirect_groups, 2);
+
+  for (frame = 0; frame < 100; ++frame) {
+    for (i = 0; i < 4; ++i) {
+      seed = seed * 1103515245 + 12345;
+      ram[(seed >> 16) % sizeof(ram)] = (uint8_t)(seed >> 8);
+    }
+
+    /* pointer sometimes points past the end of memory */
+    ram[0] = (uint8_t)((frame * 7) % 70);
+
+    individual_memory.num_peeks = fused_memory.num_peeks = 0;
+    rc_runtime_do_frame(&individual_runtime, event_handler, counting_peek, &individual_memory, NULL);
+    rc_runtime_do_frame(&fused_runtime, event_handler, counting_peek, &fused_memory, NULL);
+    ASSERT_NUM_LESS(fused_memory.num_peeks, individual_memory.num_peeks);
+
+    for (i = 0; i < num_modified_memrefs; ++i) {
+      individual_memref = &individual_runtime.memrefs->modified_memrefs.items[i];
+      fused_memref = &fused_runtime.memrefs->modified_memrefs.items[i];
+      ASSERT_NUM_EQUALS(fused_memref->memref.value.value, individual_memref->memref.value.value);
+      ASSERT_NUM_EQUALS(fused_memref->memref.value.prior, individual_memref->memref.value.prior);
+      ASSERT_NUM_EQUALS(fused_memref->memref.value.changed, individual_memref->memref.value.changed);
+    }
+
+    for (i = 0; i < individual_runtime.trigger_count; ++i)
+      ASSERT_NUM_EQUALS(fused_runtime.triggers[i].trigger->state, individual_runtime.triggers[i].trigger->state);
+  }
+
+  rc_runtime_destroy(&individual_runtime);
+  rc_runtime_destroy(&fused_runtime);
+}
+
+static uint32_t bounded_peek(uint32_t address, uint32_t num_bytes, void* ud)
+{
+  /* like many hosts, fails the whole read if any of it is outside of memory */
+  counting_memory_t* counting_memory = (counting_memory_t*)ud;
+  counting_memory->num_peeks++;
+  if (address + num_bytes > counting_memory->memory.size)
+    return 0;
+
+  return peek(address, num_bytes, &counting_memory->memory);
+}
+
+static void test_fused_indirect_reads_at_end_of_memory(void)
+{
+  uint8_t ram[16];
+  counting_memory_t individual_memory, fused_memory;
+  rc_runtime_t individual_runtime, fused_runtime;
+  rc_modified_memref_t* individual_memref;
+  rc_modified_memref_t* fused_memref;
+  uint32_t pointer, i, num_modified_memrefs;
+  /* 8-bit reads at offsets 0 and 4 from the same pointer are grouped */
+  const char* memaddr = "I:0xH0000_0xH0000=5_I:0xH0000_0xH0004=6";
+
+  for (i = 0; i < sizeof(ram); ++i)
+    ram[i] = (uint8_t)(i + 0x10);
+  individual_memory.memory.ram = fused_memory.memory.ram = ram;
+  individual_memory.memory.size = fused_memory.memory.size = sizeof(ram);
+
+  rc_runtime_init(&individual_runtime);
+  rc_runtime_init(&fused_runtime);
+  rc_runtime_set_fused_reads_enabled(&fused_runtime, 1);
+  assert_activate_achievement(&individual_runtime, 1, memaddr);
+  assert_activate_achievement(&fused_runtime, 1, memaddr);
+
+  rc_runtime_do_frame(&fused_runtime, event_handler, bounded_peek, &fused_memory, NULL);
+  rc_runtime_do_frame(&individual_runtime, event_handler, bounded_peek, &individual_memory, NULL);
+  ASSERT_NUM_EQUALS(fused_runtime.memrefs->schedule->num_indirect_groups, 1);
+
+  num_modified_memrefs = individual_runtime.memrefs->modified_memrefs.count;
+
+  /* the first member is the last byte of memory, or close to it. the bytes after it aren't needed */
+  for (pointer = sizeof(ram) - 4; pointer < sizeof(ram); ++pointer) {
+    ram[0] = (uint8_t)pointer;
+    rc_runtime_do_frame(&individual_runtime, event_handler, bounded_peek, &individual_memory, NULL);
+    rc_runtime_do_frame(&fused_runtime, event_handler, bounded_peek, &fused_memory, NULL);
+
+    for (i = 0; i < num_modified_memrefs; ++i) {
+      individual_memref = &individual_runtime.memrefs->modified_memrefs.items[i];
+      fused_memref = &fused_runtime.memrefs->modified_memrefs.items[i];
+      ASSERT_NUM_EQUALS(fused_memref->memref.value.value, individual_memref->memref.value.value);
+    }
+  }
+
+  rc_runtime_destroy(&individual_runtime);
+  rc_runtime_destroy(&fused_runtime);
+}
+
+static void _assert_condsets_match(rc_condset_t* condset, rc_condset_t* expected)
+{
+  rc_condition_t* condition = condset->conditions;
+  rc_condition_t* expected_condition = expected->conditions;
+
+  ASSERT_NUM_EQUALS(condset->is_paused, expected->is_paused);
+
+  for (; expected_condition; expected_condition = expected_condition->next, condition = condition->next) {
+    ASSERT_PTR_NOT_NULL(condition);
+    ASSERT_NUM_EQUALS(condition->current_hits, expected_condition->current_hits);
+    ASSERT_NUM_EQUALS(condition->is_true, expected_condition->is_true);
+  }
+}
+#define assert_condsets_match(condset, expected) ASSERT_HELPER(_assert_condsets_match(condset, expected), "assert_condsets_match")
+
+static void _assert_triggers_match(rc_trigger_t* trigger, rc_trigger_t* expected)
+{
+  rc_condset_t* condset = trigger->alternative;
+  rc_condset_t* expected_condset = expected->alternative;
+
+  ASSERT_NUM_EQUALS(trigger->state, expected->state);
+  ASSERT_NUM_EQUALS(trigger->measured_value, expected->measured_value);
+  ASSERT_NUM_EQUALS(trigger->has_hits, expected->has_hits);
+
+  if (expected->requirement)
+    assert_condsets_match(trigger->requirement, expected->requirement);
+
+  for (; expected_condset; expected_condset = expected_condset->next, condset = condset->next)
+    assert_condsets_match(condset, expected_condset);
+}
+#define assert_triggers_match(trigger, expected) ASSERT_HELPER(_assert_triggers_match(trigger, expected), "assert_triggers_match")
+
+static void test_jit_matches_interpreter(void)
+{
+  uint8_t ram[16];
+  memory_t memory;
+  rc_runtime_t runtime, jit_runtime;
+  rc_runtime_event_t expected_events[16];
+  int expected_event_count;
+  uint32_t seed = 24680;
+  uint32_t frame, i;
+  const char* memaddr[] = {
+    "0xH0000=1.3._0xH0001>d0xH0001",
+    "N:0xH0002=1_0xH0003=2.2._R:0xH0004=3",
+    "O:0xH0005=1_0xH0006=1_P:0xH0007=3.2._Z:0xH0008=0_0xH0009!=0.4.",
+    "C:0xH000a=1_D:0xH000b=2_0xH000c!=3.5.",
+    "M:0xH000d=1.10._Q:0xH000e!=3_T:0xH000f=2_N:0xH0000=3_R:0xH0001=3",
+    "0xH0000<0xH0001_P:0xH0002=3SR:0xH0003=3_0xH0004>=2.2.S0xH0005=d0xH0005_0xH0006<=1",
+    "d0xH0007=1_0xH0008=2S0xH0009=0SR:d0xH000a>1_d0xH000b!=0xH000b",
+    "A:0xH0002_0xH0003=4_0xH0004=1.2.",   /* AddSource is left to the interpreter */
+    "M:0xH0001=3_P:0xH0002=1.3.",         /* Measured without hits is left to the interpreter */
+    "0xH0003=2_0xH0004=1",
+    "0xH0008=1_0xH0009=3",                /* same shape as the previous, shares its code */
+    "0xH0003=0xH0005_0xH0004=d0xH0004",   /* same shape except for the comparisons */
+    "A:0xH0002_0xH0003=4"                 /* nothing can be compiled */
+  };
+  const int num_memaddrs = sizeof(memaddr) / sizeof(memaddr[0]);
+
+  memset(ram, 0, sizeof(ram));
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_runtime_init(&runtime);
+  rc_runtime_init(&jit_runtime);
+  ASSERT_NUM_EQUALS(rc_runtime_set_jit_enabled(&jit_runtime, 1), RC_TRIGGER_JIT_SUPPORTED);
+
+  for (i = 0; i < (uint32_t)num_memaddrs; ++i) {
+    assert_activate_achievement(&runtime, i + 1, memaddr[i]);
+    assert_activate_achievement(&jit_runtime, i + 1, memaddr[i]);
+  }
+
+  for (frame = 0; frame < 2000; ++frame) {
+    for (i = 0; i < 3; ++i) {
+      seed = seed * 1103515245 + 12345;
+      ram[(seed >> 16) % sizeof(ram)] = (uint8_t)((seed >> 8) & 3);
+    }
+
+    /* let the achievements that triggered or were paused trigger again */
+    if ((frame % 250) == 0) {
+      rc_runtime_reset(&runtime);
+      rc_runtime_reset(&jit_runtime);
+    }
+
+    assert_do_frame(&runtime, &memory);
+    memcpy(expected_events, events, sizeof(events));
+    expected_event_count = event_count;
+
+    assert_do_frame(&jit_runtime, &memory);
+    ASSERT_NUM_EQUALS(event_count, expected_event_count);
+    for (i = 0; i < (uint32_t)event_count; ++i) {
+      ASSERT_NUM_EQUALS(events[i].type, expected_events[i].type);
+      ASSERT_NUM_EQUALS(events[i].id, expected_events[i].id);
+      ASSERT_NUM_EQUALS(events[i].value, expected_events[i].value);
+    }
+
+    for (i = 0; i < (uint32_t)num_memaddrs; ++i)
+      assert_triggers_match(jit_runtime.triggers[i].trigger, runtime.triggers[i].trigger);
+  }
+
+#if RC_TRIGGER_JIT_SUPPORTED
+  for (i = 0; i < (uint32_t)num_memaddrs - 1; ++i) {
+    ASSERT_PTR_NOT_NULL(jit_runtime.state->triggers[i].jit);
+    ASSERT_PTR_NOT_NULL(jit_runtime.state->triggers[i].jit->condsets);
+  }
+
+  ASSERT_PTR_NOT_NULL(jit_runtime.state->triggers[num_memaddrs - 1].jit);
+  ASSERT_PTR_NULL(jit_runtime.state->triggers[num_memaddrs - 1].jit->condsets);
+
+  ASSERT_TRUE(jit_runtime.state->triggers[10].jit->condsets[0].other == jit_runtime.state->triggers[9].jit->condsets[0].other);
+  ASSERT_FALSE(jit_runtime.state->triggers[11].jit->condsets[0].other == jit_runtime.state->triggers[9].jit->condsets[0].other);
+#else
+  for (i = 0; i < (uint32_t)num_memaddrs; ++i)
+    ASSERT_PTR_NULL(jit_runtime.state->triggers[i].jit);
+#endif
+
+  rc_runtime_destroy(&runtime);
+  rc_runtime_destroy(&jit_runtime);
+}
+
+static void test_jit_deactivate_achievement(void)
+{
+  uint8_t ram[] = { 0, 10, 10 };
+  memory_t memory;
+  rc_runtime_t runtime;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_runtime_init(&runtime);
+  rc_runtime_set_jit_enabled(&runtime, 1);
+
+  assert_activate_achievement(&runtime, 1, "0xH0001=11");
+  assert_activate_achievement(&runtime, 2, "0xH0002=11");
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(runtime.triggers[0].trigger->state, RC_TRIGGER_STATE_ACTIVE);
+  ASSERT_NUM_EQUALS(runtime.triggers[1].trigger->state, RC_TRIGGER_STATE_ACTIVE);
+
+  /* the second trigger moves into the first slot, and takes its code with it */
+  rc_runtime_deactivate_achievement(&runtime, 1);
+  ASSERT_NUM_EQUALS(runtime.trigger_count, 1);
+  ASSERT_NUM_EQUALS(runtime.triggers[0].id, 2);
+#if RC_TRIGGER_JIT_SUPPORTED
+  ASSERT_PTR_NOT_NULL(runtime.state->triggers[0].jit);
+  ASSERT_PTR_EQUALS(runtime.state->triggers[0].jit->trigger, runtime.triggers[0].trigger);
+#endif
+
+  /* replacement trigger is compiled when it's first evaluated */
+  assert_activate_achievement(&runtime, 1, "0xH0001=12");
+  ASSERT_PTR_NULL(runtime.state->triggers[1].jit);
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(runtime.triggers[1].trigger->state, RC_TRIGGER_STATE_ACTIVE);
+
+  ram[1] = 12;
+  ram[2] = 11;
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(event_count, 2);
+  assert_event(RC_RUNTIME_EVENT_ACHIEVEMENT_TRIGGERED, 1, 0);
+  assert_event(RC_RUNTIME_EVENT_ACHIEVEMENT_TRIGGERED, 2, 0);
+
+  /* disabling the jit releases the code */
+  rc_runtime_set_jit_enabled(&runtime, 0);
+  ASSERT_PTR_NULL(runtime.state->triggers[0].jit);
+  ASSERT_PTR_NULL(runtime.state->triggers[1].jit);
+
+  rc_runtime_destroy(&runtime);
+}
+
+static void RC_CCONV scrambled_parallel_for(uint32_t num_items, rc_runtime_process_item_t process_item, void* item_data, void* userdata)
+{
+  uint32_t i;
+
+  /* the odd items backwards, then the even items forwards, so nothing can depend on the order */
+  for (i = num_items; i-- > 0;) {
+    if (i & 1)
+      process_item(i, item_data);
+  }
+
+  for (i = 0; i < num_items; i += 2)
+    process_item(i, item_data);
+
+  *(uint32_t*)userdata += num_items;
+}
+
+static rc_runtime_event_t frame_events[256];
+static uint32_t frame_event_count = 0;
+
+static void frame_event_handler(const rc_runtime_event_t* e)
+{
+  if (frame_event_count < sizeof(frame_events) / sizeof(frame_events[0]))
+    memcpy(&frame_events[frame_event_count], e, sizeof(rc_runtime_event_t));
+
+  ++frame_event_count;
+}
+
+static void test_parallel_matches_serial(void)
+{
+  uint8_t ram[16];
+  memory_t memory;
+  rc_runtime_t runtime, parallel_runtime;
+  rc_runtime_event_t expected_events[256];
+  uint32_t expected_event_count;
+  uint32_t num_items = 0;
+  uint32_t seed = 13579;
+  uint32_t frame, i;
+  const char* memaddr[] = {
+    "0xH0000=1.3._0xH0001>d0xH0001",
+    "N:0xH0002=1_0xH0003=2.2._R:0xH0004=3",
+    "O:0xH0005=1_0xH0006=1_P:0xH0007=3.2._Z:0xH0008=0_0xH0009!=0.4.",
+    "C:0xH000a=1_D:0xH000b=2_0xH000c!=3.5.",
+    "M:0xH000d=1.10._Q:0xH000e!=3_T:0xH000f=2_N:0xH0000=3_R:0xH0001=3",
+    "0xH0000<0xH0001_P:0xH0002=3SR:0xH0003=3_0xH0004>=2.2.S0xH0005=d0xH0005_0xH0006<=1",
+    "K:0xH0002*2_A:{recall}_M:0xH0003=4.4._R:0xH0004=0",
+    "I:0xH0001_0xH0002=1_0xH0003=2",
+    "A:0xH0002_M:0xH0003=4.5._R:0xH0004=3"
+  };
+  const char* lboard_memaddr[] = {
+    "STA:0xH0000=1::CAN:0xH0001=2::SUB:0xH0002=3::VAL:0xH0003",
+    "STA:0xH0004=0_0xH0005=1::CAN:0xH0006=3::SUB:0xH0007=2::VAL:M:0xH0008=1",
+    "STA:0xH0009=2::CAN:0xH000a=0.2.::SUB:0xH000b=1::VAL:0xH000c*2_0xH000d"
+  };
+  const uint32_t num_memaddrs = sizeof(memaddr) / sizeof(memaddr[0]);
+  const uint32_t num_lboard_memaddrs = sizeof(lboard_memaddr) / sizeof(lboard_memaddr[0]);
+  const uint32_t num_achievements = 100;
+  const uint32_t num_lboards = 40;
+
+  memset(ram, 0, sizeof(ram));
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_runtime_init(&runtime);
+  rc_runtime_init(&parallel_runtime);
+  ASSERT_NUM_EQUALS(rc_runtime_set_deferred_parallel_for(&parallel_runtime, scrambled_parallel_for, &num_items), RC_OK);
+
+  /* the event handler doesn't change the runtime, so deferring the events doesn't affect the results */
+
+  /* the serial runtime shares conditions between the copies, the parallel runtime can't */
+  for (i = 0; i < num_achievements; ++i) {
+    assert_activate_achievement(&runtime, i + 1, memaddr[i % num_memaddrs]);
+    assert_activate_achievement(&parallel_runtime, i + 1, memaddr[i % num_memaddrs]);
+  }
+
+  for (i = 0; i < num_lboards; ++i) {
+    assert_activate_lboard(&runtime, i + 1, lboard_memaddr[i % num_lboard_memaddrs]);
+    assert_activate_lboard(&parallel_runtime, i + 1, lboard_memaddr[i % num_lboard_memaddrs]);
+  }
+
+  for (frame = 0; frame < 1000; ++frame) {
+    for (i = 0; i < 3; ++i) {
+      seed = seed * 1103515245 + 12345;
+      ram[(seed >> 16) % sizeof(ram)] = (uint8_t)((seed >> 8) & 3);
+    }
+
+    /* let the achievements that triggered or were paused trigger again */
+    if ((frame % 250) == 0) {
+      rc_runtime_reset(&runtime);
+      rc_runtime_reset(&parallel_runtime);
+    }
+
+    frame_event_count = 0;
+    rc_runtime_do_frame(&runtime, frame_event_handler, peek, &memory, NULL);
+    ASSERT_NUM_LESS_EQUALS(frame_event_count, sizeof(frame_events) / sizeof(frame_events[0]));
+    memcpy(expected_events, frame_events, sizeof(frame_events));
+    expected_event_count = frame_event_count;
+
+    frame_event_count = 0;
+    rc_runtime_do_frame(&parallel_runtime, frame_event_handler, peek, &memory, NULL);
+    ASSERT_NUM_EQUALS(frame_event_count, expected_event_count);
+    for (i = 0; i < frame_event_count; ++i) {
+      ASSERT_NUM_EQUALS(frame_events[i].type, expected_events[i].type);
+      ASSERT_NUM_EQUALS(frame_events[i].id, expected_events[i].id);
+      ASSERT_NUM_EQUALS(frame_events[i].value, expected_events[i].value);
+    }
+
+    for (i = 0; i < num_achievements; ++i)
+      assert_triggers_match(parallel_runtime.triggers[i].trigger, runtime.triggers[i].trigger);
+
+    for (i = 0; i < num_lboards; ++i) {
+      ASSERT_NUM_EQUALS(parallel_runtime.lboards[i].lboard->state, runtime.lboards[i].lboard->state);
+      ASSERT_NUM_EQUALS(parallel_runtime.lboards[i].value, runtime.lboards[i].value);
+    }
+  }
+
+  /* 4 items of achievements and 2 items of leaderboards each frame */
+  ASSERT_NUM_EQUALS(num_items, frame * 6);
+
+  /* turning it off evaluates serially again */
+  ASSERT_NUM_EQUALS(rc_runtime_set_deferred_parallel_for(&parallel_runtime, NULL, NULL), RC_OK);
+  ASSERT_PTR_NULL(parallel_runtime.state->parallel);
+  assert_do_frame(&parallel_runtime, &memory);
+  ASSERT_NUM_EQUALS(num_items, frame * 6);
+
+  rc_runtime_destroy(&runtime);
+  rc_runtime_destroy(&parallel_runtime);
+}
+
+static rc_runtime_t* deactivating_runtime;
+
+static void deactivating_event_handler(const rc_runtime_event_t* e)
+{
+  event_handler(e);
+
+  /* moves the third achievement into the first slot */
+  if (e->id == 3)
+    rc_runtime_deactivate_achievement(deactivating_runtime, 1);
+}
+
+static void test_parallel_deactivate_in_event_handler(void)
+{
+  uint8_t ram[] = { 0, 10, 10, 10 };
+  memory_t memory;
+  rc_runtime_t runtime;
+  uint32_t num_items = 0;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_runtime_init(&runtime);
+  ASSERT_NUM_EQUALS(rc_runtime_set_deferred_parallel_for(&runtime, scrambled_parallel_for, &num_items), RC_OK);
+  deactivating_runtime = &runtime;
+
+  assert_activate_achievement(&runtime, 1, "0xH0001=11");
+  assert_activate_achievement(&runtime, 2, "0xH0002=11");
+  assert_activate_achievement(&runtime, 3, "0xH0003=11");
+
+  /* the deactivated achievement was evaluated, but doesn't raise an event. the moved achievement
+   * already raised its event, so it doesn't raise another */
+  event_count = 0;
+  rc_runtime_do_frame(&runtime, deactivating_event_handler, peek, &memory, NULL);
+  ASSERT_NUM_EQUALS(num_items, 1);
+  ASSERT_NUM_EQUALS(runtime.trigger_count, 2);
+  ASSERT_NUM_EQUALS(event_count, 2);
+  ASSERT_NUM_EQUALS(events[0].type, RC_RUNTIME_EVENT_ACHIEVEMENT_ACTIVATED);
+  ASSERT_NUM_EQUALS(events[0].id, 3);
+  ASSERT_NUM_EQUALS(events[1].type, RC_RUNTIME_EVENT_ACHIEVEMENT_ACTIVATED);
+  ASSERT_NUM_EQUALS(events[1].id, 2);
+
+  ram[1] = ram[2] = ram[3] = 11;
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(event_count, 2);
+  ASSERT_NUM_EQUALS(events[0].type, RC_RUNTIME_EVENT_ACHIEVEMENT_TRIGGERED);
+  ASSERT_NUM_EQUALS(events[0].id, 2);
+  ASSERT_NUM_EQUALS(events[1].type, RC_RUNTIME_EVENT_ACHIEVEMENT_TRIGGERED);
+  ASSERT_NUM_EQUALS(events[1].id, 3);
+
+  rc_runtime_destroy(&runtime);
+}
+
+static void test_buffered_events_match_callback(void)
+{
+  uint8_t ram[16];
+  memory_t memory;
+  rc_runtime_t runtime, buffered_runtime;
+  rc_runtime_event_buffer_t buffer;
+  uint32_t seed = 97531;
+  uint32_t frame, i, num_events;
+  const char* memaddr[] = {
+    "0xH0000=1.3._0xH0001>d0xH0001",
+    "N:0xH0002=1_0xH0003=2.2._R:0xH0004=3",
+    "O:0xH0005=1_0xH0006=1_P:0xH0007=3.2._Z:0xH0008=0_0xH0009!=0.4.",
+    "M:0xH000d=1.10._Q:0xH000e!=3_T:0xH000f=2_N:0xH0000=3_R:0xH0001=3"
+  };
+  const char* lboard_memaddr = "STA:0xH0000=1::CAN:0xH0001=2::SUB:0xH0002=3::VAL:0xH0003";
+  const uint32_t num_achievements = 40;
+
+  memset(ram, 0, sizeof(ram));
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_runtime_init(&runtime);
+  rc_runtime_init(&buffered_runtime);
+  rc_runtime_init_event_buffer(&buffer, NULL, 0);
+
+  for (i = 0; i < num_achievements; ++i) {
+    assert_activate_achievement(&runtime, i + 1, memaddr[i % 4]);
+    assert_activate_achievement(&buffered_runtime, i + 1, memaddr[i % 4]);
+  }
+
+  for (i = 0; i < 4; ++i) {
+    assert_activate_lboard(&runtime, i + 1, lboard_memaddr);
+    assert_activate_lboard(&buffered_runtime, i + 1, lboard_memaddr);
+  }
+
+  for (frame = 0; frame < 1000; ++frame) {
+    for (i = 0; i < 3; ++i) {
+      seed = seed * 1103515245 + 12345;
+      ram[(seed >> 16) % sizeof(ram)] = (uint8_t)((seed >> 8) & 3);
+    }
+
+    if ((frame % 250) == 0) {
+      rc_runtime_reset(&runtime);
+      rc_runtime_reset(&buffered_runtime);
+    }
+
+    frame_event_count = 0;
+    rc_runtime_do_frame(&runtime, frame_event_handler, peek, &memory, NULL);
+
+    /* events from the previous frames are kept until they're cleared */
+    num_events = buffer.num_events;
+    if ((frame % 10) == 0)
+      buffer.num_events = num_events = 0;
+
+    ASSERT_NUM_EQUALS(rc_runtime_do_frame_buffered(&buffered_runtime, &buffer, peek, &memory), frame_event_count);
+    ASSERT_NUM_EQUALS(buffer.num_events, num_events + frame_event_count);
+    ASSERT_NUM_EQUALS(buffer.num_dropped, 0);
+    for (i = 0; i < frame_event_count; ++i) {
+      ASSERT_NUM_EQUALS(buffer.events[num_events + i].type, frame_events[i].type);
+      ASSERT_NUM_EQUALS(buffer.events[num_events + i].id, frame_events[i].id);
+      ASSERT_NUM_EQUALS(buffer.events[num_events + i].value, frame_events[i].value);
+    }
+  }
+
+  ASSERT_NUM_GREATER(buffer.capacity, 16);
+
+  rc_runtime_destroy_event_buffer(&buffer);
+  ASSERT_PTR_NULL(buffer.events);
+
+  rc_runtime_destroy(&runtime);
+  rc_runtime_destroy(&buffered_runtime);
+}
+
+static void test_buffered_events_overflow(void)
+{
+  uint8_t ram[] = { 0, 10, 10, 10 };
+  memory_t memory;
+  rc_runtime_t runtime;
+  rc_runtime_event_t storage[2];
+  rc_runtime_event_buffer_t buffer;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_runtime_init(&runtime);
+  rc_runtime_init_event_buffer(&buffer, storage, sizeof(storage) / sizeof(storage[0]));
+
+  assert_activate_achievement(&runtime, 1, "0xH0001=11");
+  assert_activate_achievement(&runtime, 2, "0xH0002=11");
+  assert_activate_achievement(&runtime, 3, "0xH0003=11");
+
+  /* all three activate, but only the first two events fit */
+  ASSERT_NUM_EQUALS(rc_runtime_do_frame_buffered(&runtime, &buffer, peek, &memory), 2);
+  ASSERT_NUM_EQUALS(buffer.num_events, 2);
+  ASSERT_NUM_EQUALS(buffer.num_dropped, 1);
+  ASSERT_PTR_EQUALS(buffer.events, storage);
+  ASSERT_NUM_EQUALS(storage[0].type, RC_RUNTIME_EVENT_ACHIEVEMENT_ACTIVATED);
+  ASSERT_NUM_EQUALS(storage[0].id, 3);
+  ASSERT_NUM_EQUALS(storage[1].type, RC_RUNTIME_EVENT_ACHIEVEMENT_ACTIVATED);
+  ASSERT_NUM_EQUALS(storage[1].id, 2);
+  ASSERT_NUM_EQUALS(runtime.triggers[0].trigger->state, RC_TRIGGER_STATE_ACTIVE);
+
+  /* the buffer is still full, so nothing else can be added */
+  ram[1] = 11;
+  ASSERT_NUM_EQUALS(rc_runtime_do_frame_buffered(&runtime, &buffer, peek, &memory), 0);
+  ASSERT_NUM_EQUALS(buffer.num_dropped, 2);
+  ASSERT_NUM_EQUALS(runtime.triggers[0].trigger->state, RC_TRIGGER_STATE_TRIGGERED);
+
+  /* once it's cleared, there's space again */
+  buffer.num_events = buffer.num_dropped = 0;
+  ram[2] = 11;
+  ASSERT_NUM_EQUALS(rc_runtime_do_frame_buffered(&runtime, &buffer, peek, &memory), 1);
+  ASSERT_NUM_EQUALS(buffer.num_dropped, 0);
+  ASSERT_NUM_EQUALS(storage[0].type, RC_RUNTIME_EVENT_ACHIEVEMENT_TRIGGERED);
+  ASSERT_NUM_EQUALS(storage[0].id, 2);
+
+  /* the storage belongs to the caller */
+  rc_runtime_destroy_event_buffer(&buffer);
+  rc_runtime_destroy(&runtime);
+}
+
 static void test_achievement_measured(void)
 {
   /* bytes 3-7 are the float value for 16*pi */
@@ -442,6 +1277,203 @@ static void test_two_achievements_differing_resets_in_alts(void)
   rc_runtime_destroy(&runtime);
 }
 
+static void test_shared_conditions(void)
+{
+  uint8_t ram[] = { 0, 0, 0, 0 };
+  memory_t memory;
+  rc_runtime_t runtime;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_runtime_init(&runtime);
+
+  assert_activate_achievement(&runtime, 1, "b0xH0001=5_0xH0002=1");
+  assert_activate_achievement(&runtime, 2, "5=b0xH0001_0xH0002=2");      /* same comparison, operands swapped */
+  assert_activate_achievement(&runtime, 3, "b0xH0001=5.2._0xH0002=3");   /* hit targets don't prevent sharing */
+  assert_activate_achievement(&runtime, 4, "b0xH0001>5_0xH0002=4");      /* different operator */
+  assert_activate_achievement(&runtime, 5, "K:0xH0001_{recall}=5_0xH0002=5"); /* recall is specific to the condset */
+
+  ASSERT_PTR_NOT_NULL(runtime.state->triggers[0].shared_indices);
+  ASSERT_NUM_EQUALS(runtime.state->triggers[0].shared_indices[0], 1);
+  ASSERT_NUM_EQUALS(runtime.state->triggers[0].shared_indices[1], 0); /* cheap comparisons aren't shared */
+  ASSERT_NUM_EQUALS(runtime.state->triggers[1].shared_indices[0], 1);
+  ASSERT_NUM_EQUALS(runtime.state->triggers[2].shared_indices[0], 1);
+  ASSERT_NUM_EQUALS(runtime.state->triggers[3].shared_indices[0], 2);
+  ASSERT_PTR_NULL(runtime.state->triggers[4].shared_indices);
+  ASSERT_NUM_EQUALS(runtime.state->shared_conditions->count, 2);
+
+  /* all false, everything activates */
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(event_count, 5);
+
+  /* shared comparison is true, but each achievement keeps its own hits */
+  ram[1] = 0x05;
+  ram[2] = 2;
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(event_count, 1);
+  assert_event(RC_RUNTIME_EVENT_ACHIEVEMENT_TRIGGERED, 2, 0);
+  ASSERT_NUM_EQUALS(runtime.triggers[0].trigger->requirement->conditions->current_hits, 1);
+  ASSERT_NUM_EQUALS(runtime.triggers[2].trigger->requirement->conditions->current_hits, 1);
+  ASSERT_NUM_EQUALS(runtime.triggers[3].trigger->requirement->conditions->current_hits, 0);
+
+  ram[2] = 3;
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(event_count, 1);
+  assert_event(RC_RUNTIME_EVENT_ACHIEVEMENT_TRIGGERED, 3, 0);
+  ASSERT_NUM_EQUALS(runtime.triggers[0].trigger->requirement->conditions->current_hits, 2);
+
+  /* shared comparison is re-evaluated each frame */
+  ram[1] = 0x06;
+  ram[2] = 4;
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(event_count, 1);
+  assert_event(RC_RUNTIME_EVENT_ACHIEVEMENT_TRIGGERED, 4, 0);
+  ASSERT_NUM_EQUALS(runtime.triggers[0].trigger->requirement->conditions->is_true, 0);
+
+  /* reactivating an achievement finds the existing comparison */
+  rc_runtime_deactivate_achievement(&runtime, 2);
+  assert_activate_achievement(&runtime, 2, "5=b0xH0001_0xH0002=2");
+  ASSERT_NUM_EQUALS(runtime.triggers[runtime.trigger_count - 1].id, 2);
+  ASSERT_NUM_EQUALS(runtime.state->triggers[runtime.trigger_count - 1].shared_indices[0], 1);
+  ASSERT_NUM_EQUALS(runtime.state->shared_conditions->count, 2);
+
+  rc_runtime_destroy(&runtime);
+}
+
+static void test_shared_conditions_released(void)
+{
+  uint8_t ram[] = { 0, 0, 0, 0 };
+  memory_t memory;
+  rc_runtime_t runtime;
+  char memaddr[64];
+  uint32_t i;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_runtime_init(&runtime);
+
+  assert_activate_achievement(&runtime, 1, "b0xH0001=5_0xH0002=1");
+
+  /* more distinct comparisons than fit in the table if deactivating didn't release them */
+  for (i = 0; i < 0x10000 + 100; ++i) {
+    sprintf(memaddr, "b0xH0001=%u_b0xH0002=%u_0xH0003=1", i + 10, i + 10);
+    assert_activate_achievement(&runtime, 2, memaddr);
+    rc_runtime_deactivate_achievement(&runtime, 2);
+  }
+
+  ASSERT_NUM_EQUALS(runtime.state->shared_conditions->count, 3);
+  ASSERT_NUM_EQUALS(runtime.state->shared_conditions->num_free, 2);
+
+  /* comparisons are still shared, and the one still in use was kept */
+  assert_activate_achievement(&runtime, 2, "5=b0xH0001_0xH0002=2");
+  assert_activate_achievement(&runtime, 3, "b0xH0002=7_0xH0002=3");
+  assert_activate_achievement(&runtime, 4, "b0xH0002=7_0xH0002=4");
+  ASSERT_NUM_EQUALS(runtime.state->triggers[1].shared_indices[0], 1);
+  ASSERT_PTR_NOT_NULL(runtime.state->triggers[2].shared_indices);
+  ASSERT_NUM_EQUALS(runtime.state->triggers[3].shared_indices[0], runtime.state->triggers[2].shared_indices[0]);
+  ASSERT_NUM_EQUALS(runtime.state->shared_conditions->count, 3);
+  ASSERT_NUM_EQUALS(runtime.state->shared_conditions->num_free, 1);
+
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(event_count, 4);
+
+  ram[1] = 0x05;
+  ram[2] = 0x07;
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(event_count, 0);
+  ASSERT_NUM_EQUALS(runtime.triggers[0].trigger->requirement->conditions->current_hits, 1);
+  ASSERT_NUM_EQUALS(runtime.triggers[1].trigger->requirement->conditions->current_hits, 1);
+  ASSERT_NUM_EQUALS(runtime.triggers[2].trigger->requirement->conditions->current_hits, 1);
+  ASSERT_NUM_EQUALS(runtime.triggers[3].trigger->requirement->conditions->current_hits, 1);
+
+  /* the table is emptied as the triggers are deactivated */
+  for (i = 1; i <= 4; ++i)
+    rc_runtime_deactivate_achievement(&runtime, i);
+  ASSERT_NUM_EQUALS(runtime.state->shared_conditions->num_free, runtime.state->shared_conditions->count);
+
+  rc_runtime_destroy(&runtime);
+}
+
+static void clear_shared_conditions(rc_runtime_t* runtime, rc_runtime_trigger_state_t* trigger)
+{
+  if (trigger->shared_indices) {
+    rc_shared_conditions_release(runtime->state->shared_conditions, trigger->shared_indices, trigger->num_shared_indices);
+    free(trigger->shared_indices);
+    trigger->shared_indices = NULL;
+  }
+}
+
+static void test_shared_conditions_match_unshared(void)
+{
+  uint8_t ram[8];
+  memory_t memory;
+  rc_runtime_t runtime, shared_runtime;
+  rc_runtime_event_t expected_events[16];
+  int expected_event_count;
+  uint32_t seed = 13579;
+  uint32_t frame, i;
+  const char* memaddr[] = {
+    "b0xH0000=1_0xH0001>d0xH0001",
+    "1=b0xH0000.3._R:0xL0004>0xU0005",
+    "A:0xH0002_0xH0003=4_b0xH0000=1",
+    "A:0xH0002_0xH0003=4.2._R:0xU0005<0xL0004",
+    "0xL0004>0xU0005_b0xH0000=1S0xH0006=1Sb0xH0000!=1",
+    "N:b0xH0000=1_0xL0004>0xU0005.2.",
+    "I:0xH0007_0xH0000=2_b0xH0000=1",
+    "I:0xH0007_0xH0000=2.3._0xL0004>0xU0005",
+    "M:b0xH0000>=2.4._P:0xL0004<=0xU0005"
+  };
+  const int num_memaddrs = sizeof(memaddr) / sizeof(memaddr[0]);
+
+  memset(ram, 0, sizeof(ram));
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_runtime_init(&runtime);
+  rc_runtime_init(&shared_runtime);
+
+  for (i = 0; i < (uint32_t)num_memaddrs; ++i) {
+    assert_activate_achievement(&runtime, i + 1, memaddr[i]);
+    assert_activate_achievement(&shared_runtime, i + 1, memaddr[i]);
+    clear_shared_conditions(&runtime, &runtime.state->triggers[i]);
+  }
+
+  ASSERT_NUM_GREATER(shared_runtime.state->shared_conditions->count, 0);
+
+  for (frame = 0; frame < 2000; ++frame) {
+    for (i = 0; i < 3; ++i) {
+      seed = seed * 1103515245 + 12345;
+      ram[(seed >> 16) % sizeof(ram)] = (uint8_t)((seed >> 8) & 3);
+    }
+
+    /* let the achievements that triggered or were paused trigger again */
+    if ((frame % 250) == 0) {
+      rc_runtime_reset(&runtime);
+      rc_runtime_reset(&shared_runtime);
+    }
+
+    assert_do_frame(&runtime, &memory);
+    memcpy(expected_events, events, sizeof(events));
+    expected_event_count = event_count;
+
+    assert_do_frame(&shared_runtime, &memory);
+    ASSERT_NUM_EQUALS(event_count, expected_event_count);
+    for (i = 0; i < (uint32_t)event_count; ++i) {
+      ASSERT_NUM_EQUALS(events[i].type, expected_events[i].type);
+      ASSERT_NUM_EQUALS(events[i].id, expected_events[i].id);
+      ASSERT_NUM_EQUALS(events[i].value, expected_events[i].value);
+    }
+
+    for (i = 0; i < (uint32_t)num_memaddrs; ++i)
+      assert_triggers_match(shared_runtime.triggers[i].trigger, runtime.triggers[i].trigger);
+  }
+
+  rc_runtime_destroy(&runtime);
+  rc_runtime_destroy(&shared_runtime);
+}
+
 static void test_shared_memref(void)
 {
   uint8_t ram[] = { 0, 10, 10 };
@@ -557,6 +1589,84 @@ static void test_replace_active_trigger(void)
   rc_runtime_destroy(&runtime);
 }
 
+static void test_trigger_buffers_reused(void)
+{
+  uint8_t ram[] = { 0, 10, 10, 10 };
+  memory_t memory;
+  rc_runtime_t runtime;
+  void* buffer;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_runtime_init(&runtime);
+
+  assert_activate_achievement(&runtime, 1, "0xH0001=11");
+  assert_activate_achievement(&runtime, 2, "0xH0002=11");
+  assert_activate_lboard(&runtime, 1, "STA:0xH0001=10::SUB:0xH0001=11::CAN:0xH0001=12::VAL:0xH0000");
+  assert_activate_achievement(&runtime, 3, "0xH0003=11");
+
+  /* the buffers are laid out in the order they were activated */
+  ASSERT_TRUE((uint8_t*)runtime.triggers[0].buffer < (uint8_t*)runtime.triggers[1].buffer);
+  ASSERT_TRUE((uint8_t*)runtime.triggers[1].buffer < (uint8_t*)runtime.lboards[0].buffer);
+  ASSERT_TRUE((uint8_t*)runtime.lboards[0].buffer < (uint8_t*)runtime.triggers[2].buffer);
+
+  /* a trigger that fits in the buffer of a deactivated trigger reuses it */
+  buffer = runtime.triggers[1].buffer;
+  rc_runtime_deactivate_achievement(&runtime, 2);
+  assert_activate_achievement(&runtime, 4, "0xH0002=12");
+  ASSERT_NUM_EQUALS(runtime.triggers[2].id, 4);
+  ASSERT_PTR_EQUALS(runtime.triggers[2].buffer, buffer);
+
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(event_count, 3);
+  assert_event(RC_RUNTIME_EVENT_ACHIEVEMENT_ACTIVATED, 1, 0);
+  assert_event(RC_RUNTIME_EVENT_ACHIEVEMENT_ACTIVATED, 3, 0);
+  assert_event(RC_RUNTIME_EVENT_ACHIEVEMENT_ACTIVATED, 4, 0);
+
+  ram[2] = 12;
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(event_count, 1);
+  assert_event(RC_RUNTIME_EVENT_ACHIEVEMENT_TRIGGERED, 4, 0);
+
+  /* once everything is deactivated, the chunks are released and new ones are allocated as needed */
+  rc_runtime_deactivate_achievement(&runtime, 1);
+  rc_runtime_deactivate_achievement(&runtime, 3);
+  rc_runtime_deactivate_achievement(&runtime, 4);
+  rc_runtime_deactivate_lboard(&runtime, 1);
+  ASSERT_NUM_EQUALS(runtime.trigger_count, 0);
+  ASSERT_NUM_EQUALS(runtime.lboard_count, 0);
+
+  assert_activate_achievement(&runtime, 5, "0xH0001=11");
+  assert_do_frame(&runtime, &memory);
+  ASSERT_NUM_EQUALS(event_count, 1);
+  assert_event(RC_RUNTIME_EVENT_ACHIEVEMENT_ACTIVATED, 5, 0);
+
+  rc_runtime_destroy(&runtime);
+}
+
+static void test_trigger_buffers_merged(void)
+{
+  rc_runtime_t runtime;
+  void* buffer;
+
+  rc_runtime_init(&runtime);
+
+  assert_activate_achievement(&runtime, 1, "0xH0001=11");
+  assert_activate_achievement(&runtime, 2, "0xH0002=11");
+  assert_activate_achievement(&runtime, 3, "0xH0003=11");
+  buffer = runtime.triggers[0].buffer;
+
+  /* adjacent buffers are merged when they're released, so a larger trigger can use the space */
+  rc_runtime_deactivate_achievement(&runtime, 2);
+  rc_runtime_deactivate_achievement(&runtime, 1);
+  assert_activate_achievement(&runtime, 4, "0xH0001=11_0xH0002=11_0xH0003=11");
+  ASSERT_NUM_EQUALS(runtime.triggers[1].id, 4);
+  ASSERT_PTR_EQUALS(runtime.triggers[1].buffer, buffer);
+
+  rc_runtime_destroy(&runtime);
+}
+
 static rc_runtime_t* discarding_event_handler_runtime = NULL;
 static void discarding_event_handler(const rc_runtime_event_t* e)
 {
@@ -605,6 +1715,154 @@ static void test_trigger_deactivation(void)
   rc_runtime_destroy(&runtime);
 }
 
+static rc_trigger_t* find_achievement(const rc_runtime_t* runtime, uint32_t id)
+{
+  uint32_t i;
+
+  for (i = 0; i < runtime->trigger_count; ++i) {
+    if (runtime->triggers[i].id == id && runtime->triggers[i].trigger != NULL)
+      return runtime->triggers[i].trigger;
+  }
+
+  return NULL;
+}
+
+static rc_lboard_t* find_lboard(const rc_runtime_t* runtime, uint32_t id)
+{
+  uint32_t i;
+
+  for (i = 0; i < runtime->lboard_count; ++i) {
+    if (runtime->lboards[i].id == id && runtime->lboards[i].lboard != NULL)
+      return runtime->lboards[i].lboard;
+  }
+
+  return NULL;
+}
+
+static void test_achievement_ids(void)
+{
+  rc_runtime_t runtime;
+  char memaddr[32];
+  uint8_t active[400];
+  uint32_t seed = 12345;
+  uint32_t i, id;
+  int step;
+
+  rc_runtime_init(&runtime);
+  memset(active, 0, sizeof(active));
+
+  /* activate, replace, and deactivate achievements in a random order. ids that are multiples of
+   * a power of two are more likely to collide in the lookup table */
+  for (step = 0; step < 3000; ++step) {
+    seed = seed * 1103515245 + 12345;
+    i = (seed >> 16) % 400;
+    id = (i & 1) ? i * 1024 : i + 1;
+
+    if (!active[i] || (seed & 0x100)) {
+      sprintf(memaddr, "0xH%04x=%u", i, (seed >> 8) & 3);
+      assert_activate_achievement(&runtime, id, memaddr);
+      active[i] = 1;
+    }
+    else {
+      rc_runtime_deactivate_achievement(&runtime, id);
+      active[i] = 0;
+    }
+
+    if (step % 100 == 99) {
+      for (i = 0; i < 400; ++i) {
+        id = (i & 1) ? i * 1024 : i + 1;
+        ASSERT_PTR_EQUALS(rc_runtime_get_achievement(&runtime, id), find_achievement(&runtime, id));
+        if (active[i]) {
+          ASSERT_PTR_NOT_NULL(rc_runtime_get_achievement(&runtime, id));
+        }
+        else {
+          ASSERT_PTR_NULL(rc_runtime_get_achievement(&runtime, id));
+        }
+      }
+    }
+  }
+
+  rc_runtime_destroy(&runtime);
+}
+
+static void test_lboard_ids(void)
+{
+  rc_runtime_t runtime;
+  char memaddr[80];
+  uint8_t active[100];
+  uint32_t seed = 12345;
+  uint32_t i, id;
+  int step;
+
+  rc_runtime_init(&runtime);
+  memset(active, 0, sizeof(active));
+
+  for (step = 0; step < 1000; ++step) {
+    seed = seed * 1103515245 + 12345;
+    i = (seed >> 16) % 100;
+    id = i * 256 + 7;
+
+    if (!active[i] || (seed & 0x100)) {
+      sprintf(memaddr, "STA:0xH%04x=1::SUB:0xH%04x=2::CAN:0xH%04x=3::VAL:%u", i, i, i, (seed >> 8) & 3);
+      assert_activate_lboard(&runtime, id, memaddr);
+      active[i] = 1;
+    }
+    else {
+      rc_runtime_deactivate_lboard(&runtime, id);
+      active[i] = 0;
+    }
+
+    if (step % 50 == 49) {
+      for (i = 0; i < 100; ++i) {
+        id = i * 256 + 7;
+        ASSERT_PTR_EQUALS(rc_runtime_get_lboard(&runtime, id), find_lboard(&runtime, id));
+        if (active[i]) {
+          ASSERT_PTR_NOT_NULL(rc_runtime_get_lboard(&runtime, id));
+        }
+        else {
+          ASSERT_PTR_NULL(rc_runtime_get_lboard(&runtime, id));
+        }
+      }
+    }
+  }
+
+  rc_runtime_destroy(&runtime);
+}
+
+static void test_achievement_ids_after_direct_update(void)
+{
+  rc_runtime_t runtime;
+  rc_runtime_trigger_t swap;
+  rc_trigger_t* trigger1;
+  rc_trigger_t* trigger3;
+
+  rc_runtime_init(&runtime);
+  assert_activate_achievement(&runtime, 1, "0xH0001=1");
+  assert_activate_achievement(&runtime, 2, "0xH0002=1");
+  assert_activate_achievement(&runtime, 3, "0xH0003=1");
+  trigger1 = rc_runtime_get_achievement(&runtime, 1);
+  trigger3 = rc_runtime_get_achievement(&runtime, 3);
+
+  /* the client reorders the array itself */
+  memcpy(&swap, &runtime.triggers[0], sizeof(swap));
+  memcpy(&runtime.triggers[0], &runtime.triggers[2], sizeof(swap));
+  memcpy(&runtime.triggers[2], &swap, sizeof(swap));
+  rc_runtime_invalidate_ids(&runtime);
+
+  ASSERT_PTR_EQUALS(rc_runtime_get_achievement(&runtime, 1), trigger1);
+  ASSERT_PTR_EQUALS(rc_runtime_get_achievement(&runtime, 3), trigger3);
+
+  /* activating or deactivating rebuilds the lookup table */
+  assert_activate_achievement(&runtime, 4, "0xH0004=1");
+  rc_runtime_deactivate_achievement(&runtime, 3);
+  ASSERT_PTR_EQUALS(rc_runtime_get_achievement(&runtime, 1), trigger1);
+  ASSERT_PTR_NULL(rc_runtime_get_achievement(&runtime, 3));
+  ASSERT_PTR_NOT_NULL(rc_runtime_get_achievement(&runtime, 4));
+  ASSERT_NUM_EQUALS(runtime.trigger_count, 3);
+
+  rc_runtime_destroy(&runtime);
+}
+
 static void test_trigger_with_resetif() {
   uint8_t ram[] = {0x00, 0x00, 0x00, 0x00, 0x00};
   memory_t memory;
@@ -1616,13 +2874,33 @@ void test_runtime(void) {
   /* achievements */
   TEST(test_two_achievements_activate_and_trigger);
   TEST(test_deactivate_achievements);
+  TEST(test_deactivate_achievement_modified_memref);
+  TEST(test_deactivate_achievement_parks_memrefs);
+  TEST(test_dirty_pages_matches_full_read);
+  TEST(test_dirty_pages_ignored_after_memrefs_change);
+  TEST(test_fused_indirect_reads_match_individual_reads);
+  TEST(test_fused_indirect_reads_at_end_of_memory);
+  TEST(test_jit_matches_interpreter);
+  TEST(test_jit_deactivate_achievement);
+  TEST(test_parallel_matches_serial);
+  TEST(test_parallel_deactivate_in_event_handler);
+  TEST(test_buffered_events_match_callback);
+  TEST(test_buffered_events_overflow);
   TEST(test_achievement_measured);
   TEST(test_achievement_measured_maxint);
   TEST(test_two_achievements_differing_resets_in_alts);
 
   TEST(test_shared_memref);
+  TEST(test_shared_conditions);
+  TEST(test_shared_conditions_released);
+  TEST(test_shared_conditions_match_unshared);
   TEST(test_replace_active_trigger);
+  TEST(test_trigger_buffers_reused);
+  TEST(test_trigger_buffers_merged);
   TEST(test_trigger_deactivation);
+  TEST(test_achievement_ids);
+  TEST(test_lboard_ids);
+  TEST(test_achievement_ids_after_direct_update);
   TEST(test_trigger_with_resetif);
   TEST(test_trigger_with_resetnextif);
 
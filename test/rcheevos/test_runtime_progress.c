@@ -350,6 +350,40 @@ static void test_single_achievement()
   rc_runtime_destroy(&runtime);
 }
 
+static void test_single_achievement_reset_after_deserialize()
+{
+  uint8_t ram[] = { 0, 4, 6 };
+  uint8_t buffer[2048];
+  memory_t memory;
+  rc_runtime_t runtime, runtime2;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_runtime_init(&runtime);
+
+  assert_activate_achievement(&runtime, 1, "0xH0001=4.10._R:0xH0000=1");
+  assert_do_frame(&runtime, &memory);
+  assert_do_frame(&runtime, &memory);
+  assert_do_frame(&runtime, &memory);
+  assert_hitcount(&runtime, 1, 0, 0, 3);
+
+  assert_serialize(&runtime, buffer, sizeof(buffer));
+  rc_runtime_destroy(&runtime);
+
+  /* the restored hit count has not been evaluated yet, but must still be cleared by the ResetIf */
+  rc_runtime_init(&runtime2);
+  assert_activate_achievement(&runtime2, 1, "0xH0001=4.10._R:0xH0000=1");
+  assert_deserialize(&runtime2, buffer);
+  assert_hitcount(&runtime2, 1, 0, 0, 3);
+
+  ram[0] = 1;
+  assert_do_frame(&runtime2, &memory);
+  assert_hitcount(&runtime2, 1, 0, 0, 0);
+
+  rc_runtime_destroy(&runtime2);
+}
+
 static void test_invalid_marker()
 {
   uint8_t ram[] = { 2, 3, 6 };
@@ -594,6 +628,66 @@ static void test_single_achievement_md5_changed()
   rc_runtime_destroy(&runtime);
 }
 
+static void assert_md5(const uint8_t* md5, const char* memaddr)
+{
+  uint8_t expected[16];
+  md5_state_t state;
+
+  md5_init(&state);
+  md5_append(&state, (const uint8_t*)memaddr, (int)strlen(memaddr));
+  md5_finish(&state, expected);
+
+  ASSERT_TRUE(memcmp(md5, expected, sizeof(expected)) == 0);
+}
+
+static void test_md5_calculated_when_activated()
+{
+  const char* achievement = "0xH0001=4_0xH0002=5";
+  const char* achievement2 = "0xH0001=4_0xH0002=6";
+  const char* leaderboard = "STA:0xH0001=4::SUB:0xH0001=5.4.::CAN:0xH0001=0.4.::VAL:0xH0002";
+  uint8_t ram[] = { 2, 3, 6 };
+  uint8_t buffer[2048];
+  memory_t memory;
+  rc_runtime_t runtime;
+  rc_runtime_t runtime2;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  rc_runtime_init(&runtime);
+
+  assert_activate_achievement(&runtime, 1, achievement);
+  assert_activate_leaderboard(&runtime, 2, leaderboard);
+  assert_md5(runtime.triggers[0].md5, achievement);
+  assert_md5(runtime.lboards[0].md5, leaderboard);
+
+  /* reactivating an unchanged definition keeps the md5 */
+  assert_activate_achievement(&runtime, 1, achievement);
+  assert_md5(runtime.triggers[0].md5, achievement);
+
+  ram[1] = 4;
+  assert_do_frame(&runtime, &memory);
+  assert_do_frame(&runtime, &memory);
+  assert_hitcount(&runtime, 1, 0, 0, 2);
+  assert_serialize(&runtime, buffer, sizeof(buffer));
+
+  rc_runtime_init(&runtime2);
+  assert_activate_achievement(&runtime2, 1, achievement);
+  assert_activate_leaderboard(&runtime2, 2, leaderboard);
+  assert_deserialize(&runtime2, buffer);
+  assert_hitcount(&runtime2, 1, 0, 0, 2);
+  assert_sta_hitcount(&runtime2, 2, 0, 0, 2);
+
+  /* a changed definition gets a new md5, and doesn't match the serialized progress */
+  assert_activate_achievement(&runtime2, 1, achievement2);
+  assert_md5(runtime2.triggers[0].md5, achievement2);
+  assert_deserialize(&runtime2, buffer);
+  assert_hitcount(&runtime2, 1, 0, 0, 0);
+
+  rc_runtime_destroy(&runtime2);
+  rc_runtime_destroy(&runtime);
+}
+
 static void setup_multiple_achievements(rc_runtime_t* runtime, memory_t* memory)
 {
   rc_runtime_init(runtime);
@@ -1781,11 +1875,13 @@ void test_runtime_progress(void) {
 
   TEST(test_empty);
   TEST(test_single_achievement);
+  TEST(test_single_achievement_reset_after_deserialize);
   TEST(test_invalid_marker);
   TEST(test_invalid_memref_chunk_id);
   TEST(test_modified_data);
   TEST(test_single_achievement_deactivated);
   TEST(test_single_achievement_md5_changed);
+  TEST(test_md5_calculated_when_activated);
   TEST(test_single_achievement_sized);
   TEST(test_empty_sized);
 
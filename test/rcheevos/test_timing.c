@@ -5,8 +5,10 @@
 
 #include "../test_framework.h"
 
+#include <stdlib.h>
+
 static rc_runtime_t runtime;
-static int trigger_count[128];
+static int trigger_count[256];
 
 static void event_handler(const rc_runtime_event_t* e)
 {
@@ -155,8 +157,864 @@ static void do_timing(void)
   rc_runtime_destroy(&runtime);
 }
 
+static void do_load_timing(void)
+{
+  char memaddr[1024];
+  char* ptr;
+  uint32_t address = 0;
+  int i, j;
+  clock_t start, end;
+  double elapsed;
+
+  rc_runtime_init(&runtime);
+
+  start = clock();
+
+  /* 250 achievements with 40 distinct addresses each = 10000 memrefs */
+  for (i = 0; i < 250; i++)
+  {
+    ptr = memaddr;
+    for (j = 0; j < 40; j++)
+    {
+      if (j > 0)
+        *ptr++ = '_';
+      ptr += sprintf(ptr, "0xH%06x=%d", address++, j);
+    }
+
+    assert_activate_achievement(&runtime, i + 1, memaddr);
+  }
+
+  end = clock();
+
+  elapsed = (double)(end - start) * 1000 / CLOCKS_PER_SEC;
+  printf("\n%0.6fms elapsed loading %u memrefs", elapsed, rc_memrefs_count_memrefs(runtime.memrefs));
+
+  ASSERT_NUM_EQUALS(rc_memrefs_count_memrefs(runtime.memrefs), 10000);
+
+  rc_runtime_destroy(&runtime);
+}
+
+static double time_frames(memory_t* memory, int frames)
+{
+  clock_t start, end;
+  int i;
+
+  start = clock();
+  for (i = 0; i < frames; i++)
+    rc_runtime_do_frame(&runtime, event_handler, peek, memory, NULL);
+  end = clock();
+
+  return (double)(end - start) * 1000 / CLOCKS_PER_SEC;
+}
+
+static void do_deactivate_timing(void)
+{
+  static uint8_t ram[0x4000];
+  char memaddr[1024];
+  char* ptr;
+  memory_t memory;
+  uint32_t address = 0;
+  double active_elapsed, deactivated_elapsed;
+  int i, j;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+  memset(ram, 0, sizeof(ram));
+
+  rc_runtime_init(&runtime);
+
+  /* 250 achievements with 40 distinct addresses each = 10000 memrefs */
+  for (i = 0; i < 250; i++)
+  {
+    ptr = memaddr;
+    for (j = 0; j < 40; j++)
+    {
+      if (j > 0)
+        *ptr++ = '_';
+      ptr += sprintf(ptr, "0xH%06x=%d", address++, j + 1);
+    }
+
+    assert_activate_achievement(&runtime, i + 1, memaddr);
+  }
+
+  active_elapsed = time_frames(&memory, 1000);
+
+  /* 90% of the achievements are unlocked */
+  for (i = 0; i < 225; i++)
+    rc_runtime_deactivate_achievement(&runtime, i + 1);
+
+  deactivated_elapsed = time_frames(&memory, 1000);
+
+  printf("\n%0.6fms elapsed for 1000 frames with 250 achievements (%0.6fms after deactivating 225)",
+      active_elapsed, deactivated_elapsed);
+
+  ASSERT_NUM_EQUALS(rc_memrefs_count_memrefs(runtime.memrefs), 10000);
+  ASSERT_NUM_EQUALS(runtime.memrefs->schedule->num_memrefs, 1000);
+
+  rc_runtime_destroy(&runtime);
+}
+
+static void activate_jit_timing_achievements(void)
+{
+  char memaddr[256];
+  uint32_t i, a;
+
+  /* 120 achievements in the shapes most commonly found in sets: hit targets, deltas, chains, resets, and alts */
+  for (i = 0; i < 120; i++)
+  {
+    a = i * 16;
+    switch (i % 4)
+    {
+      case 0:
+        sprintf(memaddr, "0xH%04x=%u_0xH%04x>d0xH%04x_0xH%04x<=%u.%u._R:0xH%04x=255",
+            a, i, a + 1, a + 1, a + 2, i + 100, (i % 7) + 2, a + 3);
+        break;
+      case 1:
+        sprintf(memaddr, "N:0xH%04x=%u_O:0xH%04x=%u_0xH%04x!=0.%u._P:0xH%04x>250_Z:0xH%04x=0_0xH%04x>d0xH%04x.5.",
+            a, i, a + 1, i + 1, a + 2, (i % 5) + 3, a + 3, a + 4, a + 5, a + 5);
+        break;
+      case 2:
+        sprintf(memaddr, "C:0xH%04x=1_C:0xH%04x=2_D:0xH%04x=3_0xH%04x=4.%u._0xH%04x>=0xH%04x_R:0xH%04x=0xH%04x",
+            a, a + 1, a + 2, a + 3, (i % 9) + 4, a + 4, a + 5, a + 6, a + 7);
+        break;
+      default:
+        sprintf(memaddr, "0xH%04x=%u_M:0xH%04x!=d0xH%04x.20.S0xH%04x=d0xH%04x_0xH%04x>%uS0xH%04x<0xH%04x.3._R:0xH%04x=255",
+            a, i % 2, a + 1, a + 1, a + 2, a + 2, a + 3, i, a + 4, a + 5, a + 6);
+        break;
+    }
+
+    assert_activate_achievement(&runtime, i + 1, memaddr);
+  }
+}
+
+static double time_mutating_frames(uint8_t* ram, memory_t* memory, int frames)
+{
+  clock_t total_clocks = 0, start, end;
+  int i, j;
+
+  for (i = 0; i < frames; i++)
+  {
+    for (j = 0; j < 64; j++)
+      ram[(i * 7919 + j * 104729) & 0x7FF]++;
+
+    start = clock();
+    rc_runtime_do_frame(&runtime, event_handler, peek, memory, NULL);
+    end = clock();
+
+    total_clocks += (end - start);
+  }
+
+  return (double)total_clocks * 1000 / CLOCKS_PER_SEC;
+}
+
+static void do_jit_timing(void)
+{
+  static uint8_t ram[0x800];
+  int interpreted_count[256];
+  memory_t memory;
+  double interpreted_elapsed, jit_elapsed;
+  int i, total = 0;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  memset(ram, 0, sizeof(ram));
+  memset(&trigger_count, 0, sizeof(trigger_count));
+  rc_runtime_init(&runtime);
+  activate_jit_timing_achievements();
+  interpreted_elapsed = time_mutating_frames(ram, &memory, 20000);
+  rc_runtime_destroy(&runtime);
+  memcpy(interpreted_count, trigger_count, sizeof(trigger_count));
+
+  memset(ram, 0, sizeof(ram));
+  memset(&trigger_count, 0, sizeof(trigger_count));
+  rc_runtime_init(&runtime);
+  rc_runtime_set_jit_enabled(&runtime, 1);
+  activate_jit_timing_achievements();
+  jit_elapsed = time_mutating_frames(ram, &memory, 20000);
+  rc_runtime_destroy(&runtime);
+
+  printf("\n%0.6fms elapsed for 20000 frames with 120 compiled achievements (%0.6fms interpreted)",
+      jit_elapsed, interpreted_elapsed);
+
+  for (i = 0; i < 256; i++)
+  {
+    ASSERT_NUM_EQUALS(trigger_count[i], interpreted_count[i]);
+    total += trigger_count[i];
+  }
+
+  ASSERT_NUM_GREATER(total, 0);
+}
+
+static void steady_event_handler(const rc_runtime_event_t* e)
+{
+  if (e->type == RC_RUNTIME_EVENT_ACHIEVEMENT_TRIGGERED)
+  {
+    trigger_count[e->id]++;
+
+    /* rearm, but don't trigger again until the trigger is false */
+    rc_reset_trigger(rc_runtime_get_achievement(&runtime, e->id));
+  }
+}
+
+static void disable_steady_tracking(uint32_t id)
+{
+  uint32_t i;
+
+  /* a steady tracker that doesn't qualify makes the runtime evaluate the trigger every frame */
+  for (i = 0; i < runtime.trigger_count; i++)
+  {
+    if (runtime.triggers[i].id == id)
+    {
+      rc_trigger_steady_destroy(runtime.state->triggers[i].steady);
+      runtime.state->triggers[i].steady = rc_trigger_steady_create(runtime.triggers[i].trigger);
+      runtime.state->triggers[i].steady->num_conditions = 0;
+    }
+  }
+}
+
+static void activate_steady_timing_achievements(int skip)
+{
+  char memaddr[256];
+  uint32_t i, a;
+
+  /* 200 achievements without hit targets, which only need to be evaluated when something they read changes */
+  for (i = 0; i < 200; i++)
+  {
+    a = i * 10;
+    switch (i % 4)
+    {
+      case 0:
+        sprintf(memaddr, "0xH%04x=%u_0xH%04x>d0xH%04x_R:0xH%04x=255", a, (i % 3) + 1, a + 1, a + 1, a + 2);
+        break;
+      case 1:
+        sprintf(memaddr, "N:0xH%04x=%u_O:0xH%04x=%u_0xH%04x!=0_P:0xH%04x>250", a, (i % 3) + 1, a + 1, (i % 2) + 2, a + 2, a + 3);
+        break;
+      case 2:
+        sprintf(memaddr, "0xH%04x>=0xH%04x_R:0xH%04x>0xH%04x_0xH%04x=%u", a, a + 1, a + 2, a + 3, a + 4, (i % 3) + 1);
+        break;
+      default:
+        sprintf(memaddr, "0xH%04x=%u_T:0xH%04x!=d0xH%04xS0xH%04x=d0xH%04x_0xH%04x>%uS0xH%04x<0xH%04x",
+            a, (i % 2) + 1, a + 1, a + 1, a + 2, a + 2, a + 3, i % 4, a + 4, a + 5);
+        break;
+    }
+
+    assert_activate_achievement(&runtime, i + 1, memaddr);
+    if (!skip)
+      disable_steady_tracking(i + 1);
+  }
+}
+
+static double time_sparse_frames(uint8_t* ram, memory_t* memory, int frames)
+{
+  clock_t total_clocks = 0, start, end;
+  int i, j;
+
+  for (i = 0; i < frames; i++)
+  {
+    /* most of memory doesn't change from one frame to the next */
+    for (j = 0; j < 4; j++)
+      ram[(i * 7919 + j * 104729) % 2000] = (uint8_t)(i & 3);
+
+    start = clock();
+    rc_runtime_do_frame(&runtime, steady_event_handler, peek, memory, NULL);
+    end = clock();
+
+    total_clocks += (end - start);
+  }
+
+  return (double)total_clocks * 1000 / CLOCKS_PER_SEC;
+}
+
+static void do_steady_timing(void)
+{
+  static uint8_t ram[0x800];
+  int evaluated_count[256];
+  memory_t memory;
+  double evaluated_elapsed, skipped_elapsed;
+  int i, total = 0;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  memset(ram, 0, sizeof(ram));
+  memset(&trigger_count, 0, sizeof(trigger_count));
+  rc_runtime_init(&runtime);
+  activate_steady_timing_achievements(0);
+  evaluated_elapsed = time_sparse_frames(ram, &memory, 20000);
+  rc_runtime_destroy(&runtime);
+  memcpy(evaluated_count, trigger_count, sizeof(trigger_count));
+
+  memset(ram, 0, sizeof(ram));
+  memset(&trigger_count, 0, sizeof(trigger_count));
+  rc_runtime_init(&runtime);
+  activate_steady_timing_achievements(1);
+  skipped_elapsed = time_sparse_frames(ram, &memory, 20000);
+  rc_runtime_destroy(&runtime);
+
+  printf("\n%0.6fms elapsed for 20000 frames with 200 achievements skipped when unchanged (%0.6fms evaluated)",
+      skipped_elapsed, evaluated_elapsed);
+
+  for (i = 0; i < 256; i++)
+  {
+    ASSERT_NUM_EQUALS(trigger_count[i], evaluated_count[i]);
+    total += trigger_count[i];
+  }
+
+  ASSERT_NUM_GREATER(total, 0);
+}
+
+static void clear_shared_conditions(uint32_t id)
+{
+  uint32_t i;
+
+  for (i = 0; i < runtime.trigger_count; i++)
+  {
+    if (runtime.triggers[i].id == id && runtime.state->triggers[i].shared_indices)
+    {
+      rc_shared_conditions_release(runtime.state->shared_conditions, runtime.state->triggers[i].shared_indices,
+          runtime.state->triggers[i].num_shared_indices);
+      free(runtime.state->triggers[i].shared_indices);
+      runtime.state->triggers[i].shared_indices = NULL;
+    }
+  }
+}
+
+static void activate_shared_timing_achievements(int share)
+{
+  char memaddr[256];
+  uint32_t i, a;
+
+  /* 200 achievements that make the same handful of BCD and nibble comparisons against different targets */
+  for (i = 0; i < 200; i++)
+  {
+    a = (i % 8) * 4;
+    sprintf(memaddr, "b0xH%04x=%u_0xL%04x>=0xU%04x_0xH%04x=%u.%u.Sb0xH%04x<%uS0xL%04x<0xU%04x_R:b0xH%04x=99",
+        a, i % 3, a + 1, a + 1, a + 2, i % 4, (i % 5) + 2, a + 3, (i % 6) + 4, a + 1, a + 1, a);
+
+    assert_activate_achievement(&runtime, i + 1, memaddr);
+
+    disable_steady_tracking(i + 1);
+    if (!share)
+      clear_shared_conditions(i + 1);
+  }
+}
+
+static double time_changing_frames(uint8_t* ram, memory_t* memory, int frames)
+{
+  clock_t total_clocks = 0, start, end;
+  int i, j;
+
+  for (i = 0; i < frames; i++)
+  {
+    for (j = 0; j < 4; j++)
+      ram[(i * 7919 + j * 104729) % 32] = (uint8_t)((i >> j) & 7);
+
+    start = clock();
+    rc_runtime_do_frame(&runtime, steady_event_handler, peek, memory, NULL);
+    end = clock();
+
+    total_clocks += (end - start);
+  }
+
+  return (double)total_clocks * 1000 / CLOCKS_PER_SEC;
+}
+
+static void do_shared_timing(void)
+{
+  static uint8_t ram[0x40];
+  int unshared_count[256];
+  memory_t memory;
+  double unshared_elapsed, shared_elapsed;
+  int i, total = 0;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  memset(ram, 0, sizeof(ram));
+  memset(&trigger_count, 0, sizeof(trigger_count));
+  rc_runtime_init(&runtime);
+  activate_shared_timing_achievements(0);
+  unshared_elapsed = time_changing_frames(ram, &memory, 20000);
+  rc_runtime_destroy(&runtime);
+  memcpy(unshared_count, trigger_count, sizeof(trigger_count));
+
+  memset(ram, 0, sizeof(ram));
+  memset(&trigger_count, 0, sizeof(trigger_count));
+  rc_runtime_init(&runtime);
+  activate_shared_timing_achievements(1);
+  shared_elapsed = time_changing_frames(ram, &memory, 20000);
+  rc_runtime_destroy(&runtime);
+
+  printf("\n%0.6fms elapsed for 20000 frames with 200 achievements sharing comparisons (%0.6fms unshared)",
+      shared_elapsed, unshared_elapsed);
+
+  for (i = 0; i < 256; i++)
+  {
+    ASSERT_NUM_EQUALS(trigger_count[i], unshared_count[i]);
+    total += trigger_count[i];
+  }
+
+  ASSERT_NUM_GREATER(total, 0);
+}
+
+static uint32_t value_checksum;
+
+static void value_event_handler(const rc_runtime_event_t* e)
+{
+  if (e->type == RC_RUNTIME_EVENT_LBOARD_UPDATED)
+    value_checksum = value_checksum * 31 + (uint32_t)e->value;
+}
+
+static void activate_value_timing_runtime(int integer)
+{
+  char memaddr[256];
+  char script[2048];
+  char* ptr = script;
+  rc_modified_memref_list_t* modified_memref_list;
+  rc_modified_memref_t* modified_memref;
+  uint32_t i, a;
+
+  /* 200 leaderboards that total up a few scaled and masked values, like score and time displays */
+  for (i = 0; i < 200; i++)
+  {
+    a = 0x10 + (i * 5) % 0x3E0;
+    sprintf(memaddr, "STA:0xH0000=1::CAN:0xH0000=2::SUB:0xH0001=99::VAL:"
+        "A:0xH%04x*10_A:0xH%04x*100_B:0xH%04x/4_A:0xL%04x*%u_M:0x %04x%%1000$A:0xH%04x*60_M:0xH%04x",
+        a, a + 1, a + 2, a + 3, (i % 9) + 1, a + 4, a + 2, a + 3);
+
+    ASSERT_NUM_EQUALS(rc_runtime_activate_lboard(&runtime, i + 1, memaddr, NULL, 0), RC_OK);
+  }
+
+  /* and a rich presence that displays several macros built the same way */
+  ptr += sprintf(ptr, "Format:Score\nFormatType=VALUE\n\nDisplay:\n");
+  for (i = 0; i < 8; i++)
+    ptr += sprintf(ptr, "@Score(A:0xH%04x*100_A:0xH%04x*10_B:0xH%04x_M:0xH%04x) ",
+        0x20 + i * 4, 0x21 + i * 4, 0x22 + i * 4, 0x23 + i * 4);
+  sprintf(ptr, "\n");
+  ASSERT_NUM_EQUALS(rc_runtime_activate_richpresence(&runtime, script, NULL, 0), RC_OK);
+
+  if (!integer) {
+    /* force everything through the typed calculation for comparison */
+    for (modified_memref_list = &runtime.memrefs->modified_memrefs; modified_memref_list; modified_memref_list = modified_memref_list->next) {
+      for (i = 0; i < modified_memref_list->count; i++) {
+        modified_memref = &modified_memref_list->items[i];
+        modified_memref->is_integer = 0;
+      }
+    }
+  }
+}
+
+static double time_value_frames(uint8_t* ram, memory_t* memory, int frames)
+{
+  char buffer[256];
+  clock_t total_clocks = 0, start, end;
+  int i, j;
+
+  ram[0] = 1;
+  for (i = 0; i < frames; i++)
+  {
+    for (j = 0; j < 16; j++)
+      ram[0x10 + (i * 7919 + j * 104729) % 0x3F0] = (uint8_t)(i * (j + 1));
+
+    start = clock();
+    rc_runtime_do_frame(&runtime, value_event_handler, peek, memory, NULL);
+    rc_runtime_get_richpresence(&runtime, buffer, sizeof(buffer), peek, memory, NULL);
+    end = clock();
+
+    total_clocks += (end - start);
+
+    for (j = 0; buffer[j]; j++)
+      value_checksum = value_checksum * 31 + (uint8_t)buffer[j];
+  }
+
+  return (double)total_clocks * 1000 / CLOCKS_PER_SEC;
+}
+
+static void do_value_timing(void)
+{
+  static uint8_t ram[0x400];
+  memory_t memory;
+  double typed_elapsed, integer_elapsed;
+  uint32_t typed_checksum;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  memset(ram, 0, sizeof(ram));
+  value_checksum = 0;
+  rc_runtime_init(&runtime);
+  activate_value_timing_runtime(0);
+  typed_elapsed = time_value_frames(ram, &memory, 10000);
+  rc_runtime_destroy(&runtime);
+  typed_checksum = value_checksum;
+
+  memset(ram, 0, sizeof(ram));
+  value_checksum = 0;
+  rc_runtime_init(&runtime);
+  activate_value_timing_runtime(1);
+  integer_elapsed = time_value_frames(ram, &memory, 10000);
+  rc_runtime_destroy(&runtime);
+
+  printf("\n%0.6fms elapsed for 10000 frames with 200 leaderboards and 8 rich presence macros (%0.6fms typed)",
+      integer_elapsed, typed_elapsed);
+
+  ASSERT_NUM_NOT_EQUALS(value_checksum, 0);
+  ASSERT_NUM_EQUALS(value_checksum, typed_checksum);
+}
+
+static double time_reset_frames(uint8_t* ram, memory_t* memory, int frames, int full_reset)
+{
+  clock_t total_clocks = 0, start, end;
+  rc_condset_t* condset;
+  rc_trigger_t* trigger;
+  uint32_t i;
+  int frame;
+
+  for (frame = 0; frame < frames; frame++)
+  {
+    /* most of the time is spent on a title screen where every achievement is held in reset */
+    ram[0] = (frame % 64) < 56 ? 1 : 0;
+    ram[1 + frame % 0x3F] = (uint8_t)(frame % 8);
+
+    if (full_reset) {
+      /* pretend every condset has hits, so a reset clears all of them */
+      for (i = 0; i < runtime.trigger_count; i++) {
+        trigger = runtime.triggers[i].trigger;
+        if (trigger->requirement)
+          ((rc_condset_with_trailing_conditions_t*)trigger->requirement)->has_hits = 1;
+        for (condset = trigger->alternative; condset; condset = condset->next)
+          ((rc_condset_with_trailing_conditions_t*)condset)->has_hits = 1;
+      }
+    }
+
+    start = clock();
+    rc_runtime_do_frame(&runtime, event_handler, peek, memory, NULL);
+    end = clock();
+
+    total_clocks += (end - start);
+  }
+
+  return (double)total_clocks * 1000 / CLOCKS_PER_SEC;
+}
+
+static void do_reset_timing(void)
+{
+  static uint8_t ram[0x40];
+  char memaddr[512];
+  char* ptr;
+  memory_t memory;
+  double full_elapsed, lazy_elapsed;
+  int full_count[256];
+  int i, j, total = 0;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  memset(ram, 0, sizeof(ram));
+  memset(&trigger_count, 0, sizeof(trigger_count));
+  rc_runtime_init(&runtime);
+  /* achievements with a lot of conditions, all of which are held in reset by the first one */
+  for (i = 0; i < 200; i++) {
+    ptr = memaddr + sprintf(memaddr, "R:0xH0000=1_0xH%04x=%d.3.", 1 + i % 0x3F, i % 8);
+    for (j = 1; j < 24; j++)
+      ptr += sprintf(ptr, "_0xH%04x<%d", 1 + (i + j) % 0x3F, 7 + j % 2);
+    assert_activate_achievement(&runtime, i + 1, memaddr);
+  }
+  full_elapsed = time_reset_frames(ram, &memory, 20000, 1);
+  memcpy(full_count, trigger_count, sizeof(trigger_count));
+
+  memset(ram, 0, sizeof(ram));
+  memset(&trigger_count, 0, sizeof(trigger_count));
+  rc_runtime_reset(&runtime);
+  lazy_elapsed = time_reset_frames(ram, &memory, 20000, 0);
+  rc_runtime_destroy(&runtime);
+
+  printf("\n%0.6fms elapsed for 20000 frames with 200 achievements mostly held in reset (%0.6fms clearing every condset)",
+      lazy_elapsed, full_elapsed);
+
+  for (i = 0; i < 256; i++)
+  {
+    ASSERT_NUM_EQUALS(trigger_count[i], full_count[i]);
+    total += trigger_count[i];
+  }
+
+  ASSERT_NUM_GREATER(total, 0);
+}
+
+static void activate_field_timing_achievements(void)
+{
+  char memaddr[256];
+  uint32_t i, a;
+
+  /* 200 achievements that check several item flags and counts packed into the same inventory bytes */
+  for (i = 0; i < 200; i++)
+  {
+    a = (i * 2) % 0x100;
+    sprintf(memaddr, "0xM%04x=1_0xN%04x=1_0xO%04x=%u_0xP%04x=1_0xQ%04x=1_0xR%04x!=0_"
+        "0xS%04x=%u_0xT%04x=1_0xU%04x<=%u_0xL%04x!=0_R:0xH%04x=255",
+        a, a, a, i % 2, a, a, a + 1, a + 1, (i / 2) % 2, a + 1, a + 1, (i / 4) % 4 + 10, a + 1, (a + 8) % 0x100);
+
+    assert_activate_achievement(&runtime, i + 1, memaddr);
+  }
+}
+
+static double time_flag_frames(uint8_t* ram, memory_t* memory, int frames)
+{
+  clock_t total_clocks = 0, start, end;
+  uint32_t seed = 12345;
+  int i, j;
+
+  for (i = 0; i < frames; i++)
+  {
+    for (j = 0; j < 32; j++)
+    {
+      seed = seed * 1103515245 + 12345;
+      ram[(seed >> 8) % 0x100] = (uint8_t)(seed >> 24);
+    }
+
+    start = clock();
+    rc_runtime_do_frame(&runtime, steady_event_handler, peek, memory, NULL);
+    end = clock();
+
+    total_clocks += (end - start);
+  }
+
+  return (double)total_clocks * 1000 / CLOCKS_PER_SEC;
+}
+
+static void do_field_timing(void)
+{
+  static uint8_t ram[0x100];
+  memory_t memory;
+  double elapsed;
+  int i, total = 0;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  memset(ram, 0, sizeof(ram));
+  memset(&trigger_count, 0, sizeof(trigger_count));
+  rc_runtime_init(&runtime);
+  activate_field_timing_achievements();
+  elapsed = time_flag_frames(ram, &memory, 20000);
+  rc_runtime_destroy(&runtime);
+
+  /* build with HAVE_FIELD_COMPARES=0 to time comparing each field separately */
+#ifdef RC_CONDSET_NO_FIELD_COMPARES
+  printf("\n%0.6fms elapsed for 20000 frames with 200 flag achievements (comparing each field separately)", elapsed);
+#else
+  printf("\n%0.6fms elapsed for 20000 frames with 200 flag achievements", elapsed);
+#endif
+
+  for (i = 0; i < 256; i++)
+    total += trigger_count[i];
+
+  ASSERT_NUM_GREATER(total, 0);
+}
+
+static rc_trigger_t* scan_achievement(const rc_runtime_t* runtime, uint32_t id)
+{
+  uint32_t i;
+
+  for (i = 0; i < runtime->trigger_count; ++i)
+  {
+    if (runtime->triggers[i].id == id && runtime->triggers[i].trigger != NULL)
+      return runtime->triggers[i].trigger;
+  }
+
+  return NULL;
+}
+
+static void do_id_timing(void)
+{
+  char memaddr[64];
+  clock_t start, end;
+  double activate_elapsed, lookup_elapsed, scan_elapsed, deactivate_elapsed;
+  uint32_t i, j, found = 0, scanned = 0;
+
+  rc_runtime_init(&runtime);
+
+  /* 5000 achievements with sparse ids, like a client loading several large sets */
+  start = clock();
+  for (i = 0; i < 5000; i++)
+  {
+    sprintf(memaddr, "0xH%04x=%u_0xH%04x>d0xH%04x", i % 0x800, i % 7, (i * 3) % 0x800, (i * 3) % 0x800);
+    assert_activate_achievement(&runtime, 100000 + i * 37, memaddr);
+  }
+  end = clock();
+  activate_elapsed = (double)(end - start) * 1000 / CLOCKS_PER_SEC;
+
+  /* an event handler looks up the achievement for every event */
+  start = clock();
+  for (j = 0; j < 20; j++)
+  {
+    for (i = 0; i < 5000; i++)
+      found += (rc_runtime_get_achievement(&runtime, 100000 + ((i * 7919) % 5000) * 37) != NULL);
+  }
+  end = clock();
+  lookup_elapsed = (double)(end - start) * 1000 / CLOCKS_PER_SEC;
+
+  start = clock();
+  for (j = 0; j < 20; j++)
+  {
+    for (i = 0; i < 5000; i++)
+      scanned += (scan_achievement(&runtime, 100000 + ((i * 7919) % 5000) * 37) != NULL);
+  }
+  end = clock();
+  scan_elapsed = (double)(end - start) * 1000 / CLOCKS_PER_SEC;
+
+  start = clock();
+  for (i = 0; i < 5000; i++)
+    rc_runtime_deactivate_achievement(&runtime, 100000 + i * 37);
+  end = clock();
+  deactivate_elapsed = (double)(end - start) * 1000 / CLOCKS_PER_SEC;
+
+  printf("\n%0.6fms elapsed activating 5000 achievements, %0.6fms deactivating them",
+      activate_elapsed, deactivate_elapsed);
+  printf("\n%0.6fms elapsed for 100000 achievement lookups (%0.6fms scanning)", lookup_elapsed, scan_elapsed);
+
+  ASSERT_NUM_EQUALS(found, 100000);
+  ASSERT_NUM_EQUALS(scanned, 100000);
+  ASSERT_NUM_EQUALS(runtime.trigger_count, 0);
+
+  rc_runtime_destroy(&runtime);
+}
+
+static void ignore_event_handler(const rc_runtime_event_t* e)
+{
+  (void)e;
+}
+
+static void activate_arena_timing_set(void)
+{
+  char memaddr[128];
+  uint32_t i;
+
+  /* 1000 achievements and 100 leaderboards, like a large set */
+  for (i = 0; i < 1000; i++)
+  {
+    sprintf(memaddr, "0xH%04x=%u_0xH%04x>d0xH%04x_R:0xH%04x=255", i % 0x800, i % 7, (i * 3) % 0x800, (i * 3) % 0x800, (i * 5) % 0x800);
+    assert_activate_achievement(&runtime, i + 1, memaddr);
+  }
+
+  for (i = 0; i < 100; i++)
+  {
+    sprintf(memaddr, "STA:0xH%04x=1::CAN:0xH%04x=2::SUB:0xH%04x=3::VAL:0xH%04x", i, i + 100, i + 200, i + 300);
+    ASSERT_NUM_EQUALS(rc_runtime_activate_lboard(&runtime, i + 1, memaddr, NULL, 0), RC_OK);
+  }
+}
+
+static void do_arena_timing(void)
+{
+  static uint8_t ram[0x800];
+  memory_t memory;
+  clock_t start, end;
+  double load_elapsed, reload_elapsed, frame_elapsed;
+  char memaddr[128];
+  uint32_t i, j;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+  memset(ram, 0, sizeof(ram));
+
+  /* loading and unloading a game */
+  start = clock();
+  for (j = 0; j < 20; j++)
+  {
+    rc_runtime_init(&runtime);
+    activate_arena_timing_set();
+    rc_runtime_destroy(&runtime);
+  }
+  end = clock();
+  load_elapsed = (double)(end - start) * 1000 / CLOCKS_PER_SEC;
+
+  rc_runtime_init(&runtime);
+  activate_arena_timing_set();
+
+  start = clock();
+  for (i = 0; i < 2000; i++)
+  {
+    ram[i % 0x800] = (uint8_t)i;
+    rc_runtime_do_frame(&runtime, ignore_event_handler, peek, &memory, NULL);
+  }
+  end = clock();
+  frame_elapsed = (double)(end - start) * 1000 / CLOCKS_PER_SEC;
+
+  /* unlocked achievements are deactivated, and reactivated with new definitions */
+  start = clock();
+  for (j = 0; j < 20; j++)
+  {
+    for (i = 0; i < 1000; i++)
+      rc_runtime_deactivate_achievement(&runtime, i + 1);
+
+    for (i = 0; i < 1000; i++)
+    {
+      sprintf(memaddr, "0xH%04x=%u_0xH%04x>d0xH%04x_R:0xH%04x=255", i % 0x800, (i + j) % 7, (i * 3) % 0x800, (i * 3) % 0x800, (i * 5) % 0x800);
+      assert_activate_achievement(&runtime, i + 1, memaddr);
+    }
+  }
+  end = clock();
+  reload_elapsed = (double)(end - start) * 1000 / CLOCKS_PER_SEC;
+
+  printf("\n%0.6fms elapsed loading and unloading 1100 items 20 times, %0.6fms replacing 1000 achievements 20 times",
+      load_elapsed, reload_elapsed);
+  printf("\n%0.6fms elapsed for 2000 frames with 1100 items", frame_elapsed);
+
+  ASSERT_NUM_EQUALS(runtime.trigger_count, 1000);
+  rc_runtime_destroy(&runtime);
+}
+
+static void do_checksum_timing(void)
+{
+  clock_t start, end;
+  clock_t activate_clocks = 0;
+  double activate_elapsed, reactivate_elapsed;
+  uint32_t j;
+
+  /* activating a large set from scratch checksums and parses every definition */
+  for (j = 0; j < 20; j++)
+  {
+    rc_runtime_init(&runtime);
+    start = clock();
+    activate_arena_timing_set();
+    end = clock();
+    activate_clocks += end - start;
+    rc_runtime_destroy(&runtime);
+  }
+  activate_elapsed = (double)activate_clocks * 1000 / CLOCKS_PER_SEC;
+
+  /* reactivating the same definitions (i.e. resetting the game) only checksums them */
+  rc_runtime_init(&runtime);
+  activate_arena_timing_set();
+
+  start = clock();
+  for (j = 0; j < 200; j++)
+    activate_arena_timing_set();
+  end = clock();
+  reactivate_elapsed = (double)(end - start) * 1000 / CLOCKS_PER_SEC;
+
+  printf("\n%0.6fms elapsed activating 1100 items 20 times (%0.3fus each), %0.6fms reactivating them 200 times (%0.3fus each)",
+      activate_elapsed, activate_elapsed * 1000 / (1100 * 20), reactivate_elapsed, reactivate_elapsed * 1000 / (1100 * 200));
+
+  ASSERT_NUM_EQUALS(runtime.trigger_count, 1000);
+  ASSERT_NUM_EQUALS(runtime.lboard_count, 100);
+  rc_runtime_destroy(&runtime);
+}
+
 void test_timing(void) {
   TEST_SUITE_BEGIN();
+  TEST(do_load_timing);
+  TEST(do_deactivate_timing);
+  TEST(do_jit_timing);
+  TEST(do_steady_timing);
+  TEST(do_shared_timing);
+  TEST(do_value_timing);
+  TEST(do_reset_timing);
+  TEST(do_field_timing);
+  TEST(do_id_timing);
+  TEST(do_arena_timing);
+  TEST(do_checksum_timing);
   TEST(do_timing);
   TEST(do_timing);
   TEST(do_timing);
@@ -71,6 +71,10 @@ static int evaluate_trigger(rc_trigger_t* self, memory_t* memory) {
   return rc_evaluate_trigger(self, peek, memory, NULL);
 }
 
+static int evaluate_steady_trigger(rc_trigger_t* self, rc_trigger_steady_t* steady, memory_t* memory) {
+  return rc_evaluate_trigger_jit(self, peek, memory, NULL, steady, NULL, NULL);
+}
+
 /* ======================================================== */
 
 static void test_alt_groups() {
@@ -1629,7 +1633,7 @@ static void test_evaluate_trigger_paused() {
   uint8_t ram[] = {0x00, 0x12, 0x34, 0xAB, 0x56};
   memory_t memory;
   rc_trigger_t* trigger;
-  char buffer[512];
+  char buffer[640];
 
   memory.ram = ram;
   memory.size = sizeof(ram);
@@ -1957,7 +1961,7 @@ static void test_remember_recall() {
   uint8_t ram[] = { 0x00, 0x12, 0x34, 0xAB, 0x56 };
   memory_t memory;
   rc_trigger_t* trigger;
-  char buffer[256];
+  char buffer[384];
 
   memory.ram = ram;
   memory.size = sizeof(ram);
@@ -1985,7 +1989,7 @@ static void test_remember_recall_separate_accumulator_per_group() {
   uint8_t ram[] = { 0x00, 0x12, 0x34, 0xAB, 0x56 };
   memory_t memory;
   rc_trigger_t* trigger;
-  char buffer[640];
+  char buffer[1024];
 
   memory.ram = ram;
   memory.size = sizeof(ram);
@@ -2337,6 +2341,323 @@ static void test_trailing_andnext_with_alt() {
 
 /* ======================================================== */
 
+static void test_steady_trigger() {
+  uint8_t ram[] = { 0x00, 0x12, 0x34, 0xAB, 0x56 };
+  memory_t memory;
+  rc_trigger_t* trigger;
+  rc_trigger_steady_t* steady;
+  char buffer[1024];
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  assert_parse_trigger(&trigger, buffer, "0xH0001=18_0xH0002=d0xH0002_0xH0003=1");
+  steady = rc_trigger_steady_create(trigger);
+  ASSERT_PTR_NOT_NULL(steady);
+  ASSERT_NUM_EQUALS(steady->num_inputs, 3); /* 0xH0002 and d0xH0002 share a memref */
+  trigger->state = RC_TRIGGER_STATE_ACTIVE;
+
+  /* the first read of each memref is a change */
+  ASSERT_NUM_EQUALS(evaluate_steady_trigger(trigger, steady, &memory), RC_TRIGGER_STATE_ACTIVE);
+  ASSERT_NUM_EQUALS(steady->is_steady, 0);
+  assert_hit_count(trigger, 0, 0, 1);
+  assert_hit_count(trigger, 0, 1, 0);
+
+  /* the changed flags were cleared */
+  ASSERT_NUM_EQUALS(evaluate_steady_trigger(trigger, steady, &memory), RC_TRIGGER_STATE_ACTIVE);
+  ASSERT_NUM_EQUALS(steady->is_steady, 0);
+
+  /* same inputs as the last frame. only the hit counts change */
+  ASSERT_NUM_EQUALS(evaluate_steady_trigger(trigger, steady, &memory), RC_TRIGGER_STATE_ACTIVE);
+  ASSERT_NUM_EQUALS(steady->is_steady, 1);
+  assert_hit_count(trigger, 0, 0, 3);
+  assert_hit_count(trigger, 0, 1, 2);
+  assert_hit_count(trigger, 0, 2, 0);
+
+  /* nothing changed, so the hits are tallied without evaluating */
+  ASSERT_NUM_EQUALS(evaluate_steady_trigger(trigger, steady, &memory), RC_TRIGGER_STATE_ACTIVE);
+  ASSERT_NUM_EQUALS(evaluate_steady_trigger(trigger, steady, &memory), RC_TRIGGER_STATE_ACTIVE);
+  assert_hit_count(trigger, 0, 0, 5);
+  assert_hit_count(trigger, 0, 1, 4);
+  assert_hit_count(trigger, 0, 2, 0);
+
+  /* an input changed. has to be evaluated */
+  ram[2] = 0x35;
+  ASSERT_NUM_EQUALS(evaluate_steady_trigger(trigger, steady, &memory), RC_TRIGGER_STATE_ACTIVE);
+  ASSERT_NUM_EQUALS(steady->is_steady, 0);
+  assert_hit_count(trigger, 0, 0, 6);
+  assert_hit_count(trigger, 0, 1, 4);
+
+  /* not steady until the changed flag clears */
+  ASSERT_NUM_EQUALS(evaluate_steady_trigger(trigger, steady, &memory), RC_TRIGGER_STATE_ACTIVE);
+  ASSERT_NUM_EQUALS(steady->is_steady, 0);
+  assert_hit_count(trigger, 0, 1, 5);
+  ASSERT_NUM_EQUALS(evaluate_steady_trigger(trigger, steady, &memory), RC_TRIGGER_STATE_ACTIVE);
+  ASSERT_NUM_EQUALS(steady->is_steady, 1);
+  assert_hit_count(trigger, 0, 0, 8);
+  assert_hit_count(trigger, 0, 1, 6);
+
+  /* modified outside of evaluation. has to be evaluated */
+  rc_reset_trigger(trigger);
+  trigger->state = RC_TRIGGER_STATE_ACTIVE;
+  ASSERT_NUM_EQUALS(evaluate_steady_trigger(trigger, steady, &memory), RC_TRIGGER_STATE_ACTIVE);
+  assert_hit_count(trigger, 0, 0, 1);
+  assert_hit_count(trigger, 0, 1, 1);
+
+  /* last condition true */
+  ram[3] = 1;
+  ASSERT_NUM_EQUALS(evaluate_steady_trigger(trigger, steady, &memory), RC_TRIGGER_STATE_TRIGGERED);
+
+  rc_trigger_steady_destroy(steady);
+}
+
+static void _assert_steady_trigger_supported(const char* memaddr, int expected) {
+  rc_trigger_t* trigger;
+  rc_trigger_steady_t* steady;
+  char buffer[512];
+
+  assert_parse_trigger(&trigger, buffer, memaddr);
+  steady = rc_trigger_steady_create(trigger);
+  ASSERT_PTR_NOT_NULL(steady);
+  ASSERT_NUM_EQUALS(steady->num_conditions != 0, expected);
+  rc_trigger_steady_destroy(steady);
+}
+#define assert_steady_trigger_supported(memaddr, expected) ASSERT_HELPER(_assert_steady_trigger_supported(memaddr, expected), "assert_steady_trigger_supported")
+
+static void test_steady_trigger_hit_target() {
+
+  /* hit targets make the outcome depend on how many times the trigger has been evaluated */
+  assert_steady_trigger_supported("0xH0001=18_0xH0002=52(3)", 0);
+  assert_steady_trigger_supported("0xH0001=18S0xH0002=52.3.", 0);
+
+  /* without a hit target, AddHits has no effect */
+  assert_steady_trigger_supported("C:0xH0001=18_0xH0002=52", 1);
+}
+
+static void _assert_steady_trigger_matches(const char* memaddr) {
+  uint8_t ram[] = { 0x00, 0x01, 0x02, 0x03, 0x00, 0x01, 0x02, 0x03 };
+  memory_t memory;
+  rc_trigger_t* trigger;
+  rc_trigger_t* reference;
+  rc_trigger_steady_t* steady;
+  rc_condset_t* condset;
+  rc_condset_t* reference_condset;
+  rc_condition_t* condition;
+  rc_condition_t* reference_condition;
+  char buffer[2048];
+  char reference_buffer[2048];
+  uint32_t seed = 12345;
+  int steady_frames = 0;
+  int frame;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  assert_parse_trigger(&trigger, buffer, memaddr);
+  steady = rc_trigger_steady_create(trigger);
+  ASSERT_PTR_NOT_NULL(steady);
+  ASSERT_NUM_NOT_EQUALS(steady->num_conditions, 0);
+  assert_parse_trigger(&reference, reference_buffer, memaddr);
+
+  for (frame = 0; frame < 2000; ++frame) {
+    seed = seed * 1103515245 + 12345;
+    if ((seed >> 16) % 8 == 0)
+      ram[(seed >> 20) % sizeof(ram)] = (uint8_t)((seed >> 24) % 4);
+
+    if (frame % 500 == 250) {
+      /* modify state outside of evaluation */
+      rc_reset_trigger(trigger);
+      rc_reset_trigger(reference);
+    }
+    else if (frame % 300 == 150) {
+      /* modify hits outside of evaluation (i.e. deserializing progress) */
+      condset = trigger->requirement ? trigger->requirement : trigger->alternative;
+      reference_condset = reference->requirement ? reference->requirement : reference->alternative;
+      if (condset->conditions) {
+        condset->conditions->current_hits = 0;
+        reference_condset->conditions->current_hits = 0;
+      }
+    }
+
+    if (trigger->state == RC_TRIGGER_STATE_WAITING && frame % 100 == 50) {
+      trigger->state = RC_TRIGGER_STATE_ACTIVE;
+      reference->state = RC_TRIGGER_STATE_ACTIVE;
+    }
+    else if (trigger->state == RC_TRIGGER_STATE_TRIGGERED) {
+      rc_reset_trigger(trigger);
+      rc_reset_trigger(reference);
+    }
+
+    ASSERT_NUM_EQUALS(evaluate_steady_trigger(trigger, steady, &memory), evaluate_trigger(reference, &memory));
+    ASSERT_NUM_EQUALS(trigger->state, reference->state);
+    ASSERT_NUM_EQUALS(trigger->has_hits, reference->has_hits);
+    ASSERT_NUM_EQUALS(trigger->measured_value, reference->measured_value);
+
+    condset = trigger->requirement ? trigger->requirement : trigger->alternative;
+    reference_condset = reference->requirement ? reference->requirement : reference->alternative;
+    while (condset) {
+      ASSERT_NUM_EQUALS(condset->is_paused, reference_condset->is_paused);
+
+      reference_condition = reference_condset->conditions;
+      for (condition = condset->conditions; condition; condition = condition->next) {
+        ASSERT_NUM_EQUALS(condition->current_hits, reference_condition->current_hits);
+        ASSERT_NUM_EQUALS(condition->is_true, reference_condition->is_true);
+        reference_condition = reference_condition->next;
+      }
+
+      condset = (condset == trigger->requirement) ? trigger->alternative : condset->next;
+      reference_condset = (reference_condset == reference->requirement) ? reference->alternative : reference_condset->next;
+    }
+
+    if (steady->is_steady)
+      ++steady_frames;
+  }
+
+  rc_trigger_steady_destroy(steady);
+  ASSERT_NUM_GREATER(steady_frames, 100);
+}
+#define assert_steady_trigger_matches(memaddr) ASSERT_HELPER(_assert_steady_trigger_matches(memaddr), "assert_steady_trigger_matches")
+
+static void test_steady_trigger_matches_evaluation() {
+  assert_steady_trigger_matches("0xH0000=1_0xH0001=0xH0002");
+  assert_steady_trigger_matches("0xH0000=1_d0xH0001=1_p0xH0002=2");
+  assert_steady_trigger_matches("P:0xH0003=3_0xH0000=1_0xH0001=1");
+  assert_steady_trigger_matches("R:0xH0003=3_0xH0000=1_0xH0001=1");
+  assert_steady_trigger_matches("0xH0000=1_Z:0xH0003=3_0xH0001=1");
+  assert_steady_trigger_matches("N:0xH0000=1_O:0xH0001=2_0xH0002=3_0xH0003=0");
+  assert_steady_trigger_matches("A:0xH0000_B:0xH0001_0xH0002=2");
+  assert_steady_trigger_matches("I:0xH0000_0xH0001=1_0xH0002=0");
+  assert_steady_trigger_matches("K:0xH0000*2_{recall}=2_0xH0001={recall}");
+  assert_steady_trigger_matches("M:0xH0000=1_0xH0001=1");
+  assert_steady_trigger_matches("Q:0xH0003=0_M:0xH0000=3_0xH0001!=2");
+  assert_steady_trigger_matches("T:0xH0000=1_0xH0001=1");
+  assert_steady_trigger_matches("C:0xH0000=1_0xH0001=1");
+  assert_steady_trigger_matches("0xH0000=1S0xH0001=1_P:0xH0002=2S0xH0003=3_R:0xH0004=0");
+  assert_steady_trigger_matches("S0xH0001=1SP:0xH0002=2_0xH0003=3");
+}
+
+static void force_full_reset(rc_trigger_t* trigger) {
+  rc_condset_t* condset;
+
+  if (trigger->requirement)
+    ((rc_condset_with_trailing_conditions_t*)trigger->requirement)->has_hits = 1;
+
+  for (condset = trigger->alternative; condset; condset = condset->next)
+    ((rc_condset_with_trailing_conditions_t*)condset)->has_hits = 1;
+}
+
+static void _assert_reset_matches_full_reset(const char* memaddr) {
+  uint8_t ram[] = { 0x00, 0x01, 0x02, 0x03, 0x00, 0x01, 0x02, 0x03 };
+  memory_t memory;
+  rc_trigger_t* trigger;
+  rc_trigger_t* reference;
+  rc_condset_t* condset;
+  rc_condset_t* reference_condset;
+  rc_condition_t* condition;
+  rc_condition_t* reference_condition;
+  char buffer[2048];
+  char reference_buffer[2048];
+  uint32_t seed = 12345;
+  int resets = 0;
+  int frame;
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  assert_parse_trigger(&trigger, buffer, memaddr);
+  assert_parse_trigger(&reference, reference_buffer, memaddr);
+  trigger->state = reference->state = RC_TRIGGER_STATE_ACTIVE;
+
+  for (frame = 0; frame < 2000; ++frame) {
+    seed = seed * 1103515245 + 12345;
+    if ((seed >> 16) % 4 == 0)
+      ram[(seed >> 20) % sizeof(ram)] = (uint8_t)((seed >> 24) % 4);
+
+    if (trigger->state == RC_TRIGGER_STATE_TRIGGERED) {
+      rc_reset_trigger(trigger);
+      rc_reset_trigger(reference);
+      trigger->state = reference->state = RC_TRIGGER_STATE_ACTIVE;
+    }
+
+    /* the reference clears every hit count whenever a ResetIf is true */
+    force_full_reset(reference);
+    if (evaluate_trigger(trigger, &memory) == RC_TRIGGER_STATE_RESET)
+      ++resets;
+    evaluate_trigger(reference, &memory);
+
+    ASSERT_NUM_EQUALS(trigger->state, reference->state);
+    ASSERT_NUM_EQUALS(trigger->has_hits, reference->has_hits);
+    ASSERT_NUM_EQUALS(trigger->measured_value, reference->measured_value);
+
+    condset = trigger->requirement ? trigger->requirement : trigger->alternative;
+    reference_condset = reference->requirement ? reference->requirement : reference->alternative;
+    while (condset) {
+      reference_condition = reference_condset->conditions;
+      for (condition = condset->conditions; condition; condition = condition->next) {
+        ASSERT_NUM_EQUALS(condition->current_hits, reference_condition->current_hits);
+        reference_condition = reference_condition->next;
+      }
+
+      condset = (condset == trigger->requirement) ? trigger->alternative : condset->next;
+      reference_condset = (reference_condset == reference->requirement) ? reference->alternative : reference_condset->next;
+    }
+  }
+
+  ASSERT_NUM_GREATER(resets, 0);
+}
+#define assert_reset_matches_full_reset(memaddr) ASSERT_HELPER(_assert_reset_matches_full_reset(memaddr), "assert_reset_matches_full_reset")
+
+static void test_reset_only_clears_condsets_with_hits() {
+  rc_trigger_t* trigger;
+  uint8_t ram[] = { 0x00, 0x00, 0x00, 0x00 };
+  memory_t memory;
+  char buffer[1024];
+
+  memory.ram = ram;
+  memory.size = sizeof(ram);
+
+  assert_parse_trigger(&trigger, buffer, "0xH0000=1.5._R:0xH0001=1.2.");
+  trigger->state = RC_TRIGGER_STATE_ACTIVE;
+
+  ram[0] = 1;
+  ASSERT_NUM_EQUALS(evaluate_trigger(trigger, &memory), RC_TRIGGER_STATE_ACTIVE);
+  assert_hit_count(trigger, 0, 0, 1);
+  ASSERT_NUM_EQUALS(((rc_condset_with_trailing_conditions_t*)trigger->requirement)->has_hits, 1);
+
+  /* the first hit on the ResetIf doesn't reset anything */
+  ram[0] = 0;
+  ram[1] = 1;
+  ASSERT_NUM_EQUALS(evaluate_trigger(trigger, &memory), RC_TRIGGER_STATE_ACTIVE);
+  assert_hit_count(trigger, 0, 0, 1);
+  assert_hit_count(trigger, 0, 1, 1);
+
+  /* the second one resets everything */
+  ASSERT_NUM_EQUALS(evaluate_trigger(trigger, &memory), RC_TRIGGER_STATE_RESET);
+  assert_hit_count(trigger, 0, 0, 0);
+  assert_hit_count(trigger, 0, 1, 0);
+  ASSERT_NUM_EQUALS(((rc_condset_with_trailing_conditions_t*)trigger->requirement)->has_hits, 0);
+
+  /* hits on the ResetIf itself don't mark the condset, but are still cleared */
+  ASSERT_NUM_EQUALS(evaluate_trigger(trigger, &memory), RC_TRIGGER_STATE_ACTIVE);
+  assert_hit_count(trigger, 0, 1, 1);
+  ASSERT_NUM_EQUALS(((rc_condset_with_trailing_conditions_t*)trigger->requirement)->has_hits, 0);
+  ASSERT_NUM_EQUALS(evaluate_trigger(trigger, &memory), RC_TRIGGER_STATE_RESET);
+  assert_hit_count(trigger, 0, 0, 0);
+  assert_hit_count(trigger, 0, 1, 0);
+  ASSERT_NUM_EQUALS(((rc_condset_with_trailing_conditions_t*)trigger->requirement)->has_hits, 0);
+}
+
+static void test_reset_matches_full_reset() {
+  assert_reset_matches_full_reset("0xH0000=1.3._R:0xH0001=3");
+  assert_reset_matches_full_reset("0xH0000=1.3._R:0xH0001=3.2.");
+  assert_reset_matches_full_reset("Z:0xH0003=0_P:0xH0002=2.2._0xH0000=1.3._R:0xH0001=3");
+  assert_reset_matches_full_reset("Z:0xH0002=2_0xH0000=1.3._R:0xH0001=3");
+  assert_reset_matches_full_reset("C:0xH0002=2_0xH0000=1.4._N:0xH0003=1_R:0xH0001=3");
+  assert_reset_matches_full_reset("M:0xH0000=1.9._R:0xH0001=3");
+  assert_reset_matches_full_reset("0xH0000=1.3.S0xH0002=1.2._R:0xH0001=3S0xH0003=2.2.");
+  assert_reset_matches_full_reset("R:0xH0001=3S0xH0002=1.2.S0xH0003=2.2._R:0xH0000=3");
+}
+
 void test_trigger(void) {
   TEST_SUITE_BEGIN();
 
@@ -2412,5 +2733,14 @@ void test_trigger(void) {
   TEST(test_trailing_andnext);
   TEST(test_trailing_andnext_with_alt);
 
+  /* skipping evaluation when nothing changed */
+  TEST(test_steady_trigger);
+  TEST(test_steady_trigger_hit_target);
+  TEST(test_steady_trigger_matches_evaluation);
+
+  /* resets */
+  TEST(test_reset_only_clears_condsets_with_hits);
+  TEST(test_reset_matches_full_reset);
+
   TEST_SUITE_END();
 }
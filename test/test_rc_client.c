@@ -145,6 +145,18 @@ static const char* patchdata_bounds_check_system = "{\"Success\":true,"
       "\"Leaderboards\":[]"
     "}]}";
 
+static const char* patchdata_pointer_table = "{\"Success\":true,"
+    "\"GameId\":1234,\"Title\":\"Sample Game\",\"ConsoleId\":7,"
+    "\"ImageIconUrl\":\"http://server/Images/112233.png\","
+    "\"RichPresenceGameId\":1234,\"RichPresencePatch\":\"\",\"Sets\":[{"
+      "\"AchievementSetId\":1111,\"GameId\":1234,\"Title\":null,\"Type\":\"core\","
+      "\"ImageIconUrl\":\"http://server/Images/112233.png\","
+      "\"Achievements\":["
+        GENERIC_ACHIEVEMENT_JSON("1", "I:0xH0000_0xH0004=1_I:0xH0000_0xH0005=2_I:0xH0000_0x 0006=3_I:0xH0000_0xH0010=4")
+      "],"
+      "\"Leaderboards\":[]"
+    "}]}";
+
 static const char* patchdata_bounds_check_8 = "{\"Success\":true,"
     "\"GameId\":1234,\"Title\":\"Sample Game\",\"ConsoleId\":7,"
     "\"ImageIconUrl\":\"http://server/Images/112233.png\","
@@ -565,6 +577,22 @@ static uint32_t rc_client_read_memory(uint32_t address, uint8_t* buffer, uint32_
   return num_bytes;
 }
 
+static uint32_t g_read_memory_calls = 0;
+
+static uint32_t rc_client_read_memory_counted(uint32_t address, uint8_t* buffer, uint32_t num_bytes, rc_client_t* client)
+{
+  ++g_read_memory_calls;
+  return rc_client_read_memory(address, buffer, num_bytes, client);
+}
+
+static uint32_t g_read_memory_block_calls = 0;
+
+static uint32_t rc_client_read_memory_block(uint32_t address, uint8_t* buffer, uint32_t num_bytes, rc_client_t* client)
+{
+  ++g_read_memory_block_calls;
+  return rc_client_read_memory(address, buffer, num_bytes, client);
+}
+
 static rc_clock_t g_now;
 
 static rc_clock_t rc_client_get_now_millisecs(const rc_client_t* client)
@@ -6141,6 +6169,307 @@ static void test_do_frame_bounds_check_available(void)
   rc_client_destroy(g_client);
 }
 
+static void test_do_frame_bounds_check_available_block_read(void)
+{
+  const rc_trigger_t* trigger;
+  uint8_t memory[8] = { 0,0,0,0,0,0,0,0 };
+  g_client = mock_client_game_loaded(patchdata_bounds_check_8, no_unlocks);
+  rc_client_set_read_memory_block_function(g_client, rc_client_read_memory_block);
+
+  ASSERT_PTR_NOT_NULL(g_client->game);
+  if (g_client->game) {
+    assert_achievement_state(g_client, 808, RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE);
+    trigger = ((rc_client_achievement_info_t*)rc_client_get_achievement_info(g_client, 808))->trigger;
+    ASSERT_NUM_EQUALS(trigger->state, RC_TRIGGER_STATE_WAITING);
+
+    /* the span containing the invalid addresses can't be read, so the individual reads should identify which are invalid */
+    mock_memory(memory, sizeof(memory));
+    rc_client_do_frame(g_client);
+
+    assert_achievement_state(g_client, 408, RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE);
+    assert_achievement_state(g_client, 708, RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE);
+    assert_achievement_state(g_client, 808, RC_CLIENT_ACHIEVEMENT_STATE_DISABLED); /* out of bounds*/
+    ASSERT_NUM_EQUALS(trigger->state, RC_TRIGGER_STATE_DISABLED);
+
+    assert_achievement_state(g_client, 616, RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE);
+    assert_achievement_state(g_client, 716, RC_CLIENT_ACHIEVEMENT_STATE_DISABLED); /* only one byte available */
+    assert_achievement_state(g_client, 524, RC_CLIENT_ACHIEVEMENT_STATE_DISABLED); /* 24-bit read actually fetches 32-bits */
+    assert_achievement_state(g_client, 432, RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE);
+    assert_achievement_state(g_client, 532, RC_CLIENT_ACHIEVEMENT_STATE_DISABLED); /* only three bytes available */
+
+    /* plan is rebuilt without the invalid addresses. remaining addresses can be read in a single call */
+    g_read_memory_block_calls = 0;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(g_read_memory_block_calls, 1);
+    ASSERT_NUM_EQUALS(g_client->game->read_plan.num_spans, 1);
+    assert_achievement_state(g_client, 408, RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE);
+    assert_achievement_state(g_client, 432, RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE);
+  }
+
+  rc_client_destroy(g_client);
+}
+
+static void test_do_frame_achievement_trigger_block_read(void)
+{
+  rc_client_event_t* event;
+  uint8_t memory[64];
+  memset(memory, 0, sizeof(memory));
+
+  g_client = mock_client_game_loaded(patchdata_exhaustive, no_unlocks);
+  rc_client_set_read_memory_block_function(g_client, rc_client_read_memory_block);
+
+  ASSERT_PTR_NOT_NULL(g_client->game);
+  if (g_client->game) {
+    const uint32_t num_active = g_client->game->runtime.trigger_count;
+    mock_memory(memory, sizeof(memory));
+
+    mock_api_response("r=awardachievement&u=Username&t=ApiToken&a=8&h=1&m=0123456789ABCDEF&v=da80b659c2b858e13ddd97077647b217",
+        "{\"Success\":true,\"Score\":5432,\"SoftcoreScore\":777,\"AchievementID\":8,\"AchievementsRemaining\":11}");
+
+    event_count = 0;
+    g_read_memory_block_calls = 0;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(event_count, 0);
+    ASSERT_NUM_EQUALS(g_read_memory_block_calls, g_client->game->read_plan.num_spans);
+    ASSERT_NUM_LESS(g_client->game->read_plan.num_spans, g_client->game->read_plan.num_memrefs);
+
+    memory[8] = 8;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(event_count, 1);
+
+    event = find_event(RC_CLIENT_EVENT_ACHIEVEMENT_TRIGGERED, 8);
+    ASSERT_PTR_NOT_NULL(event);
+    ASSERT_NUM_EQUALS(event->achievement->state, RC_CLIENT_ACHIEVEMENT_STATE_UNLOCKED);
+    ASSERT_NUM_EQUALS(g_client->game->runtime.trigger_count, num_active - 1);
+    ASSERT_NUM_EQUALS(g_client->game->read_plan.dirty, 1);
+
+    event_count = 0;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(event_count, 0);
+    ASSERT_NUM_EQUALS(g_client->game->read_plan.dirty, 0);
+  }
+
+  rc_client_destroy(g_client);
+}
+
+static void test_do_frame_achievement_trigger_dirty_pages(void)
+{
+  rc_client_event_t* event;
+  uint8_t memory[64];
+  uint8_t dirty_pages[1] = { 0 };
+  memset(memory, 0, sizeof(memory));
+
+  g_client = mock_client_game_loaded(patchdata_exhaustive, no_unlocks);
+
+  ASSERT_PTR_NOT_NULL(g_client->game);
+  if (g_client->game) {
+    mock_memory(memory, sizeof(memory));
+
+    mock_api_response("r=awardachievement&u=Username&t=ApiToken&a=8&h=1&m=0123456789ABCDEF&v=da80b659c2b858e13ddd97077647b217",
+        "{\"Success\":true,\"Score\":5432,\"SoftcoreScore\":777,\"AchievementID\":8,\"AchievementsRemaining\":11}");
+
+    /* first frame has to read everything */
+    event_count = 0;
+    rc_client_set_dirty_pages(g_client, dirty_pages, 4, 16);
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(event_count, 0);
+
+    /* page containing 0x0008 wasn't marked as written, so the change isn't seen */
+    memory[8] = 8;
+    rc_client_set_dirty_pages(g_client, dirty_pages, 4, 16);
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(event_count, 0);
+
+    /* frame without a bitmap sees the change */
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(event_count, 1);
+
+    event = find_event(RC_CLIENT_EVENT_ACHIEVEMENT_TRIGGERED, 8);
+    ASSERT_PTR_NOT_NULL(event);
+  }
+
+  rc_client_destroy(g_client);
+}
+
+static void test_do_frame_achievement_trigger_dirty_pages_block_read(void)
+{
+  rc_client_event_t* event;
+  uint8_t memory[64];
+  uint8_t dirty_pages[1] = { 0 };
+  memset(memory, 0, sizeof(memory));
+
+  g_client = mock_client_game_loaded(patchdata_exhaustive, no_unlocks);
+  rc_client_set_read_memory_block_function(g_client, rc_client_read_memory_block);
+
+  ASSERT_PTR_NOT_NULL(g_client->game);
+  if (g_client->game) {
+    mock_memory(memory, sizeof(memory));
+
+    mock_api_response("r=awardachievement&u=Username&t=ApiToken&a=8&h=1&m=0123456789ABCDEF&v=da80b659c2b858e13ddd97077647b217",
+        "{\"Success\":true,\"Score\":5432,\"SoftcoreScore\":777,\"AchievementID\":8,\"AchievementsRemaining\":11}");
+
+    event_count = 0;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(event_count, 0);
+
+    /* no pages written. nothing is read */
+    memory[8] = 8;
+    g_read_memory_block_calls = 0;
+    rc_client_set_dirty_pages(g_client, dirty_pages, 4, 16);
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(event_count, 0);
+    ASSERT_NUM_EQUALS(g_read_memory_block_calls, 0);
+
+    /* page containing 0x0008 was written */
+    dirty_pages[0] = 0x01;
+    rc_client_set_dirty_pages(g_client, dirty_pages, 4, 16);
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(event_count, 1);
+    ASSERT_NUM_GREATER(g_read_memory_block_calls, 0);
+
+    event = find_event(RC_CLIENT_EVENT_ACHIEVEMENT_TRIGGERED, 8);
+    ASSERT_PTR_NOT_NULL(event);
+  }
+
+  rc_client_destroy(g_client);
+}
+
+static void test_do_frame_pointer_table_block_read(void)
+{
+  uint8_t memory[64];
+  memset(memory, 0, sizeof(memory));
+
+  g_client = mock_client_game_loaded(patchdata_pointer_table, no_unlocks);
+  rc_client_set_read_memory_function(g_client, rc_client_read_memory_counted);
+  rc_client_set_read_memory_block_function(g_client, rc_client_read_memory_block);
+
+  ASSERT_PTR_NOT_NULL(g_client->game);
+  if (g_client->game) {
+    mock_memory(memory, sizeof(memory));
+
+    mock_api_response("r=awardachievement&u=Username&t=ApiToken&a=1&h=1&m=0123456789ABCDEF&v=f3a3ef72749787fee6ae6cb933b651b0",
+        "{\"Success\":true,\"Score\":5432,\"SoftcoreScore\":777,\"AchievementID\":1,\"AchievementsRemaining\":0}");
+
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(g_client->game->runtime.memrefs->schedule->num_indirect_groups, 1);
+
+    /* span extends past the end of memory. read individually */
+    memory[0x00] = 0x38;
+    g_read_memory_calls = 0;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(g_read_memory_calls, 4);
+    assert_achievement_state(g_client, 1, RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE);
+
+    /* the pointer and the span it points at are each read with a single block read */
+    memory[0x00] = 0x20;
+    memory[0x24] = 1;
+    memory[0x25] = 2;
+    memory[0x26] = 3;
+    memory[0x30] = 4;
+    g_read_memory_calls = 0;
+    g_read_memory_block_calls = 0;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(g_read_memory_calls, 0);
+    ASSERT_NUM_EQUALS(g_read_memory_block_calls, 2);
+    assert_achievement_state(g_client, 1, RC_CLIENT_ACHIEVEMENT_STATE_UNLOCKED);
+  }
+
+  rc_client_destroy(g_client);
+}
+
+static void test_do_frame_bounds_check_available_memory_region(void)
+{
+  const rc_trigger_t* trigger;
+  uint8_t memory[8] = { 0,0,0,0,0,0,0,0 };
+  g_client = mock_client_game_loaded(patchdata_bounds_check_8, no_unlocks);
+  rc_client_set_read_memory_function(g_client, rc_client_read_memory_counted);
+
+  /* 0x0004 and 0x0005 are read from the host memory. everything else goes through the callback */
+  ASSERT_NUM_EQUALS(rc_client_add_memory_region(g_client, 4, &memory[4], 2, RC_CLIENT_MEMORY_BYTE_ORDER_LINEAR), RC_OK);
+
+  ASSERT_PTR_NOT_NULL(g_client->game);
+  if (g_client->game) {
+    trigger = ((rc_client_achievement_info_t*)rc_client_get_achievement_info(g_client, 808))->trigger;
+
+    mock_memory(memory, sizeof(memory));
+    rc_client_do_frame(g_client);
+
+    assert_achievement_state(g_client, 408, RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE);
+    assert_achievement_state(g_client, 508, RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE);
+    assert_achievement_state(g_client, 708, RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE);
+    assert_achievement_state(g_client, 808, RC_CLIENT_ACHIEVEMENT_STATE_DISABLED); /* out of bounds*/
+    ASSERT_NUM_EQUALS(trigger->state, RC_TRIGGER_STATE_DISABLED);
+
+    assert_achievement_state(g_client, 416, RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE);
+    assert_achievement_state(g_client, 616, RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE);
+    assert_achievement_state(g_client, 716, RC_CLIENT_ACHIEVEMENT_STATE_DISABLED); /* only one byte available */
+    assert_achievement_state(g_client, 524, RC_CLIENT_ACHIEVEMENT_STATE_DISABLED); /* 24-bit read actually fetches 32-bits */
+    assert_achievement_state(g_client, 432, RC_CLIENT_ACHIEVEMENT_STATE_ACTIVE);
+    assert_achievement_state(g_client, 532, RC_CLIENT_ACHIEVEMENT_STATE_DISABLED); /* only three bytes available */
+
+    /* 0xH0004, 0xH0005 and 0x 0004 are in the region. 0xH0006, 0xH0007, 0x 0005, 0x 0006 and 0xX0004 are not */
+    g_read_memory_calls = 0;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(g_read_memory_calls, 5);
+
+    trigger = ((rc_client_achievement_info_t*)rc_client_get_achievement_info(g_client, 508))->trigger;
+    memory[5] = 3;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(trigger->requirement->conditions->operand1.value.memref->value.value, 3);
+    ASSERT_NUM_EQUALS(g_read_memory_calls, 10);
+  }
+
+  rc_client_destroy(g_client);
+}
+
+static void test_do_frame_achievement_trigger_memory_region_swap32(void)
+{
+  rc_client_event_t* event;
+  uint8_t memory[64];
+  uint8_t swapped[64];
+  memset(memory, 0, sizeof(memory));
+  memset(swapped, 0, sizeof(swapped));
+
+  g_client = mock_client_game_loaded(patchdata_exhaustive, no_unlocks);
+  rc_client_set_read_memory_function(g_client, rc_client_read_memory_counted);
+  ASSERT_NUM_EQUALS(rc_client_add_memory_region(g_client, 0, swapped, sizeof(swapped), RC_CLIENT_MEMORY_BYTE_ORDER_SWAP32), RC_OK);
+
+  ASSERT_PTR_NOT_NULL(g_client->game);
+  if (g_client->game) {
+    mock_memory(memory, sizeof(memory));
+
+    mock_api_response("r=awardachievement&u=Username&t=ApiToken&a=8&h=1&m=0123456789ABCDEF&v=da80b659c2b858e13ddd97077647b217",
+        "{\"Success\":true,\"Score\":5432,\"SoftcoreScore\":777,\"AchievementID\":8,\"AchievementsRemaining\":11}");
+
+    event_count = 0;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(event_count, 0);
+
+    /* the callback memory is ignored for addresses in the region */
+    memory[8] = 8;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(event_count, 0);
+
+    /* console address 8 is stored at host offset 11 */
+    swapped[11] = 8;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(event_count, 1);
+
+    event = find_event(RC_CLIENT_EVENT_ACHIEVEMENT_TRIGGERED, 8);
+    ASSERT_PTR_NOT_NULL(event);
+    ASSERT_NUM_EQUALS(event->achievement->state, RC_CLIENT_ACHIEVEMENT_STATE_UNLOCKED);
+
+    /* once the region is removed, the callback is used again */
+    rc_client_clear_memory_regions(g_client);
+    ASSERT_NUM_EQUALS(g_client->game->read_plan.dirty, 1);
+    g_read_memory_calls = 0;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_GREATER(g_read_memory_calls, 0);
+  }
+
+  rc_client_destroy(g_client);
+}
+
 static void test_do_frame_achievement_trigger(void)
 {
   rc_client_event_t* event;
@@ -6185,6 +6514,98 @@ static void test_do_frame_achievement_trigger(void)
   rc_client_destroy(g_client);
 }
 
+static void test_do_frame_achievement_trigger_steady(void)
+{
+  rc_client_event_t* event;
+  rc_client_achievement_info_t* achievement;
+  uint8_t memory[64];
+  memset(memory, 0, sizeof(memory));
+
+  g_client = mock_client_game_loaded(patchdata_2ach_0lbd, no_unlocks);
+
+  ASSERT_PTR_NOT_NULL(g_client->game);
+  if (g_client->game) {
+    achievement = (rc_client_achievement_info_t*)rc_client_get_achievement_info(g_client, 5501);
+    mock_memory(memory, sizeof(memory));
+
+    mock_api_response("r=awardachievement&u=Username&t=ApiToken&a=5501&h=1&m=0123456789ABCDEF&v=9b9bdf5501eb6289a6655affbcc695e6",
+        "{\"Success\":true,\"Score\":5432,\"SoftcoreScore\":777,\"AchievementID\":5501,\"AchievementsRemaining\":1}");
+
+    event_count = 0;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(event_count, 0);
+    ASSERT_PTR_NOT_NULL(achievement->steady);
+
+    /* first condition is true. once the memrefs settle, an evaluation that only tallies a hit is captured */
+    memory[1] = 3;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(achievement->steady->is_steady, 0);
+    rc_client_do_frame(g_client);
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(achievement->trigger->requirement->conditions->current_hits, 3);
+    ASSERT_NUM_EQUALS(achievement->steady->is_steady, 1);
+
+    /* the unchanged frames are skipped, but still tally the hits */
+    rc_client_do_frame(g_client);
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(event_count, 0);
+    ASSERT_NUM_EQUALS(achievement->trigger->requirement->conditions->current_hits, 5);
+    ASSERT_NUM_EQUALS(achievement->steady->is_steady, 1);
+
+    /* changed memory is evaluated */
+    memory[2] = 7;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(event_count, 1);
+
+    event = find_event(RC_CLIENT_EVENT_ACHIEVEMENT_TRIGGERED, 5501);
+    ASSERT_PTR_NOT_NULL(event);
+    ASSERT_NUM_EQUALS(event->achievement->state, RC_CLIENT_ACHIEVEMENT_STATE_UNLOCKED);
+    ASSERT_PTR_EQUALS(event->achievement, &achievement->public_);
+
+    /* the tracking is released when the achievement is no longer active */
+    ASSERT_PTR_NULL(achievement->steady);
+  }
+
+  rc_client_destroy(g_client);
+}
+
+static void test_do_frame_achievement_trigger_parks_memrefs(void)
+{
+  uint8_t memory[64];
+  memset(memory, 0, sizeof(memory));
+
+  g_client = mock_client_game_loaded(patchdata_exhaustive, no_unlocks);
+
+  ASSERT_PTR_NOT_NULL(g_client->game);
+  if (g_client->game) {
+    rc_memrefs_t* memrefs = g_client->game->runtime.memrefs;
+    uint32_t num_scheduled, i;
+    mock_memory(memory, sizeof(memory));
+
+    mock_api_response("r=awardachievement&u=Username&t=ApiToken&a=8&h=1&m=0123456789ABCDEF&v=da80b659c2b858e13ddd97077647b217",
+        "{\"Success\":true,\"Score\":5432,\"SoftcoreScore\":777,\"AchievementID\":8,\"AchievementsRemaining\":11}");
+
+    rc_client_do_frame(g_client);
+    num_scheduled = memrefs->schedule->num_memrefs;
+    ASSERT_NUM_EQUALS(num_scheduled, rc_memrefs_count_memrefs(memrefs));
+
+    memory[8] = 8;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(rc_client_get_achievement_info(g_client, 8)->state, RC_CLIENT_ACHIEVEMENT_STATE_UNLOCKED);
+
+    /* 0xH0008 is only used by the unlocked achievement, and should no longer be read */
+    memory[8] = 9;
+    rc_client_do_frame(g_client);
+    ASSERT_NUM_EQUALS(memrefs->schedule->num_memrefs, num_scheduled - 1);
+    for (i = 0; i < memrefs->memrefs.count; ++i) {
+      if (memrefs->memrefs.items[i].address == 0x0008)
+        ASSERT_NUM_EQUALS(memrefs->memrefs.items[i].value.value, 8);
+    }
+  }
+
+  rc_client_destroy(g_client);
+}
+
 static void test_do_frame_achievement_trigger_already_awarded(void)
 {
   rc_client_event_t* event;
@@ -10088,7 +10509,16 @@ void test_client(void) {
   /* do frame */
   TEST(test_do_frame_bounds_check_system);
   TEST(test_do_frame_bounds_check_available);
+  TEST(test_do_frame_bounds_check_available_block_read);
   TEST(test_do_frame_achievement_trigger);
+  TEST(test_do_frame_achievement_trigger_steady);
+  TEST(test_do_frame_achievement_trigger_block_read);
+  TEST(test_do_frame_bounds_check_available_memory_region);
+  TEST(test_do_frame_achievement_trigger_memory_region_swap32);
+  TEST(test_do_frame_achievement_trigger_parks_memrefs);
+  TEST(test_do_frame_achievement_trigger_dirty_pages);
+  TEST(test_do_frame_achievement_trigger_dirty_pages_block_read);
+  TEST(test_do_frame_pointer_table_block_read);
   TEST(test_do_frame_achievement_trigger_already_awarded);
   TEST(test_do_frame_achievement_trigger_server_error);
   TEST(test_do_frame_achievement_trigger_while_spectating);